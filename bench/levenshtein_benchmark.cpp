@@ -1,7 +1,24 @@
 #include <levenshtein_myers.hpp>
+#include <levenshtein_arena.hpp>
+#include <levenshtein_bio.hpp>
+#include <levenshtein_column.hpp>
+#include <levenshtein_dictionary.hpp>
+#include <levenshtein_distance.hpp>
+#include <levenshtein_join.hpp>
+#include <levenshtein_matrix.hpp>
+#include <levenshtein_minhash.hpp>
+#include <levenshtein_patterns.hpp>
+#include <levenshtein_qgram.hpp>
+#include <levenshtein_ratio.hpp>
+#include <levenshtein_symspell.hpp>
+#include <levenshtein_trim.hpp>
+#include <levenshtein_tune.hpp>
 #include <benchmark/benchmark.h>
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstring>
+#include <filesystem>
 #include <random>
 
 // ---------------------------------------------------------------------------
@@ -146,6 +163,34 @@ static void BM_Myers16x8_Random(benchmark::State &state) {
 }
 BENCHMARK(BM_Myers16x8_Random);
 
+// Same words, stored in an arena with the inputs built once up front
+static void BM_Myers16x8_Arena(benchmark::State &state) {
+  auto rng = make_rng();
+  constexpr int N = 100;
+  std::vector<std::string> queries(N);
+  MyersArena arena;
+  levenshtein_arena_init(arena, 16);
+  for (int i = 0; i < N; ++i) {
+    queries[i] = random_string(rng, 1, 16);
+    for (int k = 0; k < 8; ++k) {
+      std::string w = random_string(rng, 1, 16);
+      levenshtein_arena_add(arena, w.data(), w.size());
+    }
+  }
+  std::vector<Myers16x8Input> inputs;
+  levenshtein_arena_inputs(arena, inputs, nullptr);
+  int idx = 0;
+  for (auto _ : state) {
+    Myers16x8Input &input = inputs[idx];
+    input.q_wrd = queries[idx].c_str();
+    input.q_wrd_len = queries[idx].length();
+    auto result = levenshtein_myers_16x8(input);
+    benchmark::DoNotOptimize(result);
+    idx = (idx + 1) % N;
+  }
+}
+BENCHMARK(BM_Myers16x8_Arena);
+
 static void BM_Myers16x8_MaxLength(benchmark::State &state) {
   std::string query(16, 'a');
   std::array<std::string, 8> d_words;
@@ -417,6 +462,11 @@ BENCHMARK(BM_Myers64x2_RealWorld);
 BENCH_SCALAR(Myers32x1,  levenshtein_myers_32x1,  32)
 BENCH_SCALAR(Myers64x1,  levenshtein_myers_64x1,  64)
 BENCH_SCALAR(Myers128x1, levenshtein_myers_128x1, 128)
+BENCH_SCALAR(Osa32x1,    osa_myers_32x1,          32)
+BENCH_SCALAR(Osa64x1,    osa_myers_64x1,          64)
+BENCH_SCALAR(OsaAnyx1,   osa_myers_anyx1,         256)
+BENCH_SCALAR(Indel64x1,  indel_lcs_64x1,          64)
+BENCH_SCALAR(IndelAnyx1, indel_lcs_anyx1,         256)
 
 // anyx1 — benchmark across several representative lengths
 static void BM_MyersAnyx1_Random(benchmark::State &state) {
@@ -515,6 +565,81 @@ static void BM_Myers16x8_FixedLen(benchmark::State &state) {
 }
 BENCHMARK(BM_Myers16x8_FixedLen)->Arg(8)->Arg(16);
 
+static void BM_Myers16x8Prefix_FixedLen(benchmark::State &state) {
+  int len = state.range(0);
+  auto rng = make_rng();
+  constexpr int N = 100;
+  std::vector<std::string> queries(N);
+  std::vector<std::array<std::string, 8>> db(N);
+  for (int i = 0; i < N; ++i) {
+    queries[i] = random_string_exact(rng, len);
+    for (int k = 0; k < 8; ++k) db[i][k] = random_string_exact(rng, len);
+  }
+  int idx = 0;
+  for (auto _ : state) {
+    Myers16x8Input input;
+    input.q_wrd = queries[idx].c_str();
+    input.q_wrd_len = len;
+    for (int i = 0; i < 8; ++i) {
+      input.d_wrds[i] = db[idx][i].c_str();
+      input.d_wrd_lens[i] = len;
+    }
+    benchmark::DoNotOptimize(levenshtein_myers_16x8_prefix(input, 2));
+    idx = (idx + 1) % N;
+  }
+}
+BENCHMARK(BM_Myers16x8Prefix_FixedLen)->Arg(8)->Arg(16);
+
+static void BM_Osa16x8_FixedLen(benchmark::State &state) {
+  int len = state.range(0);
+  auto rng = make_rng();
+  constexpr int N = 100;
+  std::vector<std::string> queries(N);
+  std::vector<std::array<std::string, 8>> db(N);
+  for (int i = 0; i < N; ++i) {
+    queries[i] = random_string_exact(rng, len);
+    for (int k = 0; k < 8; ++k) db[i][k] = random_string_exact(rng, len);
+  }
+  int idx = 0;
+  for (auto _ : state) {
+    Myers16x8Input input;
+    input.q_wrd = queries[idx].c_str();
+    input.q_wrd_len = len;
+    for (int i = 0; i < 8; ++i) {
+      input.d_wrds[i] = db[idx][i].c_str();
+      input.d_wrd_lens[i] = len;
+    }
+    benchmark::DoNotOptimize(osa_myers_16x8(input));
+    idx = (idx + 1) % N;
+  }
+}
+BENCHMARK(BM_Osa16x8_FixedLen)->Arg(8)->Arg(16);
+
+static void BM_Indel16x8_FixedLen(benchmark::State &state) {
+  int len = state.range(0);
+  auto rng = make_rng();
+  constexpr int N = 100;
+  std::vector<std::string> queries(N);
+  std::vector<std::array<std::string, 8>> db(N);
+  for (int i = 0; i < N; ++i) {
+    queries[i] = random_string_exact(rng, len);
+    for (int k = 0; k < 8; ++k) db[i][k] = random_string_exact(rng, len);
+  }
+  int idx = 0;
+  for (auto _ : state) {
+    Myers16x8Input input;
+    input.q_wrd = queries[idx].c_str();
+    input.q_wrd_len = len;
+    for (int i = 0; i < 8; ++i) {
+      input.d_wrds[i] = db[idx][i].c_str();
+      input.d_wrd_lens[i] = len;
+    }
+    benchmark::DoNotOptimize(indel_lcs_16x8(input));
+    idx = (idx + 1) % N;
+  }
+}
+BENCHMARK(BM_Indel16x8_FixedLen)->Arg(8)->Arg(16);
+
 static void BM_Myers32x4_FixedLen(benchmark::State &state) {
   int len = state.range(0);
   auto rng = make_rng();
@@ -565,4 +690,817 @@ static void BM_Myers64x2_FixedLen(benchmark::State &state) {
 }
 BENCHMARK(BM_Myers64x2_FixedLen)->Arg(8)->Arg(16)->Arg(32)->Arg(64);
 
+// ---------------------------------------------------------------------------
+// Semi-global search — throughput over a 1 MiB random text
+// ---------------------------------------------------------------------------
+
+static std::string search_text() {
+  auto rng = make_rng();
+  return random_string_exact(rng, 1 << 20);
+}
+
+static void BM_MyersSearch64x1(benchmark::State &state) {
+  std::string text = search_text();
+  std::string pattern = text.substr(1000, state.range(0));
+  MyersSearch64x1State search;
+  std::vector<MyersSearchHit> hits;
+  for (auto _ : state) {
+    levenshtein_myers_search_64x1_init(search, pattern.c_str(),
+                                       pattern.length(), 2);
+    hits.clear();
+    levenshtein_myers_search_64x1(search, text.c_str(), text.length(), hits);
+    benchmark::DoNotOptimize(hits.data());
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * text.length());
+}
+BENCHMARK(BM_MyersSearch64x1)->Arg(16)->Arg(64);
+
+static void BM_MyersSearch16x8(benchmark::State &state) {
+  std::string text = search_text();
+  std::array<std::string, 8> patterns;
+  Myers16x8SearchInput input;
+  for (int k = 0; k < 8; ++k) {
+    patterns[k] = text.substr(1000 * (k + 1), 16);
+    input.q_wrds[k] = patterns[k].c_str();
+    input.q_wrd_lens[k] = 16;
+    input.max_dists[k] = 2;
+  }
+  MyersSearch16x8State search;
+  std::vector<MyersSearchHit> hits;
+  for (auto _ : state) {
+    levenshtein_myers_search_16x8_init(search, input);
+    hits.clear();
+    levenshtein_myers_search_16x8(search, text.c_str(), text.length(), hits);
+    benchmark::DoNotOptimize(hits.data());
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * text.length());
+}
+BENCHMARK(BM_MyersSearch16x8);
+
+static void BM_MyersSearch64x2(benchmark::State &state) {
+  std::string text = search_text();
+  std::array<std::string, 2> patterns = {text.substr(1000, 64),
+                                         text.substr(2000, 64)};
+  Myers64x2SearchInput input;
+  for (int k = 0; k < 2; ++k) {
+    input.q_wrds[k] = patterns[k].c_str();
+    input.q_wrd_lens[k] = 64;
+    input.max_dists[k] = 4;
+  }
+  MyersSearch64x2State search;
+  std::vector<MyersSearchHit> hits;
+  for (auto _ : state) {
+    levenshtein_myers_search_64x2_init(search, input);
+    hits.clear();
+    levenshtein_myers_search_64x2(search, text.c_str(), text.length(), hits);
+    benchmark::DoNotOptimize(hits.data());
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * text.length());
+}
+BENCHMARK(BM_MyersSearch64x2);
+
+// ---------------------------------------------------------------------------
+// Dictionary scan — one query against a 100k-word mmap'd dictionary
+// ---------------------------------------------------------------------------
+
+static std::vector<std::string> bench_words(int n, int max_len) {
+  auto rng = make_rng();
+  std::vector<std::string> words(n);
+  for (auto &w : words)
+    w = random_string(rng, 1, max_len);
+  return words;
+}
+
+static void BM_DictionaryScan(benchmark::State &state) {
+  auto words = bench_words(100000, 16);
+  auto path = std::filesystem::temp_directory_path() / "levenshtein_bench.dict";
+  levenshtein_dictionary_build(words, path.c_str(), nullptr);
+  MyersDictionary dict;
+  levenshtein_dictionary_open(dict, path.c_str(), nullptr);
+
+  std::mt19937 rng(7);
+  std::string query = random_string_exact(rng, state.range(0));
+  std::vector<uint32_t> distances(words.size());
+  for (auto _ : state) {
+    levenshtein_dictionary_scan(dict, query.c_str(), query.length(),
+                                distances.data());
+    benchmark::DoNotOptimize(distances.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * words.size());
+  levenshtein_dictionary_close(dict);
+  std::filesystem::remove(path);
+}
+BENCHMARK(BM_DictionaryScan)->Arg(8)->Arg(16);
+
+// Baseline: the same scan through the pointer-based 16x8 kernel
+static void BM_DictionaryScanPointers(benchmark::State &state) {
+  auto words = bench_words(100000, 16);
+  std::mt19937 rng(7);
+  std::string query = random_string_exact(rng, 16);
+  std::vector<uint32_t> distances(words.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i + 8 <= words.size(); i += 8) {
+      Myers16x8Input input;
+      input.q_wrd = query.c_str();
+      input.q_wrd_len = query.length();
+      for (int k = 0; k < 8; ++k) {
+        input.d_wrds[k] = words[i + k].c_str();
+        input.d_wrd_lens[k] = words[i + k].length();
+      }
+      auto r = levenshtein_myers_16x8(input);
+      std::copy(r.begin(), r.end(), distances.begin() + i);
+    }
+    benchmark::DoNotOptimize(distances.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * words.size());
+}
+BENCHMARK(BM_DictionaryScanPointers);
+
+// Thresholded scan with the prefilter cascade; counters report how many
+// candidates each stage rejects per query
+static void BM_DictionaryScanWithin(benchmark::State &state) {
+  auto words = bench_words(100000, 16);
+  auto path = std::filesystem::temp_directory_path() / "levenshtein_bench.dict";
+  levenshtein_dictionary_build(words, path.c_str(), nullptr);
+  MyersDictionary dict;
+  levenshtein_dictionary_open(dict, path.c_str(), nullptr);
+
+  std::string query = words[123];
+  std::vector<MyersScanMatch> matches;
+  MyersScanStats stats = {};
+  for (auto _ : state) {
+    matches.clear();
+    levenshtein_dictionary_scan_within(dict, query.c_str(), query.length(),
+                                       state.range(0), matches, &stats);
+    benchmark::DoNotOptimize(matches.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * words.size());
+  double n = state.iterations();
+  state.counters["rej_length"] = stats.rejected_length / n;
+  state.counters["rej_hist"] = stats.rejected_histogram / n;
+  state.counters["verified"] = stats.verified / n;
+  levenshtein_dictionary_close(dict);
+  std::filesystem::remove(path);
+}
+BENCHMARK(BM_DictionaryScanWithin)->Arg(1)->Arg(2)->Arg(4);
+
+// Ids within k = 3 of a 12-character query: full scan then a scalar filter
+// over the distances (0), compacted ids (1), count only (2); and a
+// 16-bin distance histogram (3)
+static void BM_DictionaryScanModes(benchmark::State &state) {
+  auto words = bench_words(100000, 16);
+  auto path = std::filesystem::temp_directory_path() / "levenshtein_bench.dict";
+  levenshtein_dictionary_build(words, path.c_str(), nullptr);
+  MyersDictionary dict;
+  levenshtein_dictionary_open(dict, path.c_str(), nullptr);
+
+  std::mt19937 rng(7);
+  std::string query = random_string_exact(rng, 12);
+  std::vector<uint32_t> distances(words.size()), ids(words.size());
+  std::array<uint64_t, 16> hist;
+  size_t n = 0;
+  for (auto _ : state) {
+    switch (state.range(0)) {
+    case 0:
+      levenshtein_dictionary_scan(dict, query.c_str(), query.length(),
+                                  distances.data());
+      n = 0;
+      for (uint32_t i = 0; i < distances.size(); i++) {
+        if (distances[i] <= 3)
+          ids[n++] = i;
+      }
+      break;
+    case 1:
+      n = levenshtein_dictionary_scan_ids(dict, query.c_str(), query.length(),
+                                          3, ids.data());
+      break;
+    case 2:
+      n = levenshtein_dictionary_count_within(dict, query.c_str(),
+                                              query.length(), 3);
+      break;
+    default:
+      hist.fill(0);
+      levenshtein_dictionary_scan_histogram(dict, query.c_str(),
+                                            query.length(), hist.data(), 16);
+      n = hist[0];
+      break;
+    }
+    benchmark::DoNotOptimize(ids.data());
+    benchmark::DoNotOptimize(n);
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * words.size());
+  levenshtein_dictionary_close(dict);
+  std::filesystem::remove(path);
+}
+BENCHMARK(BM_DictionaryScanModes)->DenseRange(0, 3);
+
+// Condensed N x N matrix; arg is the thread count (0 = all cores)
+static void BM_MatrixCondensed(benchmark::State &state) {
+  auto words = bench_words(4000, 16);
+  size_t n = words.size();
+  std::vector<uint8_t> out(n * (n - 1) / 2);
+  for (auto _ : state) {
+    levenshtein_matrix_condensed(words, out.data(), state.range(0));
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.counters["cells/s"] = benchmark::Counter(
+      double(out.size()) * state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_MatrixCondensed)->Arg(1)->Arg(0)->UseRealTime();
+
+// The same cells through a plain loop over levenshtein_myers_16x8
+static void BM_MatrixNaive16x8(benchmark::State &state) {
+  auto words = bench_words(4000, 16);
+  size_t n = words.size();
+  std::vector<uint8_t> out(n * (n - 1) / 2);
+  for (auto _ : state) {
+    for (size_t i = 0; i < n; i++) {
+      for (size_t j = i + 1; j < n; j += 8) {
+        Myers16x8Input input{words[i].c_str(), (int)words[i].size()};
+        for (size_t k = 0; k < 8; k++) {
+          const std::string &w = words[std::min(j + k, n - 1)];
+          input.d_wrds[k] = w.c_str();
+          input.d_wrd_lens[k] = w.size();
+        }
+        auto r = levenshtein_myers_16x8(input);
+        for (size_t k = 0; k < 8 && j + k < n; k++)
+          out[levenshtein_condensed_index(n, i, j + k)] = r[k];
+      }
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.counters["cells/s"] = benchmark::Counter(
+      double(out.size()) * state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_MatrixNaive16x8)->UseRealTime();
+
+// PassJoin between two sets of 20k strings; arg is max_dist
+static void BM_Join(benchmark::State &state) {
+  auto left = bench_words(20000, 16);
+  auto right = bench_words(20000, 16);
+  // Near-duplicates of the left side so that there is something to find
+  for (int i = 0; i < 2000; i++)
+    right[i] = left[i] + "x";
+  MyersJoinStats stats = {};
+  for (auto _ : state) {
+    levenshtein_join(
+        left, right, state.range(0),
+        [](const MyersJoinPair *pairs, size_t n) {
+          benchmark::DoNotOptimize(pairs);
+        },
+        0, &stats);
+  }
+  double n = state.iterations();
+  state.counters["candidates"] = stats.candidates / n;
+  state.counters["pairs"] = stats.pairs / n;
+}
+BENCHMARK(BM_Join)->Arg(1)->Arg(2)->Arg(3)->UseRealTime();
+
+// q-gram index over 100k strings of 10-64 characters; arg is q
+static std::vector<std::string> qgram_bench_words() {
+  auto rng = make_rng();
+  std::vector<std::string> words(100000);
+  for (auto &w : words)
+    w = random_string(rng, 10, 64);
+  return words;
+}
+
+static void BM_QgramBuild(benchmark::State &state) {
+  auto words = qgram_bench_words();
+  MyersQgramIndex index;
+  for (auto _ : state)
+    levenshtein_qgram_build(words, state.range(0), index, nullptr);
+  state.counters["bytes"] = levenshtein_qgram_memory(index);
+  state.SetItemsProcessed(int64_t(state.iterations()) * words.size());
+}
+BENCHMARK(BM_QgramBuild)->Arg(2)->Arg(3)->Unit(benchmark::kMillisecond);
+
+// Args: q, max_dist
+static void BM_QgramSearch(benchmark::State &state) {
+  auto words = qgram_bench_words();
+  MyersQgramIndex index;
+  levenshtein_qgram_build(words, state.range(0), index, nullptr);
+
+  std::vector<MyersScanMatch> matches;
+  MyersQgramStats stats = {};
+  int qi = 0;
+  for (auto _ : state) {
+    const std::string &q = words[(qi++ * 7919) % words.size()];
+    matches.clear();
+    levenshtein_qgram_search(index, q.c_str(), q.size(), state.range(1),
+                             matches, &stats);
+    benchmark::DoNotOptimize(matches.data());
+  }
+  double n = state.iterations();
+  state.counters["postings"] = stats.postings / n;
+  state.counters["verified"] = stats.verified / n;
+}
+BENCHMARK(BM_QgramSearch)
+    ->Args({2, 2})
+    ->Args({3, 2})
+    ->Args({3, 4})
+    ->Unit(benchmark::kMicrosecond);
+
+// The same queries as a linear scan over the 32x4 / 64x2 kernels
+static void BM_QgramLinearScan(benchmark::State &state) {
+  auto words = qgram_bench_words();
+  int qi = 0;
+  for (auto _ : state) {
+    const std::string &q = words[(qi++ * 7919) % words.size()];
+    size_t hits = 0;
+    for (size_t i = 0; i + 2 <= words.size(); i += 2) {
+      Myers64x2Input input{q.c_str(), (int)q.size()};
+      for (int k = 0; k < 2; k++) {
+        input.d_wrds[k] = words[i + k].c_str();
+        input.d_wrd_lens[k] = words[i + k].size();
+      }
+      auto r = levenshtein_myers_64x2(input);
+      hits += (r[0] <= 2) + (r[1] <= 2);
+    }
+    benchmark::DoNotOptimize(hits);
+  }
+}
+BENCHMARK(BM_QgramLinearScan)->Unit(benchmark::kMicrosecond);
+
+// SymSpell lookups of misspelled words against 100k words of up to 16
+// characters; arg is max_dist. Reports latency percentiles per lookup.
+static void BM_SymSpellLookup(benchmark::State &state) {
+  auto words = bench_words(100000, 16);
+  uint32_t k = state.range(0);
+  MyersSymSpellIndex index;
+  levenshtein_symspell_build(words, k, index, nullptr);
+
+  std::mt19937 rng(7);
+  std::vector<std::string> queries(4096);
+  for (auto &q : queries) {
+    q = words[rng() % words.size()];
+    if (!q.empty())
+      q[rng() % q.size()] = 'a' + rng() % 26;
+  }
+
+  std::vector<double> latencies;
+  std::vector<MyersScanMatch> matches;
+  size_t qi = 0;
+  for (auto _ : state) {
+    const std::string &q = queries[qi++ % queries.size()];
+    matches.clear();
+    auto start = std::chrono::steady_clock::now();
+    levenshtein_symspell_lookup(index, q.c_str(), q.size(), k, matches,
+                                nullptr);
+    auto end = std::chrono::steady_clock::now();
+    latencies.push_back(std::chrono::duration<double, std::micro>(end - start)
+                            .count());
+    benchmark::DoNotOptimize(matches.data());
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&](double p) {
+    return latencies[std::min(latencies.size() - 1,
+                              size_t(p * latencies.size()))];
+  };
+  state.counters["p50_us"] = percentile(0.50);
+  state.counters["p99_us"] = percentile(0.99);
+  state.counters["p999_us"] = percentile(0.999);
+  state.counters["bytes"] = levenshtein_symspell_memory(index);
+}
+BENCHMARK(BM_SymSpellLookup)->Arg(1)->Arg(2)->Unit(benchmark::kMicrosecond);
+
+// Near-duplicate search over 5000 texts of 200-2000 characters, a fifth of
+// them edited copies of others. Queries are edited copies as well; recall is
+// measured against the exhaustive scan below.
+struct MinHashBenchData {
+  std::vector<std::string> strs;
+  std::vector<std::string> queries;
+  std::vector<size_t> truth; // Matches of each query within max_dist
+};
+
+static const uint32_t MINHASH_BENCH_K = 32;
+
+static std::string edit_text(std::mt19937 &rng, std::string s, int edits) {
+  for (int e = 0; e < edits; e++) {
+    size_t pos = rng() % s.size();
+    switch (rng() % 3) {
+    case 0: s[pos] = 'a' + rng() % 26; break;
+    case 1: s.insert(s.begin() + pos, 'a' + rng() % 26); break;
+    default: s.erase(s.begin() + pos); break;
+    }
+  }
+  return s;
+}
+
+static const MinHashBenchData &minhash_bench_data() {
+  static MinHashBenchData data = [] {
+    MinHashBenchData data;
+    auto rng = make_rng();
+    for (int i = 0; i < 4000; i++) {
+      std::string s = random_string(rng, 200, 2000);
+      // Word breaks, so the shingles look more like text
+      for (size_t j = rng() % 8; j < s.size(); j += 3 + rng() % 8)
+        s[j] = ' ';
+      data.strs.push_back(s);
+    }
+    for (int i = 0; i < 1000; i++)
+      data.strs.push_back(edit_text(rng, data.strs[rng() % 4000], rng() % 24));
+    for (int i = 0; i < 64; i++)
+      data.queries.push_back(
+          edit_text(rng, data.strs[rng() % data.strs.size()], rng() % 16));
+
+    for (const auto &q : data.queries) {
+      size_t hits = 0;
+      for (const auto &d : data.strs)
+        hits += levenshtein_myers_anyx1_bounded(q.c_str(), q.size(), d.c_str(),
+                                                d.size(), MINHASH_BENCH_K) <=
+                MINHASH_BENCH_K;
+      data.truth.push_back(hits);
+    }
+    return data;
+  }();
+  return data;
+}
+
+// Args: bands, rows (5-character shingles)
+static void BM_MinHashSearch(benchmark::State &state) {
+  const auto &data = minhash_bench_data();
+  MyersMinHashIndex index;
+  levenshtein_minhash_build(data.strs, {5, (int)state.range(0),
+                                        (int)state.range(1), 42},
+                            index, nullptr);
+
+  std::vector<MyersScanMatch> matches;
+  MyersMinHashStats stats = {};
+  size_t found = 0, expected = 0;
+  size_t qi = 0;
+  for (auto _ : state) {
+    size_t i = qi++ % data.queries.size();
+    const std::string &q = data.queries[i];
+    matches.clear();
+    levenshtein_minhash_search(index, q.c_str(), q.size(), MINHASH_BENCH_K,
+                               matches, &stats);
+    found += matches.size();
+    expected += data.truth[i];
+  }
+  double n = state.iterations();
+  state.counters["recall"] = double(found) / expected;
+  state.counters["candidates"] = stats.candidates / n;
+  state.counters["bytes"] = levenshtein_minhash_memory(index);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MinHashSearch)
+    ->Args({8, 4})
+    ->Args({16, 4})
+    ->Args({32, 4})
+    ->Args({32, 8})
+    ->Unit(benchmark::kMicrosecond);
+
+// The same queries against every text with the bounded kernel
+static void BM_MinHashExhaustive(benchmark::State &state) {
+  const auto &data = minhash_bench_data();
+  size_t qi = 0;
+  for (auto _ : state) {
+    const std::string &q = data.queries[qi++ % data.queries.size()];
+    size_t hits = 0;
+    for (const auto &d : data.strs)
+      hits += levenshtein_myers_anyx1_bounded(q.c_str(), q.size(), d.c_str(),
+                                              d.size(), MINHASH_BENCH_K) <=
+              MINHASH_BENCH_K;
+    benchmark::DoNotOptimize(hits);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MinHashExhaustive)->Unit(benchmark::kMicrosecond);
+
+// A fixed watch list of 2048 names of 4-16 characters against a stream of
+// texts; items are pattern comparisons
+static void BM_PatternsScan(benchmark::State &state) {
+  auto rng = make_rng();
+  std::vector<std::string> patterns(2048), texts(256);
+  for (auto &p : patterns)
+    p = random_string(rng, 4, 16);
+  for (auto &t : texts)
+    t = random_string(rng, 4, 16);
+
+  MyersPatternSet set;
+  levenshtein_patterns_build(patterns, set, nullptr);
+  std::vector<uint32_t> distances(patterns.size());
+  size_t ti = 0;
+  for (auto _ : state) {
+    const std::string &t = texts[ti++ % texts.size()];
+    levenshtein_patterns_scan(set, t.c_str(), t.size(), distances.data());
+    benchmark::DoNotOptimize(distances.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * patterns.size());
+}
+BENCHMARK(BM_PatternsScan);
+
+// Baseline: each text as the 16x8 query, the names streamed through the
+// lanes from padded 16-byte slots
+static void BM_PatternsQuerySide16x8(benchmark::State &state) {
+  auto rng = make_rng();
+  std::vector<std::string> patterns(2048), texts(256);
+  for (auto &p : patterns)
+    p = random_string(rng, 4, 16);
+  for (auto &t : texts)
+    t = random_string(rng, 4, 16);
+
+  std::vector<char> slots(patterns.size() * 16, 'a');
+  for (size_t i = 0; i < patterns.size(); i++)
+    std::copy(patterns[i].begin(), patterns[i].end(), &slots[i * 16]);
+
+  std::vector<uint16_t> distances(patterns.size());
+  size_t ti = 0;
+  for (auto _ : state) {
+    const std::string &t = texts[ti++ % texts.size()];
+    Myers16x8Input input{t.c_str(), (int)t.size()};
+    for (size_t i = 0; i < patterns.size(); i += 8) {
+      for (int k = 0; k < 8; k++) {
+        input.d_wrds[k] = &slots[(i + k) * 16];
+        input.d_wrd_lens[k] = patterns[i + k].size();
+      }
+      auto r = levenshtein_myers_16x8(input);
+      std::copy(r.begin(), r.end(), &distances[i]);
+    }
+    benchmark::DoNotOptimize(distances.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * patterns.size());
+}
+BENCHMARK(BM_PatternsQuerySide16x8);
+
+// Near-duplicate pairs of 300 characters that differ in a few characters
+// around the middle; arg 0 runs anyx1 directly, arg 1 trims first
+static void BM_TrimNearDuplicates(benchmark::State &state) {
+  auto rng = make_rng();
+  std::vector<std::pair<std::string, std::string>> pairs(64);
+  for (auto &[q, d] : pairs) {
+    q = random_string_exact(rng, 300);
+    d = q;
+    for (int e = 0; e < 3; e++)
+      d[140 + rng() % 20] = 'a' + rng() % 26;
+  }
+
+  MyersTrimStats stats = {};
+  size_t pi = 0;
+  for (auto _ : state) {
+    const auto &[q, d] = pairs[pi++ % pairs.size()];
+    uint32_t dist =
+        state.range(0)
+            ? levenshtein_myers_trimmed(q.c_str(), q.size(), d.c_str(),
+                                        d.size(), &stats)
+            : levenshtein_myers_anyx1(q.c_str(), q.size(), d.c_str(),
+                                      d.size());
+    benchmark::DoNotOptimize(dist);
+  }
+  if (state.range(0))
+    state.counters["downgraded"] =
+        double(stats.downgraded) / state.iterations();
+}
+BENCHMARK(BM_TrimNearDuplicates)->Arg(0)->Arg(1);
+
+// The dispatcher on one query of the given length against 1024 words of
+// similar length, unpadded
+static void BM_DistanceBatch(benchmark::State &state) {
+  auto rng = make_rng();
+  int len = state.range(0);
+  std::string q = random_string_exact(rng, len);
+  std::vector<std::string> words(1024);
+  std::vector<const char *> wrds;
+  std::vector<int> lens;
+  for (auto &w : words) {
+    w = random_string(rng, std::max(1, len - 4), len + 4);
+    wrds.push_back(w.data());
+    lens.push_back(w.size());
+  }
+  std::vector<uint32_t> distances(words.size());
+  for (auto _ : state) {
+    levenshtein_distance(q.c_str(), q.size(), wrds.data(), lens.data(),
+                         words.size(), distances.data());
+    benchmark::DoNotOptimize(distances.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * words.size());
+}
+BENCHMARK(BM_DistanceBatch)->Arg(8)->Arg(16)->Arg(32)->Arg(64)->Arg(100);
+
+// Same, with the words in an arena so no group is copied
+static void BM_DistanceArena(benchmark::State &state) {
+  auto rng = make_rng();
+  int len = state.range(0);
+  std::string q = random_string_exact(rng, len);
+  MyersArena arena;
+  levenshtein_arena_init(arena, len + 4);
+  for (int i = 0; i < 1024; i++) {
+    std::string w = random_string(rng, std::max(1, len - 4), len + 4);
+    levenshtein_arena_add(arena, w.data(), w.size());
+  }
+  std::vector<uint32_t> distances(arena.wrds.size());
+  for (auto _ : state) {
+    levenshtein_distance(q.c_str(), q.size(), arena, distances.data());
+    benchmark::DoNotOptimize(distances.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * arena.wrds.size());
+}
+BENCHMARK(BM_DistanceArena)->Arg(8)->Arg(16)->Arg(32)->Arg(64)->Arg(100);
+
+// Batch ratio of a 100-character query against 1024 words of 60-140
+// characters, without a cutoff (0) and with cutoffs of 0.5 and 0.8 in percent
+static void BM_RatioBatch(benchmark::State &state) {
+  auto rng = make_rng();
+  std::string q = random_string_exact(rng, 100);
+  std::vector<std::string> words(1024);
+  std::vector<const char *> wrds;
+  std::vector<int> lens;
+  for (auto &w : words) {
+    w = random_string(rng, 60, 140);
+    wrds.push_back(w.data());
+    lens.push_back(w.size());
+  }
+  std::vector<float> scores(words.size());
+  double cutoff = state.range(0) / 100.0;
+  for (auto _ : state) {
+    levenshtein_ratio(q.data(), q.size(), wrds.data(), lens.data(),
+                      words.size(), cutoff, scores.data());
+    benchmark::DoNotOptimize(scores.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * words.size());
+}
+BENCHMARK(BM_RatioBatch)->Arg(0)->Arg(50)->Arg(80);
+
+// Partial ratio of a 20-character needle against 2 KB texts: semi-global
+// search (0) against the best of all sliding 20-character windows (1)
+static void BM_PartialRatio(benchmark::State &state) {
+  auto rng = make_rng();
+  std::string needle = random_string_exact(rng, 20);
+  std::string text = random_string_exact(rng, 2048);
+  for (auto _ : state) {
+    double best = 0;
+    if (state.range(0) == 0) {
+      best = levenshtein_partial_ratio(needle.data(), needle.size(),
+                                       text.data(), text.size());
+    } else {
+      for (size_t i = 0; i + needle.size() <= text.size(); i++)
+        best = std::max(best, levenshtein_ratio(needle.data(), needle.size(),
+                                                text.data() + i,
+                                                needle.size()));
+    }
+    benchmark::DoNotOptimize(best);
+  }
+}
+BENCHMARK(BM_PartialRatio)->Arg(0)->Arg(1);
+
+// A 64-base read against 1024 candidate loci of 64-200 bases, through the
+// 2-bit DNA kernel (0) or the a-z 64x2 kernel on lowercase acgt (1)
+static void BM_Dna64x2(benchmark::State &state) {
+  auto rng = make_rng();
+  std::uniform_int_distribution<int> base(0, 3), len(64, 200);
+  auto seq = [&](int n) {
+    std::string s(n, 'a');
+    for (auto &c : s)
+      c = "acgt"[base(rng)];
+    return s;
+  };
+  std::string q = seq(64);
+  std::vector<std::string> loci(1024);
+  std::vector<std::vector<uint8_t>> packed(loci.size());
+  for (size_t i = 0; i < loci.size(); i++) {
+    loci[i] = seq(len(rng));
+    packed[i].resize(MYERS_DNA_BYTES(loci[i].size()));
+    levenshtein_dna_pack(loci[i].data(), loci[i].size(), packed[i].data());
+  }
+  std::vector<uint8_t> q_packed(MYERS_DNA_BYTES(q.size()));
+  levenshtein_dna_pack(q.data(), q.size(), q_packed.data());
+
+  for (auto _ : state) {
+    for (size_t i = 0; i + 1 < loci.size(); i += 2) {
+      if (state.range(0) == 0) {
+        MyersDna64x2Input input{q_packed.data(), int(q.size()),
+                                {packed[i].data(), packed[i + 1].data()},
+                                {loci[i].size(), loci[i + 1].size()}};
+        benchmark::DoNotOptimize(
+            levenshtein_dna_64x2(input, MYERS_DNA_FORWARD));
+      } else {
+        Myers64x2Input input;
+        input.q_wrd = q.data();
+        input.q_wrd_len = q.size();
+        for (int k = 0; k < 2; k++) {
+          input.d_wrds[k] = loci[i + k].data();
+          input.d_wrd_lens[k] = loci[i + k].size();
+        }
+        benchmark::DoNotOptimize(levenshtein_myers_64x2(input));
+      }
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * loci.size());
+}
+BENCHMARK(BM_Dna64x2)->Arg(0)->Arg(1);
+
+// One 12-character query against an Arrow-layout column of 4096 rows of
+// 4-20 characters: read in place (0), or through a pointer array built per
+// call for the pointer/length overload (1)
+static void BM_ColumnScan(benchmark::State &state) {
+  auto rng = make_rng();
+  std::string q = random_string_exact(rng, 12);
+  std::string data;
+  std::vector<int32_t> offsets{0};
+  for (int i = 0; i < 4096; i++) {
+    data += random_string(rng, 4, 20);
+    offsets.push_back(data.size());
+  }
+  MyersStringColumn col;
+  col.data = data.data();
+  col.offsets32 = offsets.data();
+  col.length = offsets.size() - 1;
+
+  std::vector<uint32_t> distances(col.length);
+  for (auto _ : state) {
+    if (state.range(0) == 0) {
+      levenshtein_column_scan(q.data(), q.size(), col, UINT32_MAX,
+                              distances.data());
+    } else {
+      std::vector<const char *> wrds(col.length);
+      std::vector<int> lens(col.length);
+      for (size_t i = 0; i < col.length; i++) {
+        wrds[i] = data.data() + offsets[i];
+        lens[i] = offsets[i + 1] - offsets[i];
+      }
+      levenshtein_distance(q.data(), q.size(), wrds.data(), lens.data(),
+                           col.length, distances.data());
+    }
+    benchmark::DoNotOptimize(distances.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * col.length);
+}
+BENCHMARK(BM_ColumnScan)->Arg(0)->Arg(1);
+
+// Groups of 1 to 8 words of the given length, under the default plan (0) or
+// one tuned on this host (1); small groups are where the batch thresholds
+// matter
+static void BM_DistanceSmallBatches(benchmark::State &state) {
+  auto rng = make_rng();
+  int len = state.range(0);
+  MyersPlan plan = levenshtein_plan_default();
+  if (state.range(1))
+    levenshtein_tune(plan);
+  levenshtein_plan_set(plan);
+
+  std::string q = random_string_exact(rng, len);
+  std::vector<std::string> words(1024);
+  std::vector<const char *> wrds;
+  std::vector<int> lens;
+  for (auto &w : words) {
+    w = random_string_exact(rng, len);
+    wrds.push_back(w.data());
+    lens.push_back(w.size());
+  }
+  std::vector<uint32_t> distances(words.size());
+  for (auto _ : state) {
+    for (size_t i = 0, n = 1; i < words.size(); i += n, n = n % 8 + 1) {
+      n = std::min(n, words.size() - i);
+      levenshtein_distance(q.c_str(), q.size(), wrds.data() + i,
+                           lens.data() + i, n, distances.data() + i);
+    }
+    benchmark::DoNotOptimize(distances.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * words.size());
+  levenshtein_plan_set(levenshtein_plan_default());
+}
+BENCHMARK(BM_DistanceSmallBatches)
+    ->ArgsProduct({{8, 16, 32, 64}, {0, 1}});
+
+// One full tuning run at the default budget
+static void BM_Tune(benchmark::State &state) {
+  MyersPlan plan;
+  for (auto _ : state) {
+    levenshtein_tune(plan);
+    benchmark::DoNotOptimize(plan);
+  }
+}
+BENCHMARK(BM_Tune)->Unit(benchmark::kMillisecond)->Iterations(3);
+
+// ---------------------------------------------------------------------------
+// Alignment traceback
+// ---------------------------------------------------------------------------
+
+static void BM_Myers64x1Align(benchmark::State &state) {
+  auto rng = make_rng();
+  std::string q = random_string_exact(rng, 64), d = random_string_exact(rng, 64);
+  std::string ops;
+  for (auto _ : state) {
+    auto r = levenshtein_myers_64x1_align(q.c_str(), q.length(), d.c_str(),
+                                          d.length(), ops);
+    benchmark::DoNotOptimize(r);
+  }
+}
+BENCHMARK(BM_Myers64x1Align);
+
+static void BM_MyersAnyx1Align(benchmark::State &state) {
+  int len = state.range(0);
+  auto rng = make_rng();
+  std::string q = random_string_exact(rng, len), d = random_string_exact(rng, len);
+  std::string ops;
+  for (auto _ : state) {
+    auto r = levenshtein_myers_anyx1_align(q.c_str(), len, d.c_str(), len, ops);
+    benchmark::DoNotOptimize(r);
+  }
+  state.SetLabel("len=" + std::to_string(len));
+}
+BENCHMARK(BM_MyersAnyx1Align)->RangeMultiplier(4)->Range(128, 8192);
+
 BENCHMARK_MAIN();
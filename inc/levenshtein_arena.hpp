@@ -0,0 +1,63 @@
+#pragma once
+#include "levenshtein_myers.hpp"
+#include <memory>
+
+// Bump-allocated storage for database words.
+//
+// The batch kernels read every lane up to the longest word of the call, so a
+// word passed on its own (a std::string's c_str()) has to be over-allocated
+// by the caller. An arena copies words into large chunks instead: each word
+// starts on a 16-byte boundary, the gaps between words are filled with 'a',
+// and every chunk keeps `max_len` bytes of 'a' after its last word. Any read
+// of up to `max_len` bytes from the start of a word stays inside the chunk
+// and sees a-z bytes, whatever word shares the kernel call. Words never move
+// once added, so their pointers stay valid until the arena is cleared.
+#define MYERS_ARENA_ALIGN 16
+#define MYERS_ARENA_CHUNK (64 * 1024)
+
+struct alignas(MYERS_ARENA_ALIGN) MyersArenaLine {
+  char bytes[MYERS_ARENA_ALIGN];
+};
+
+struct MyersArena {
+  int max_len = 0;        // Longest word accepted
+  size_t chunk_bytes = 0; // Size of every chunk
+  std::vector<std::unique_ptr<MyersArenaLine[]>> chunks;
+  size_t current = 0; // Chunk being filled; later ones are kept from a clear
+  size_t used = 0;    // Bytes taken in the current chunk
+
+  // Every word in insertion order, ready to pass as d_wrds / d_wrd_lens
+  std::vector<const char *> wrds;
+  std::vector<int> lens;
+};
+
+// Start an empty arena for words of at most `max_len` bytes
+void levenshtein_arena_init(MyersArena &arena, int max_len);
+
+// Copy a word into the arena. Returns its stable copy, or nullptr if it is
+// longer than max_len.
+const char *levenshtein_arena_add(MyersArena &arena, const char *wrd, int len);
+
+// Drop every word but keep the chunks for reuse
+void levenshtein_arena_clear(MyersArena &arena);
+
+size_t levenshtein_arena_memory(const MyersArena &arena);
+
+// Batch builders: kernel inputs covering every word of the arena, one per
+// group of lanes in insertion order. Lanes past the last word repeat the
+// first word of the group. The query fields are left empty; set q_wrd and
+// q_wrd_len on each input before running a query, the words need no further
+// marshalling. Fails if a word does not fit the lane type (over 255
+// characters for 8x16, 65535 for 16x8).
+bool levenshtein_arena_inputs(const MyersArena &arena,
+                              std::vector<Myers8x16Input> &inputs,
+                              std::string *error);
+bool levenshtein_arena_inputs(const MyersArena &arena,
+                              std::vector<Myers16x8Input> &inputs,
+                              std::string *error);
+bool levenshtein_arena_inputs(const MyersArena &arena,
+                              std::vector<Myers32x4Input> &inputs,
+                              std::string *error);
+bool levenshtein_arena_inputs(const MyersArena &arena,
+                              std::vector<Myers64x2Input> &inputs,
+                              std::string *error);
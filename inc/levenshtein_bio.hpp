@@ -0,0 +1,70 @@
+#pragma once
+#include "levenshtein_myers.hpp"
+
+// Kernels for nucleotide and amino-acid sequences (patterns up to 64
+// residues, e.g. short reads against candidate loci).
+//
+// Nucleotides are 2-bit packed: A=0, C=1, G=2, T=3, base i in bits
+// 2 * (i % 4) of byte i / 4, so a complement is code ^ 3. The four pattern
+// bitmaps stay in registers and each lane's text is loaded 64 or 32 bits at a
+// time and shifted two bits per column; a column's match vector is picked
+// from the bitmaps with two selects on the code bits instead of a table load.
+//
+// MYERS_DNA_REVCOMP compares the pattern with the reverse complement of the
+// text. d(q, rc(t)) = d(rc(q), t), so only the pattern table is built from
+// the reverse complement; the text is read as stored.
+#define MYERS_DNA_FORWARD 0
+#define MYERS_DNA_REVCOMP 1
+
+// Packed size of `len` bases
+#define MYERS_DNA_BYTES(len) (((len) + 3) / 4)
+
+// Pack ACGT (either case) into `packed` (MYERS_DNA_BYTES(len) bytes). Fails
+// on any other character.
+bool levenshtein_dna_pack(const char *seq, int len, uint8_t *packed);
+
+// Base i of a packed sequence, as 'A', 'C', 'G' or 'T'
+char levenshtein_dna_base(const uint8_t *packed, int i);
+
+struct MyersDna64x2Input {
+  const uint8_t *q_seq; // Packed, at most 64 bases
+  int q_len;
+  const uint8_t *d_seqs[2];
+  uint64_t d_lens[2];
+};
+
+struct MyersDna32x4Input {
+  const uint8_t *q_seq; // Packed, at most 32 bases
+  int q_len;
+  const uint8_t *d_seqs[4];
+  uint32_t d_lens[4];
+};
+
+// Packed inputs are only read up to their last byte; no padding is needed
+uint32_t levenshtein_dna_64x1(const uint8_t *q_seq, int q_len,
+                              const uint8_t *d_seq, int d_len, int strand);
+std::array<uint64_t, 2> levenshtein_dna_64x2(const MyersDna64x2Input &input,
+                                             int strand);
+std::array<uint32_t, 4> levenshtein_dna_32x4(const MyersDna32x4Input &input,
+                                             int strand);
+
+// Amino acids are one code per byte, 0-19 in the order of
+// MYERS_PROTEIN_ALPHABET; the pattern table has 20 rows instead of 26 and
+// upper- and lowercase input encode alike.
+#define MYERS_PROTEIN_ALPHABET "ACDEFGHIKLMNPQRSTVWY"
+#define MYERS_PROTEIN_LEN 20
+
+// Encode one-letter amino-acid codes. Fails on any other character.
+bool levenshtein_protein_encode(const char *seq, int len, uint8_t *codes);
+
+struct MyersProtein64x2Input {
+  const uint8_t *q_codes; // At most 64 residues
+  int q_len;
+  const uint8_t *d_codes[2];
+  uint64_t d_lens[2];
+};
+
+uint32_t levenshtein_protein_64x1(const uint8_t *q_codes, int q_len,
+                                  const uint8_t *d_codes, int d_len);
+std::array<uint64_t, 2>
+levenshtein_protein_64x2(const MyersProtein64x2Input &input);
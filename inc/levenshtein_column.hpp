@@ -0,0 +1,54 @@
+#pragma once
+#include "levenshtein_myers.hpp"
+
+// Arrow-layout string columns, read in place.
+//
+// A column is the buffers of an Arrow utf8 or large_utf8 array: the value
+// bytes, length + 1 offsets (32- or 64-bit) and an optional validity bitmap
+// (row i is present if bit i % 8 of byte i / 8 is set). `offset` is the
+// array's slice offset and applies to both the offsets and the bitmap, as in
+// Arrow. No Arrow headers are needed; the fields map one to one onto the
+// buffers of an ArrowArray or an arrow::StringArray.
+//
+// Rows are gathered into kernel lanes by walking the offsets, and the batch
+// kernels read the value buffer in place. A lane may read past its row up to
+// the longest row of its group, which lands on the rows that follow; only
+// rows too close to the end of the values for that are copied, into a padded
+// scratch buffer. So every value byte between the first and the last row
+// must be a-z, null slots included (Arrow writers leave them empty). Null
+// rows never take a lane.
+#define MYERS_COLUMN_NULL UINT32_MAX // Distance reported for a null row
+
+struct MyersStringColumn {
+  const char *data = nullptr;
+  const int32_t *offsets32 = nullptr; // utf8
+  const int64_t *offsets64 = nullptr; // large_utf8, used if offsets32 is null
+  const uint8_t *validity = nullptr;  // Null when no row is null
+  int64_t offset = 0;
+  size_t length = 0;
+};
+
+struct MyersColumnHit {
+  uint64_t row;
+  uint32_t distance;
+};
+
+// Distances from the query to every row, written to `distances` (`length`
+// entries). Unless `max_dist` is UINT32_MAX, the bounded kernels run and
+// distances above it may be reported as any larger value.
+void levenshtein_column_scan(const char *q_wrd, int q_wrd_len,
+                             const MyersStringColumn &col, uint32_t max_dist,
+                             uint32_t *distances);
+
+// The `k` non-null rows nearest the query, written to `hits` nearest first,
+// ties in row order. Returns how many were written. Once k rows are held,
+// the k-th distance bounds the kernels for the rest of the column.
+size_t levenshtein_column_top_k(const char *q_wrd, int q_wrd_len,
+                                const MyersStringColumn &col, size_t k,
+                                MyersColumnHit *hits);
+
+// Row-wise distances between two columns of the same length:
+// distances[i] = d(a[i], b[i]), or MYERS_COLUMN_NULL if either row is null
+void levenshtein_column_pairwise(const MyersStringColumn &a,
+                                 const MyersStringColumn &b,
+                                 uint32_t *distances);
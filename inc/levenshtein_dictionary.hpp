@@ -0,0 +1,152 @@
+#pragma once
+#include "levenshtein_myers.hpp"
+#include <string>
+#include <vector>
+
+// Binary dictionary format, designed to be mmap'd and used in place.
+//
+// Layout (all integers little-endian, every section 64-byte aligned):
+//   MyersDictHeader
+//   MyersDictBucket[n_buckets]  one bucket per word length, ascending
+//   uint32_t ids[n_words]       original index of each length-sorted word
+//   uint64_t offsets[n_words+1] start of each word in the words section
+//   uint8_t hists[n_words][32]  per-word a-z histogram (saturating), used by
+//                               the prefilters of the thresholded scan
+//   char words[]                length-sorted words, back to back, followed
+//                               by max_wrd_len bytes of 'a' so kernels may
+//                               read past the end of a word
+//   uint8_t blocks[]            per bucket, MYERS_BLOCK_LANES words per
+//                               block, pre-encoded and lane-interleaved
+//                               (see MyersBlockInput)
+#define MYERS_DICT_MAGIC "LMYDICT"
+#define MYERS_DICT_VERSION 2
+#define MYERS_DICT_ALIGN 64
+#define MYERS_DICT_HIST_BINS 32
+
+struct MyersDictHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t header_size;
+  uint64_t file_size;
+  uint32_t n_words;
+  uint32_t n_buckets;
+  uint32_t max_wrd_len;
+  uint32_t block_lanes;
+  uint64_t buckets_off;
+  uint64_t ids_off;
+  uint64_t offsets_off;
+  uint64_t hists_off;
+  uint64_t words_off;
+  uint64_t blocks_off;
+  uint64_t checksum; // FNV-1a of the header (with checksum = 0) and buckets
+};
+
+struct MyersDictBucket {
+  uint32_t wrd_len;
+  uint32_t n_words;
+  uint32_t first;      // First length-sorted index of this bucket
+  uint32_t n_blocks;
+  uint64_t blocks_off; // Relative to the blocks section
+};
+
+// Read-only view of a dictionary image. All pointers point into the mapping.
+struct MyersDictionary {
+  const uint8_t *base;
+  size_t size;
+  bool mapped;
+  const MyersDictHeader *header;
+  const MyersDictBucket *buckets;
+  const uint32_t *ids;
+  const uint64_t *offsets;
+  const uint8_t *hists;
+  const char *words;
+  const uint8_t *blocks;
+};
+
+// Write the dictionary image for `words` to `path`. Words must consist of
+// a-z only. Returns false and sets `error` on failure.
+bool levenshtein_dictionary_build(const std::vector<std::string> &words,
+                                  const char *path, std::string *error);
+
+// Same, into `image` instead of a file, for use with
+// levenshtein_dictionary_from_memory
+bool levenshtein_dictionary_build(const std::vector<std::string> &words,
+                                  std::vector<uint8_t> &image,
+                                  std::string *error);
+
+// Map a dictionary file. Only the header and bucket table are validated, so
+// opening does not touch the pages holding the words and blocks.
+bool levenshtein_dictionary_open(MyersDictionary &dict, const char *path,
+                                 std::string *error);
+
+// Use an image that is already in memory. The buffer must outlive `dict`
+// and be 16-byte aligned.
+bool levenshtein_dictionary_from_memory(MyersDictionary &dict,
+                                        const void *data, size_t size,
+                                        std::string *error);
+
+void levenshtein_dictionary_close(MyersDictionary &dict);
+
+// Word at length-sorted position `idx`. Not NUL-terminated.
+inline const char *levenshtein_dictionary_word(const MyersDictionary &dict,
+                                               uint32_t idx, int *len) {
+  *len = dict.offsets[idx + 1] - dict.offsets[idx];
+  return dict.words + dict.offsets[idx];
+}
+
+// Distance from the query to every dictionary word. `distances` has
+// n_words entries and is indexed by the word's original index.
+void levenshtein_dictionary_scan(const MyersDictionary &dict,
+                                 const char *q_wrd, int q_wrd_len,
+                                 uint32_t *distances);
+
+// Output modes for when the distances themselves are not needed. Buckets
+// whose length difference rules them out are skipped, and every kernel
+// result is compared with the bound in its own lane type; the comparison
+// mask is narrowed to a 64-bit word and the matching lanes are read off it
+// bit by bit, so no per-word distance is stored.
+
+// Original indices of the words within `max_dist` of the query, written
+// densely to `ids` (room for n_words) in length-sorted order. Returns how
+// many were written.
+size_t levenshtein_dictionary_scan_ids(const MyersDictionary &dict,
+                                       const char *q_wrd, int q_wrd_len,
+                                       uint32_t max_dist, uint32_t *ids);
+
+// Number of words within `max_dist` of the query
+size_t levenshtein_dictionary_count_within(const MyersDictionary &dict,
+                                           const char *q_wrd, int q_wrd_len,
+                                           uint32_t max_dist);
+
+// Histogram of the distances from the query to every word, added to `hist`:
+// hist[d] counts words at distance d, and hist[n_bins - 1] those at
+// n_bins - 1 or more.
+void levenshtein_dictionary_scan_histogram(const MyersDictionary &dict,
+                                           const char *q_wrd, int q_wrd_len,
+                                           uint64_t *hist, int n_bins);
+
+struct MyersScanMatch {
+  uint32_t id; // Original index of the word
+  uint32_t distance;
+};
+
+// Per-stage counters of the thresholded scan
+struct MyersScanStats {
+  uint64_t candidates;         // Words considered
+  uint64_t rejected_length;    // Dropped by the length-difference bound
+  uint64_t rejected_histogram; // Dropped by the character histogram bound
+  uint64_t verified;           // Run through a Myers kernel
+  uint64_t matches;            // Within max_dist
+};
+
+// Every word within `max_dist` of the query, appended to `matches` in
+// length-sorted order. Candidates pass a filter cascade before the kernel:
+// whole buckets are skipped on the length difference, then each word's
+// histogram is compared with the query's (a word is at least L1 / 2 edits
+// away). Survivors are packed into the batch kernel lanes. `stats` may be
+// null; otherwise the counters are added to.
+void levenshtein_dictionary_scan_within(const MyersDictionary &dict,
+                                        const char *q_wrd, int q_wrd_len,
+                                        uint32_t max_dist,
+                                        std::vector<MyersScanMatch> &matches,
+                                        MyersScanStats *stats);
@@ -0,0 +1,75 @@
+#pragma once
+#include "levenshtein_arena.hpp"
+#include "levenshtein_myers.hpp"
+
+// Length-aware entry points. The caller passes strings; the dispatcher
+// picks a kernel whose word fits the pattern, so the per-width length limits
+// of the kernels never have to be known outside the library.
+//
+// The choice follows a plan: for each pattern length class, the kernel for a
+// single pair, the kernel for one pattern against many words, and the batch
+// size below which the batch kernel is not worth filling. The default plan
+// is the table measured for the README benchmarks; levenshtein_tune.hpp
+// measures one for the host.
+
+// Kernel ids
+#define MYERS_KERNEL_32X1 0
+#define MYERS_KERNEL_64X1 1
+#define MYERS_KERNEL_ANYX1 2 // 64-bit multi-word recurrence, any length
+#define MYERS_KERNEL_8X16 3
+#define MYERS_KERNEL_16X8 4
+#define MYERS_KERNEL_32X4 5
+#define MYERS_KERNEL_64X2 6
+#define MYERS_KERNEL_COUNT 7
+
+// Pattern length classes: up to 8, 16, 32, 64, and longer
+#define MYERS_PLAN_CLASSES 5
+
+struct MyersPlanEntry {
+  uint8_t single;     // Single-pair kernel (32x1, 64x1 or anyx1)
+  uint8_t batch;      // Kernel for one pattern against many words
+  uint16_t min_batch; // Fewer words than this run `single` per word
+};
+
+struct MyersPlan {
+  MyersPlanEntry classes[MYERS_PLAN_CLASSES];
+};
+
+const MyersPlan &levenshtein_plan_default();
+
+// The plan the dispatcher follows. On first use, if LEVENSHTEIN_PLAN_CACHE
+// names a file, the plan is loaded from it, or tuned and written there (see
+// levenshtein_tune.hpp); otherwise the default plan is used.
+const MyersPlan &levenshtein_plan_current();
+
+// Replace the current plan. Returns false if the plan is not valid. Safe to
+// call while other threads dispatch; they switch on their next call.
+bool levenshtein_plan_set(const MyersPlan &plan);
+
+// Class of a pattern of `len` characters
+int levenshtein_plan_class(int len);
+
+// Longest pattern a kernel accepts, and its name ("16x8", ...)
+int levenshtein_kernel_max_len(int kernel);
+const char *levenshtein_kernel_name(int kernel);
+
+// Whether every entry names a kernel that fits its class
+bool levenshtein_plan_valid(const MyersPlan &plan);
+
+// Distance between two a-z strings of any length. Common affixes are
+// stripped first and the shorter remainder becomes the pattern.
+uint32_t levenshtein_distance(const char *a, int a_len, const char *b,
+                              int b_len);
+
+// Distances from the query to `n` a-z words, written to `distances`. Words
+// need no padding: groups headed for a batch kernel are copied into a
+// padded scratch buffer first.
+void levenshtein_distance(const char *q_wrd, int q_wrd_len,
+                          const char *const *d_wrds, const int *d_wrd_lens,
+                          size_t n, uint32_t *distances);
+
+// Same, against every word of an arena, in insertion order. The arena's
+// padding makes the copy unnecessary, so the batch kernels read the words
+// in place.
+void levenshtein_distance(const char *q_wrd, int q_wrd_len,
+                          const MyersArena &arena, uint32_t *distances);
@@ -0,0 +1,44 @@
+#pragma once
+#include "levenshtein_myers.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+// Threshold similarity join: every pair (a, b) from two sets of a-z strings
+// with distance(a, b) <= max_dist.
+//
+// PassJoin: the right side is partitioned by length and each string is cut
+// into max_dist + 1 even segments. By the pigeonhole principle a string
+// within max_dist edits contains one of those segments unchanged, at a
+// shifted position that is bounded by the segment index and the length
+// difference. The segments form an inverted index, and each left string
+// probes it only with the substrings that can line up with a segment.
+// Candidates are verified with the bounded batch kernels. Left strings are
+// spread over `n_threads` workers (0 means one per core).
+
+struct MyersJoinPair {
+  uint32_t left;  // Index into the left set
+  uint32_t right; // Index into the right set
+  uint32_t distance;
+};
+
+struct MyersJoinStats {
+  uint64_t candidates; // Distinct pairs sharing a segment
+  uint64_t pairs;      // Pairs within max_dist
+};
+
+// Pairs are delivered in batches, in no particular order. Calls are
+// serialized, so the callback needs no locking of its own.
+using MyersJoinCallback = std::function<void(const MyersJoinPair *, size_t)>;
+
+void levenshtein_join(const std::vector<std::string> &left,
+                      const std::vector<std::string> &right,
+                      uint32_t max_dist, const MyersJoinCallback &emit,
+                      int n_threads, MyersJoinStats *stats);
+
+// Write up to `capacity` pairs to `out`. Returns the total number of pairs,
+// so a result larger than `capacity` means the buffer was too small.
+size_t levenshtein_join(const std::vector<std::string> &left,
+                        const std::vector<std::string> &right,
+                        uint32_t max_dist, MyersJoinPair *out,
+                        size_t capacity, int n_threads);
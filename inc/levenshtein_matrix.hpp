@@ -0,0 +1,36 @@
+#pragma once
+#include "levenshtein_myers.hpp"
+#include <string>
+#include <vector>
+
+// All-pairs distance matrices over a-z strings.
+//
+// Strings are sorted by length and copied into one padded buffer, so every
+// group of kernel lanes holds words of similar length. The matrix is then
+// cut into MYERS_MATRIX_TILE x MYERS_MATRIX_TILE tiles: a tile's targets
+// stay in L1/L2 while each of its queries runs over them. Tiles are handed
+// out to `n_threads` workers (0 means one per core). Distances that do not
+// fit the output type saturate.
+#define MYERS_MATRIX_TILE 256
+
+// Position of pair (i, j), i < j, in a condensed upper-triangular matrix of
+// n strings: row-major, diagonal omitted (the layout of scipy's pdist)
+inline size_t levenshtein_condensed_index(size_t n, size_t i, size_t j) {
+  return i * n - i * (i + 1) / 2 + (j - i - 1);
+}
+
+// Distances between all pairs of `strs`. `out` holds n * (n - 1) / 2
+// entries. Only the upper triangle of tiles is computed.
+void levenshtein_matrix_condensed(const std::vector<std::string> &strs,
+                                  uint8_t *out, int n_threads);
+void levenshtein_matrix_condensed(const std::vector<std::string> &strs,
+                                  uint16_t *out, int n_threads);
+
+// Distances from every query to every target, row-major: out[i * M + j]
+// is the distance from queries[i] to targets[j].
+void levenshtein_matrix(const std::vector<std::string> &queries,
+                        const std::vector<std::string> &targets, uint8_t *out,
+                        int n_threads);
+void levenshtein_matrix(const std::vector<std::string> &queries,
+                        const std::vector<std::string> &targets, uint16_t *out,
+                        int n_threads);
@@ -0,0 +1,73 @@
+#pragma once
+#include "levenshtein_dictionary.hpp"
+#include <string>
+#include <vector>
+
+// Banded MinHash index for near-duplicate search over long strings (a few
+// hundred to a few thousand bytes, any byte values).
+//
+// Each string is reduced to its set of character shingles (`shingle`
+// consecutive bytes). A signature holds, for each of bands * rows hash
+// functions, the minimum hash over the set; two strings agree on one entry
+// with probability equal to the Jaccard similarity J of their sets. Entries
+// are grouped into bands of `rows`, and two strings become candidates when
+// any band matches in full, which happens with probability
+// 1 - (1 - J^rows)^bands. More bands raise recall, more rows cut false
+// candidates. An edit touches at most `shingle` shingles, so strings within
+// k edits of each other keep a high J when k * shingle is small next to
+// their length.
+//
+// Candidates are verified with levenshtein_myers_anyx1_bounded, so reported
+// matches are exact; only recall depends on the parameters.
+#define MYERS_MINHASH_MAX_SHINGLE 16
+#define MYERS_MINHASH_MAX_HASHES 1024
+
+struct MyersMinHashParams {
+  int shingle;   // Bytes per shingle
+  int bands;
+  int rows;      // Hash functions per band
+  uint64_t seed; // Seed of the hash functions
+};
+
+struct MyersMinHashEntry {
+  uint64_t key; // Hash of one band of a signature
+  uint32_t id;
+};
+
+struct MyersMinHashIndex {
+  MyersMinHashParams params;
+  uint32_t n_strs;
+  std::vector<char> data;        // Strings back to back
+  std::vector<uint64_t> offsets; // n_strs + 1 entries into data
+  std::vector<uint64_t> mul;     // bands * rows odd multipliers
+  std::vector<uint64_t> add;     // and offsets of the hash functions
+  std::vector<MyersMinHashEntry> buckets; // n_strs per band, sorted by key
+};
+
+struct MyersMinHashStats {
+  uint64_t candidates; // Distinct strings sharing a band with the query
+  uint64_t verified;   // Candidates within the length bound, run through
+                       // the kernel
+  uint64_t matches;    // Within max_dist
+};
+
+// Probability that two strings with shingle Jaccard similarity `jaccard`
+// share at least one band
+double levenshtein_minhash_probability(double jaccard, int bands, int rows);
+
+// Returns false and sets `error` if the parameters are out of range.
+bool levenshtein_minhash_build(const std::vector<std::string> &strs,
+                               const MyersMinHashParams &params,
+                               MyersMinHashIndex &index, std::string *error);
+
+// Bytes held by the index
+size_t levenshtein_minhash_memory(const MyersMinHashIndex &index);
+
+// Candidates within `max_dist` of the query, appended to `matches` in
+// ascending id order. `stats` may be null; otherwise the counters are added
+// to. Safe to call from several threads.
+void levenshtein_minhash_search(const MyersMinHashIndex &index,
+                                const char *q_wrd, int q_wrd_len,
+                                uint32_t max_dist,
+                                std::vector<MyersScanMatch> &matches,
+                                MyersMinHashStats *stats);
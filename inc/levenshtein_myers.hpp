@@ -1,6 +1,9 @@
 #pragma once
 #include <stdint.h>
+#include <stddef.h>
 #include <array>
+#include <string>
+#include <vector>
 
 #define ALPHABET_LEN 26
 
@@ -32,12 +35,33 @@ struct Myers64x2Input {
   uint64_t d_wrd_lens[2];
 };
 
+// Pre-encoded, lane-interleaved database words of one common length, as
+// stored in the binary dictionary. Symbol i of lane k is found at
+// d_syms[i * MYERS_BLOCK_LANES + k] and holds c - 'a'; unused lanes hold
+// MYERS_PAD_SYMBOL. Kernels with fewer than 16 lanes read the first lanes of
+// the block, so callers offset d_syms by 8, 4, ... for the remaining ones.
+#define MYERS_BLOCK_LANES 16
+#define MYERS_PAD_SYMBOL ALPHABET_LEN
+
+struct MyersBlockInput {
+  const char *q_wrd;
+  int q_wrd_len;
+  const uint8_t *d_syms;
+  int d_wrd_len;
+};
+
 // Multiple strings at once
 std::array<uint8_t, 16> levenshtein_myers_8x16(const Myers8x16Input &input);
 std::array<uint16_t, 8> levenshtein_myers_16x8(const Myers16x8Input &input);
 std::array<uint32_t, 4> levenshtein_myers_32x4(const Myers32x4Input &input);
 std::array<uint64_t, 2> levenshtein_myers_64x2(const Myers64x2Input &input);
 
+// Multiple strings at once, lane-interleaved input
+std::array<uint8_t, 16> levenshtein_myers_8x16_block(const MyersBlockInput &input);
+std::array<uint16_t, 8> levenshtein_myers_16x8_block(const MyersBlockInput &input);
+std::array<uint32_t, 4> levenshtein_myers_32x4_block(const MyersBlockInput &input);
+std::array<uint64_t, 2> levenshtein_myers_64x2_block(const MyersBlockInput &input);
+
 
 // Optimized methods for strings of length 32, 64, and 128
 uint32_t levenshtein_myers_32x1(const char *q_wrd, int q_wrd_len, const char *d_wrd,
@@ -47,6 +71,240 @@ uint32_t levenshtein_myers_64x1(const char *q_wrd, int q_wrd_len, const char *d_
 uint32_t levenshtein_myers_128x1(const char *q_wrd, int q_wrd_len, const char *d_wrd,
                        int d_wrd_len);
 
-// Any string length
+// Scratch memory of the long-string kernels: a 256-row pattern table and
+// the vertical delta vectors. It grows to the longest query seen and is then
+// reused, so calls with a warm workspace allocate nothing. The pattern table
+// is all zero between calls. One workspace per thread.
+struct MyersWorkspace {
+  size_t words = 0; // 64-bit words per table row and delta vector
+  std::vector<uint64_t> peq;
+  std::vector<uint64_t> vp, vn;
+};
+
+// Grow `ws` to take queries of up to `max_len` characters
+void levenshtein_workspace_reserve(MyersWorkspace &ws, int max_len);
+
+// Any string length and any byte values. The overloads without a workspace
+// use one per thread.
 uint32_t levenshtein_myers_anyx1(const char *q_wrd, int q_wrd_len, const char *d_wrd,
                        int d_wrd_len);
+uint32_t levenshtein_myers_anyx1(const char *q_wrd, int q_wrd_len,
+                                 const char *d_wrd, int d_wrd_len,
+                                 MyersWorkspace &ws);
+
+// Bounded distance: exact up to `max_dist`, otherwise max_dist + 1. Lanes
+// whose length difference already exceeds the bound are skipped, and a lane
+// stops once the cell on the diagonal leading to D[m][n] (a lower bound on
+// the final score) passes max_dist. The kernel returns once all lanes have
+// stopped.
+std::array<uint8_t, 16>
+levenshtein_myers_8x16_bounded(const Myers8x16Input &input, uint8_t max_dist);
+std::array<uint16_t, 8>
+levenshtein_myers_16x8_bounded(const Myers16x8Input &input, uint16_t max_dist);
+std::array<uint32_t, 4>
+levenshtein_myers_32x4_bounded(const Myers32x4Input &input, uint32_t max_dist);
+std::array<uint64_t, 2>
+levenshtein_myers_64x2_bounded(const Myers64x2Input &input, uint64_t max_dist);
+
+// Bounded distance for strings of any length and any byte values. Meant for
+// verifying candidate pairs of long strings, where most pairs are rejected
+// by the length difference or after the first few hundred columns.
+uint32_t levenshtein_myers_anyx1_bounded(const char *q_wrd, int q_wrd_len,
+                                         const char *d_wrd, int d_wrd_len,
+                                         uint32_t max_dist);
+uint32_t levenshtein_myers_anyx1_bounded(const char *q_wrd, int q_wrd_len,
+                                         const char *d_wrd, int d_wrd_len,
+                                         uint32_t max_dist,
+                                         MyersWorkspace &ws);
+
+// Prefix edit distance: the distance from the query to the closest prefix of
+// each database word, i.e. the minimum of D[m][j] over all columns j. Meant
+// for autocomplete, where a word only has to start like the query. Results
+// above `max_dist` are reported as max_dist + 1; a lane stops once no later
+// column can lower its minimum, and the whole kernel once every lane has.
+std::array<uint8_t, 16> levenshtein_myers_8x16_prefix(const Myers8x16Input &input,
+                                                      uint8_t max_dist);
+std::array<uint16_t, 8> levenshtein_myers_16x8_prefix(const Myers16x8Input &input,
+                                                      uint16_t max_dist);
+std::array<uint32_t, 4> levenshtein_myers_32x4_prefix(const Myers32x4Input &input,
+                                                      uint32_t max_dist);
+std::array<uint64_t, 2> levenshtein_myers_64x2_prefix(const Myers64x2Input &input,
+                                                      uint64_t max_dist);
+uint32_t levenshtein_myers_32x1_prefix(const char *q_wrd, int q_wrd_len,
+                                       const char *d_wrd, int d_wrd_len,
+                                       uint32_t max_dist);
+uint32_t levenshtein_myers_64x1_prefix(const char *q_wrd, int q_wrd_len,
+                                       const char *d_wrd, int d_wrd_len,
+                                       uint32_t max_dist);
+
+// Optimal string alignment (restricted Damerau) distance: like Levenshtein,
+// plus a transposition of two adjacent characters counts as one edit.
+// Hyyrö's bit-parallel extension; same inputs and limits as the kernels above.
+std::array<uint8_t, 16> osa_myers_8x16(const Myers8x16Input &input);
+std::array<uint16_t, 8> osa_myers_16x8(const Myers16x8Input &input);
+std::array<uint32_t, 4> osa_myers_32x4(const Myers32x4Input &input);
+std::array<uint64_t, 2> osa_myers_64x2(const Myers64x2Input &input);
+uint32_t osa_myers_32x1(const char *q_wrd, int q_wrd_len, const char *d_wrd,
+                        int d_wrd_len);
+uint32_t osa_myers_64x1(const char *q_wrd, int q_wrd_len, const char *d_wrd,
+                        int d_wrd_len);
+uint32_t osa_myers_anyx1(const char *q_wrd, int q_wrd_len, const char *d_wrd,
+                         int d_wrd_len);
+
+// Indel distance (insertions and deletions only, no substitutions), i.e.
+// m + n - 2 * LCS. Bit-parallel LCS after Allison-Dix / Hyyrö; same inputs
+// and limits as the Levenshtein kernels. The result is at most m + n, so
+// for the 8x16 kernel m + n must stay below 256.
+std::array<uint8_t, 16> indel_lcs_8x16(const Myers8x16Input &input);
+std::array<uint16_t, 8> indel_lcs_16x8(const Myers16x8Input &input);
+std::array<uint32_t, 4> indel_lcs_32x4(const Myers32x4Input &input);
+std::array<uint64_t, 2> indel_lcs_64x2(const Myers64x2Input &input);
+uint32_t indel_lcs_32x1(const char *q_wrd, int q_wrd_len, const char *d_wrd,
+                        int d_wrd_len);
+uint32_t indel_lcs_64x1(const char *q_wrd, int q_wrd_len, const char *d_wrd,
+                        int d_wrd_len);
+uint32_t indel_lcs_anyx1(const char *q_wrd, int q_wrd_len, const char *d_wrd,
+                         int d_wrd_len);
+
+// Distance plus an optimal alignment as one op per column: '=' match,
+// 'X' substitution, 'I' query character with no database counterpart,
+// 'D' database character with no query counterpart. Any byte values are
+// accepted. The 64x1 variant keeps the vertical delta vectors of every
+// column (16 bytes each); the anyx1 variant splits long inputs
+// Hirschberg-style so memory stays linear in the string lengths.
+uint32_t levenshtein_myers_64x1_align(const char *q_wrd, int q_wrd_len,
+                                      const char *d_wrd, int d_wrd_len,
+                                      std::string &ops);
+uint32_t levenshtein_myers_anyx1_align(const char *q_wrd, int q_wrd_len,
+                                       const char *d_wrd, int d_wrd_len,
+                                       std::string &ops);
+
+// Run-length encode an op string, e.g. "===X=" -> "3=1X1="
+std::string levenshtein_cigar(const std::string &ops);
+
+// Approximate substring search (semi-global mode).
+//
+// The query is the pattern and the text is streamed through in chunks. The
+// text prefix is free, so a hit is reported for every text position where
+// some substring ending there is within `max_dist` edits of the pattern.
+// Text is matched byte-wise (any 8-bit value), unlike the global kernels
+// which are restricted to a-z. State carries over between calls, so a text
+// may be split at arbitrary byte boundaries without copying.
+struct MyersSearchHit {
+  uint64_t end_pos;  // Offset of the last matched text byte
+  uint32_t distance; // Edit distance of the best match ending at end_pos
+  uint32_t pattern;  // Lane index of the matching pattern
+};
+
+#define SEARCH_ALPHABET_LEN 256
+
+struct MyersSearch32x1State {
+  uint32_t bm[SEARCH_ALPHABET_LEN];
+  uint32_t vp, vn;
+  uint32_t hi_bit;
+  uint32_t score;
+  uint32_t max_dist;
+  uint64_t pos;
+};
+
+struct MyersSearch64x1State {
+  uint64_t bm[SEARCH_ALPHABET_LEN];
+  uint64_t vp, vn;
+  uint64_t hi_bit;
+  uint32_t score;
+  uint32_t max_dist;
+  uint64_t pos;
+};
+
+// Several patterns per scan, one per lane. A lane with q_wrd_lens[k] == 0
+// is unused and never reports hits.
+struct Myers8x16SearchInput {
+  const char *q_wrds[16];
+  uint8_t q_wrd_lens[16];
+  uint8_t max_dists[16];
+};
+
+struct Myers16x8SearchInput {
+  const char *q_wrds[8];
+  uint16_t q_wrd_lens[8];
+  uint16_t max_dists[8];
+};
+
+struct Myers32x4SearchInput {
+  const char *q_wrds[4];
+  uint32_t q_wrd_lens[4];
+  uint32_t max_dists[4];
+};
+
+struct Myers64x2SearchInput {
+  const char *q_wrds[2];
+  uint64_t q_wrd_lens[2];
+  uint64_t max_dists[2];
+};
+
+// The pattern tables are lane-interleaved (bm[c] holds the bitmaps of all
+// lanes for symbol c) so each text byte costs a single vector load.
+struct MyersSearch8x16State {
+  alignas(16) uint8_t bm[SEARCH_ALPHABET_LEN][16];
+  alignas(16) uint8_t vp[16], vn[16], scores[16], hi_bits[16], max_dists[16];
+  uint64_t pos;
+};
+
+struct MyersSearch16x8State {
+  alignas(16) uint16_t bm[SEARCH_ALPHABET_LEN][8];
+  alignas(16) uint16_t vp[8], vn[8], scores[8], hi_bits[8], max_dists[8];
+  uint64_t pos;
+};
+
+struct MyersSearch32x4State {
+  alignas(16) uint32_t bm[SEARCH_ALPHABET_LEN][4];
+  alignas(16) uint32_t vp[4], vn[4], scores[4], hi_bits[4], max_dists[4];
+  uint64_t pos;
+};
+
+struct MyersSearch64x2State {
+  alignas(16) uint64_t bm[SEARCH_ALPHABET_LEN][2];
+  alignas(16) uint64_t vp[2], vn[2], scores[2], hi_bits[2], max_dists[2];
+  uint64_t pos;
+};
+
+void levenshtein_myers_search_32x1_init(MyersSearch32x1State &state,
+                                        const char *q_wrd, int q_wrd_len,
+                                        uint32_t max_dist);
+void levenshtein_myers_search_64x1_init(MyersSearch64x1State &state,
+                                        const char *q_wrd, int q_wrd_len,
+                                        uint32_t max_dist);
+// Restart the search at text offset `pos`, as if the text began there,
+// keeping the pattern table built by init. Matches never span a restart.
+void levenshtein_myers_search_32x1_reset(MyersSearch32x1State &state,
+                                         uint64_t pos);
+void levenshtein_myers_search_64x1_reset(MyersSearch64x1State &state,
+                                         uint64_t pos);
+void levenshtein_myers_search_8x16_init(MyersSearch8x16State &state,
+                                        const Myers8x16SearchInput &input);
+void levenshtein_myers_search_16x8_init(MyersSearch16x8State &state,
+                                        const Myers16x8SearchInput &input);
+void levenshtein_myers_search_32x4_init(MyersSearch32x4State &state,
+                                        const Myers32x4SearchInput &input);
+void levenshtein_myers_search_64x2_init(MyersSearch64x2State &state,
+                                        const Myers64x2SearchInput &input);
+
+// Feed the next chunk of text. Hits are appended to `hits`.
+void levenshtein_myers_search_32x1(MyersSearch32x1State &state,
+                                   const char *text, size_t text_len,
+                                   std::vector<MyersSearchHit> &hits);
+void levenshtein_myers_search_64x1(MyersSearch64x1State &state,
+                                   const char *text, size_t text_len,
+                                   std::vector<MyersSearchHit> &hits);
+void levenshtein_myers_search_8x16(MyersSearch8x16State &state,
+                                   const char *text, size_t text_len,
+                                   std::vector<MyersSearchHit> &hits);
+void levenshtein_myers_search_16x8(MyersSearch16x8State &state,
+                                   const char *text, size_t text_len,
+                                   std::vector<MyersSearchHit> &hits);
+void levenshtein_myers_search_32x4(MyersSearch32x4State &state,
+                                   const char *text, size_t text_len,
+                                   std::vector<MyersSearchHit> &hits);
+void levenshtein_myers_search_64x2(MyersSearch64x2State &state,
+                                   const char *text, size_t text_len,
+                                   std::vector<MyersSearchHit> &hits);
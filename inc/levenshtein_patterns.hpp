@@ -0,0 +1,86 @@
+#pragma once
+#include "levenshtein_dictionary.hpp"
+#include <string>
+#include <vector>
+
+// Pattern-side index for a fixed set of short patterns (a watch list)
+// matched against a stream of texts.
+//
+// The batch kernels build the bitmaps of one query and stream many database
+// words through the lanes. Here the roles are swapped: each lane holds a
+// stored pattern, and every lane reads the same text. Patterns are sorted by
+// length and packed into groups of the narrowest lane width that fits them
+// (8x16 up to 8 characters, 16x8, 32x4, 64x2 up to 64). Each group stores
+// its pattern bitmap table lane-interleaved, so one column of the recurrence
+// is a single 16-byte load of the row for the text character: no per-call
+// bitmap construction and no gather.
+//
+// Texts may be of any length and contain any bytes; characters outside a-z
+// match nothing. Scores are kept modulo the lane width and recovered from
+// the text length, since D[m][n] lies within m of n.
+#define MYERS_PATTERN_MAX_LEN 64
+
+// Table rows of a group: one bitmap row per symbol (a-z plus one that
+// matches nothing), then the last-row mask and the pattern lengths
+#define MYERS_PATTERN_ROWS (ALPHABET_LEN + 3)
+#define MYERS_PATTERN_GROUP_BYTES (MYERS_PATTERN_ROWS * 16)
+
+struct MyersPatternGroup {
+  uint8_t width;    // Lane bits: 8, 16, 32 or 64
+  uint8_t n_lanes;  // Used lanes
+  uint8_t min_len;  // Shortest and longest pattern in the group
+  uint8_t max_len;
+  uint32_t first;   // Index of lane 0 in ids / lens
+};
+
+struct MyersPatternSet {
+  uint32_t n_patterns;
+  std::vector<MyersPatternGroup> groups;
+  std::vector<uint32_t> ids; // Original index of each pattern, lane order
+  std::vector<uint8_t> lens; // Length of each pattern, lane order
+  std::vector<uint8_t> tables; // MYERS_PATTERN_GROUP_BYTES per group
+};
+
+struct MyersPatternStats {
+  uint64_t groups_run;     // Groups streamed through a kernel
+  uint64_t groups_skipped; // Dropped by the length-difference bound
+  uint64_t matches;        // Within max_dist
+};
+
+// Patterns must be a-z and at most MYERS_PATTERN_MAX_LEN long. Returns
+// false and sets `error` otherwise.
+bool levenshtein_patterns_build(const std::vector<std::string> &patterns,
+                                MyersPatternSet &set, std::string *error);
+
+// Bytes held by the index
+size_t levenshtein_patterns_memory(const MyersPatternSet &set);
+
+// Distance from every pattern to the text. `distances` has n_patterns
+// entries and is indexed by the pattern's original index.
+void levenshtein_patterns_scan(const MyersPatternSet &set, const char *text,
+                               int text_len, uint32_t *distances);
+
+// Every pattern within `max_dist` of the text, appended to `matches` in
+// length-sorted order. Groups whose length range is already too far from
+// the text length are skipped. `stats` may be null; otherwise the counters
+// are added to. Safe to call from several threads.
+void levenshtein_patterns_scan_within(const MyersPatternSet &set,
+                                      const char *text, int text_len,
+                                      uint32_t max_dist,
+                                      std::vector<MyersScanMatch> &matches,
+                                      MyersPatternStats *stats);
+
+struct MyersPatternDictMatch {
+  uint32_t pattern;  // Original index of the pattern
+  uint32_t id;       // Original index of the dictionary word
+  uint32_t distance;
+};
+
+// Every (pattern, word) pair within `max_dist`, in one pass over the
+// dictionary: each word is read once and streamed through every group whose
+// length range can reach it, so a batch of queries shares the pass. Groups
+// are matched to a bucket once, by its word length. Appended to `matches` in
+// length-sorted word order.
+void levenshtein_patterns_scan_dictionary(
+    const MyersPatternSet &set, const MyersDictionary &dict, uint32_t max_dist,
+    std::vector<MyersPatternDictMatch> &matches, MyersPatternStats *stats);
@@ -0,0 +1,49 @@
+#pragma once
+#include "levenshtein_dictionary.hpp"
+#include <string>
+#include <vector>
+
+// Inverted q-gram index over a collection of a-z strings.
+//
+// Strings are kept sorted by length, so a length window is a contiguous id
+// range. Each gram (q consecutive letters, 2 <= q <= 4) has a posting list
+// of (id delta, occurrences) pairs, LEB128-encoded. A query merges the lists
+// of its grams and keeps the strings that pass the count filter: two strings
+// within k edits share at least |s| - q + 1 - k * q grams. Survivors are
+// verified with the bounded batch kernels. When that bound is not positive
+// (short queries or large k) the length window is verified in full.
+#define MYERS_QGRAM_MIN_Q 2
+#define MYERS_QGRAM_MAX_Q 4
+
+struct MyersQgramIndex {
+  int q;
+  uint32_t n_strs;
+  uint32_t max_len;
+  std::vector<char> data;        // Sorted strings back to back, plus padding
+  std::vector<uint64_t> offsets; // n_strs + 1 entries into data
+  std::vector<uint32_t> ids;     // Original index of each sorted string
+  std::vector<uint32_t> len_first; // First sorted id of each length, + end
+  std::vector<uint64_t> gram_offsets; // 26^q + 1 entries into postings
+  std::vector<uint8_t> postings;
+};
+
+struct MyersQgramStats {
+  uint64_t postings;  // Posting entries decoded
+  uint64_t verified;  // Strings run through a kernel
+  uint64_t matches;   // Within max_dist
+};
+
+// Returns false and sets `error` if q is out of range or a string is not a-z.
+bool levenshtein_qgram_build(const std::vector<std::string> &strs, int q,
+                             MyersQgramIndex &index, std::string *error);
+
+// Bytes held by the index
+size_t levenshtein_qgram_memory(const MyersQgramIndex &index);
+
+// Every string within `max_dist` of the query, appended to `matches` in
+// length-sorted order. The query must be a-z as well. `stats` may be null;
+// otherwise the counters are added to. Safe to call from several threads.
+void levenshtein_qgram_search(const MyersQgramIndex &index, const char *q_wrd,
+                              int q_wrd_len, uint32_t max_dist,
+                              std::vector<MyersScanMatch> &matches,
+                              MyersQgramStats *stats);
@@ -0,0 +1,42 @@
+#pragma once
+#include "levenshtein_myers.hpp"
+
+// Normalized similarity on top of the Myers kernels.
+//
+// ratio(a, b) = 1 - d(a, b) / max(|a|, |b|), and 1 for two empty strings.
+// partial_ratio(a, b) scores the shorter string against its best-matching
+// substring of the longer one: 1 - d' / min(|a|, |b|), where d' is the
+// semi-global distance (free prefix and suffix of the longer string). It is
+// 0 if exactly one string is empty.
+//
+// A score cutoff turns into an integer bound on the distance
+// (levenshtein_ratio_max_dist), so the bounded kernels can reject a pair
+// as soon as the bound is passed. Scores below the cutoff are reported as 0.
+
+// Largest distance at which a pair whose longer length is `len` still
+// reaches `score_cutoff`. Cutoffs at or below 0 give `len`.
+uint32_t levenshtein_ratio_max_dist(int len, double score_cutoff);
+
+// Any byte values and lengths
+double levenshtein_ratio(const char *a, int a_len, const char *b, int b_len,
+                         double score_cutoff = 0);
+double levenshtein_partial_ratio(const char *a, int a_len, const char *b,
+                                 int b_len, double score_cutoff = 0);
+
+// Ratios from the query to `n` a-z words, one float per word. Words need no
+// padding; they run through the bounded batch kernels with the bound of the
+// longest pair.
+void levenshtein_ratio(const char *q_wrd, int q_wrd_len,
+                       const char *const *d_wrds, const int *d_wrd_lens,
+                       size_t n, double score_cutoff, float *scores);
+
+// Same, as fixed-point scores: round(255 * ratio), 0 below the cutoff
+void levenshtein_ratio_u8(const char *q_wrd, int q_wrd_len,
+                          const char *const *d_wrds, const int *d_wrd_lens,
+                          size_t n, double score_cutoff, uint8_t *scores);
+
+// Partial ratios from the query to `n` texts, any byte values
+void levenshtein_partial_ratio(const char *q_wrd, int q_wrd_len,
+                               const char *const *d_wrds,
+                               const int *d_wrd_lens, size_t n,
+                               double score_cutoff, float *scores);
@@ -0,0 +1,55 @@
+#pragma once
+#include "levenshtein_dictionary.hpp"
+#include <string>
+#include <vector>
+
+// Symmetric-delete (SymSpell) index for short words.
+//
+// Two words are within k edits only if deleting at most k characters from
+// each yields a common string. Every deletion variant of every dictionary
+// word is hashed into an open-addressing table (linear probing, 8-byte
+// slots holding a 32-bit fingerprint and a postings offset). A lookup hashes
+// the deletion variants of the query, collects the words behind them and
+// verifies those with the 8x16 / 16x8 bounded kernels. Fingerprint
+// collisions only add candidates, never drop them.
+#define MYERS_SYMSPELL_MAX_LEN 16
+#define MYERS_SYMSPELL_MAX_DIST 3
+
+struct MyersSymSpellSlot {
+  uint32_t fingerprint;
+  uint32_t start; // Into postings; UINT32_MAX marks an empty slot
+};
+
+struct MyersSymSpellIndex {
+  uint32_t max_dist;
+  uint32_t n_words;
+  std::vector<char> words;     // MYERS_SYMSPELL_MAX_LEN bytes per word,
+                               // padded with 'a'
+  std::vector<uint8_t> lens;
+  std::vector<MyersSymSpellSlot> slots; // Power-of-two size
+  std::vector<uint32_t> postings;       // Per key: count, then word ids
+};
+
+struct MyersSymSpellStats {
+  uint64_t probes;     // Deletion variants of the query looked up
+  uint64_t candidates; // Distinct words behind them
+  uint64_t matches;    // Within max_dist
+};
+
+// Words must be a-z and at most MYERS_SYMSPELL_MAX_LEN long, and max_dist
+// at most MYERS_SYMSPELL_MAX_DIST. Returns false and sets `error` otherwise.
+bool levenshtein_symspell_build(const std::vector<std::string> &words,
+                                uint32_t max_dist, MyersSymSpellIndex &index,
+                                std::string *error);
+
+// Bytes held by the index
+size_t levenshtein_symspell_memory(const MyersSymSpellIndex &index);
+
+// Every word within `max_dist` (at most the build-time bound) of the query,
+// appended to `matches` in no particular order. The query must be a-z.
+// `stats` may be null; otherwise the counters are added to.
+void levenshtein_symspell_lookup(const MyersSymSpellIndex &index,
+                                 const char *q_wrd, int q_wrd_len,
+                                 uint32_t max_dist,
+                                 std::vector<MyersScanMatch> &matches,
+                                 MyersSymSpellStats *stats);
@@ -0,0 +1,48 @@
+#pragma once
+#include "levenshtein_myers.hpp"
+
+// Common prefix and suffix stripping. Removing a shared prefix or suffix
+// never changes the edit distance, so the recurrence only has to run over
+// the differing middle. The comparisons run 16 bytes at a time.
+//
+// For single pairs the trimmed query length picks the kernel, so a pair
+// that would have needed anyx1 can drop to 64x1 or 32x1. The batch
+// wrappers strip the affix shared by the query and every lane, and keep the
+// kernel width.
+
+// Length of the common prefix / suffix of a and b
+size_t levenshtein_common_prefix(const char *a, size_t a_len, const char *b,
+                                 size_t b_len);
+size_t levenshtein_common_suffix(const char *a, size_t a_len, const char *b,
+                                 size_t b_len);
+
+struct MyersTrimStats {
+  uint64_t pairs;         // Comparisons seen
+  uint64_t trimmed;       // Comparisons with a non-empty common affix
+  uint64_t bytes_trimmed; // Query bytes removed, summed over comparisons
+  uint64_t downgraded;    // Comparisons moved to a narrower kernel
+};
+
+// Distance for a-z strings of any length, on the narrowest single-pair
+// kernel that fits the trimmed query. `stats` may be null; otherwise the
+// counters are added to.
+uint32_t levenshtein_myers_trimmed(const char *q_wrd, int q_wrd_len,
+                                   const char *d_wrd, int d_wrd_len,
+                                   MyersTrimStats *stats);
+
+// levenshtein_myers_anyx1_bounded on the trimmed strings. Any byte values.
+uint32_t levenshtein_myers_bounded_trimmed(const char *q_wrd, int q_wrd_len,
+                                           const char *d_wrd, int d_wrd_len,
+                                           uint32_t max_dist,
+                                           MyersTrimStats *stats);
+
+// The batch kernels after stripping the affix common to the query and all
+// lanes. The same padding rules as the plain kernels apply.
+std::array<uint8_t, 16> levenshtein_myers_8x16_trimmed(
+    const Myers8x16Input &input, MyersTrimStats *stats);
+std::array<uint16_t, 8> levenshtein_myers_16x8_trimmed(
+    const Myers16x8Input &input, MyersTrimStats *stats);
+std::array<uint32_t, 4> levenshtein_myers_32x4_trimmed(
+    const Myers32x4Input &input, MyersTrimStats *stats);
+std::array<uint64_t, 2> levenshtein_myers_64x2_trimmed(
+    const Myers64x2Input &input, MyersTrimStats *stats);
@@ -0,0 +1,44 @@
+#pragma once
+#include "levenshtein_distance.hpp"
+#include <string>
+
+// Host autotuning for the dispatch plan.
+//
+// The crossovers between the batch kernels and the scalar ones differ
+// between cores (the defaults come from an M1 Max). levenshtein_tune times
+// every kernel that fits each length class on random a-z strings of the
+// class's longest pattern, and keeps the fastest single-pair kernel, the
+// fastest kernel per word for batches, and the batch size from which that
+// kernel beats running the words one by one.
+//
+// Tuning takes a few tens of milliseconds, so plans are cached in a small
+// text file keyed by the CPU model; a process that finds a cache for its
+// CPU loads it instead of tuning:
+//
+//   levenshtein-plan 1
+//   cpu <levenshtein_cpu_id()>
+//   <class> <single kernel> <batch kernel> <min_batch>   (one per class)
+#define MYERS_PLAN_VERSION 1
+
+// Time spent measuring one kernel on one length class
+#define MYERS_TUNE_BUDGET_US 2000
+
+// CPU model of the host, e.g. "0x41 0xd0c" (implementer and part) on
+// AArch64 Linux or the brand string on macOS
+std::string levenshtein_cpu_id();
+
+// Measure a plan for this host. `budget_us` is the time per kernel and class.
+void levenshtein_tune(MyersPlan &plan, int budget_us = MYERS_TUNE_BUDGET_US);
+
+bool levenshtein_plan_save(const MyersPlan &plan, const char *path,
+                           std::string *error);
+
+// Fails if the file is malformed, the plan is not valid, or it was tuned on
+// a different CPU.
+bool levenshtein_plan_load(MyersPlan &plan, const char *path,
+                           std::string *error);
+
+// Load the plan cached at `path`, or tune one and write it there, then make
+// it the current plan. Returns false only if the plan could not be cached;
+// the tuned plan is in use either way.
+bool levenshtein_plan_init(const char *path, std::string *error);
@@ -0,0 +1,57 @@
+#include "levenshtein_myers.hpp"
+#include <algorithm>
+#include <arm_neon.h>
+
+std::array<uint16_t, 8> indel_lcs_16x8(const Myers16x8Input &input) {
+  if (input.q_wrd_len == 0)
+    return std::to_array(input.d_wrd_lens);
+
+  uint16_t bm[ALPHABET_LEN] = {0}; // Bitmap for each letter in the alphabet
+
+  const char *q_wrd = input.q_wrd;
+  uint16_t q_wrd_len = input.q_wrd_len;
+
+  // A zero bit in v marks a query position that is part of the LCS
+  uint16x8_t v = vdupq_n_u16(0xFFFF);
+  uint16x8_t u;
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= 1 << i;
+  }
+
+  uint16x8_t d_wrd_lens = vld1q_u16(input.d_wrd_lens);
+
+  int max_d_wrd_len = std::ranges::max(input.d_wrd_lens);
+
+  for (int i = 0; i < max_d_wrd_len; i++) {
+    uint16_t c_bm_0 = bm[input.d_wrds[0][i] - 'a'];
+    uint16_t c_bm_1 = bm[input.d_wrds[1][i] - 'a'];
+    uint16_t c_bm_2 = bm[input.d_wrds[2][i] - 'a'];
+    uint16_t c_bm_3 = bm[input.d_wrds[3][i] - 'a'];
+    uint16_t c_bm_4 = bm[input.d_wrds[4][i] - 'a'];
+    uint16_t c_bm_5 = bm[input.d_wrds[5][i] - 'a'];
+    uint16_t c_bm_6 = bm[input.d_wrds[6][i] - 'a'];
+    uint16_t c_bm_7 = bm[input.d_wrds[7][i] - 'a'];
+    uint16x8_t c_bm = {c_bm_0, c_bm_1, c_bm_2, c_bm_3,
+                       c_bm_4, c_bm_5, c_bm_6, c_bm_7};
+
+    u = vandq_u16(v, c_bm);
+    uint16x8_t v_next = vorrq_u16(vaddq_u16(v, u), vsubq_u16(v, u));
+
+    uint16x8_t continue_eval = vcltq_u16(vdupq_n_u16(i), d_wrd_lens);
+    v = vbslq_u16(continue_eval, v_next, v);
+  }
+
+  // indel = m + n - 2 * lcs, and lcs = m - popcount(v), so the distance is
+  // n - m + 2 * popcount(v) over the low m bits
+  uint16x8_t q_mask = vdupq_n_u16(0xFFFF >> (16 - q_wrd_len));
+  uint16x8_t ones =
+      vpaddlq_u8(vcntq_u8(vreinterpretq_u8_u16(vandq_u16(v, q_mask))));
+  uint16x8_t scores = vaddq_u16(vsubq_u16(d_wrd_lens, vdupq_n_u16(q_wrd_len)),
+                                vshlq_n_u16(ones, 1));
+
+  std::array<uint16_t, 8> out;
+  vst1q_u16(out.data(), scores);
+  return out;
+}
@@ -0,0 +1,26 @@
+#include "levenshtein_myers.hpp"
+#include <bit>
+
+uint32_t indel_lcs_32x1(const char *q_wrd, int q_wrd_len, const char *d_wrd,
+                        int d_wrd_len) {
+  if (q_wrd_len == 0)
+    return d_wrd_len;
+
+  uint32_t bm[ALPHABET_LEN] = {0}; // Bitmap for each letter in the alphabet
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= (uint32_t(1) << i);
+  }
+
+  // A zero bit in v marks a query position that is part of the LCS
+  uint32_t v = ~0U;
+
+  for (int i = 0; i < d_wrd_len; i++) {
+    uint32_t u = v & bm[d_wrd[i] - 'a'];
+    v = (v + u) | (v - u);
+  }
+
+  uint32_t q_mask = ~0U >> (32 - q_wrd_len);
+  return d_wrd_len - q_wrd_len + 2 * std::popcount(v & q_mask);
+}
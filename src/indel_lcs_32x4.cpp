@@ -0,0 +1,52 @@
+#include "levenshtein_myers.hpp"
+#include <algorithm>
+#include <arm_neon.h>
+
+std::array<uint32_t, 4> indel_lcs_32x4(const Myers32x4Input &input) {
+  if (input.q_wrd_len == 0)
+    return std::to_array(input.d_wrd_lens);
+
+  uint32_t bm[ALPHABET_LEN] = {0}; // Bitmap for each letter in the alphabet
+
+  const char *q_wrd = input.q_wrd;
+  uint32_t q_wrd_len = input.q_wrd_len;
+
+  // A zero bit in v marks a query position that is part of the LCS
+  uint32x4_t v = vdupq_n_u32(0xFFFFFFFF);
+  uint32x4_t u;
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= 1 << i;
+  }
+
+  uint32x4_t d_wrd_lens = vld1q_u32(input.d_wrd_lens);
+
+  int max_d_wrd_len = std::ranges::max(input.d_wrd_lens);
+
+  for (int i = 0; i < max_d_wrd_len; i++) {
+    uint32_t c_bm_0 = bm[input.d_wrds[0][i] - 'a'];
+    uint32_t c_bm_1 = bm[input.d_wrds[1][i] - 'a'];
+    uint32_t c_bm_2 = bm[input.d_wrds[2][i] - 'a'];
+    uint32_t c_bm_3 = bm[input.d_wrds[3][i] - 'a'];
+    uint32x4_t c_bm = {c_bm_0, c_bm_1, c_bm_2, c_bm_3};
+
+    u = vandq_u32(v, c_bm);
+    uint32x4_t v_next = vorrq_u32(vaddq_u32(v, u), vsubq_u32(v, u));
+
+    uint32x4_t continue_eval = vcltq_u32(vdupq_n_u32(i), d_wrd_lens);
+    v = vbslq_u32(continue_eval, v_next, v);
+  }
+
+  // indel = m + n - 2 * lcs, and lcs = m - popcount(v), so the distance is
+  // n - m + 2 * popcount(v) over the low m bits
+  uint32x4_t q_mask = vdupq_n_u32(0xFFFFFFFF >> (32 - q_wrd_len));
+  uint32x4_t ones = vpaddlq_u16(
+      vpaddlq_u8(vcntq_u8(vreinterpretq_u8_u32(vandq_u32(v, q_mask)))));
+  uint32x4_t scores = vaddq_u32(vsubq_u32(d_wrd_lens, vdupq_n_u32(q_wrd_len)),
+                                vshlq_n_u32(ones, 1));
+
+  std::array<uint32_t, 4> out;
+  vst1q_u32(out.data(), scores);
+  return out;
+}
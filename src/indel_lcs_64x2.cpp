@@ -0,0 +1,49 @@
+#include "levenshtein_myers.hpp"
+#include <algorithm>
+#include <arm_neon.h>
+
+std::array<uint64_t, 2> indel_lcs_64x2(const Myers64x2Input &input) {
+  if (input.q_wrd_len == 0)
+    return std::to_array(input.d_wrd_lens);
+
+  uint64_t bm[ALPHABET_LEN] = {0}; // Bitmap for each letter in the alphabet
+
+  const char *q_wrd = input.q_wrd;
+  uint64_t q_wrd_len = input.q_wrd_len;
+
+  // A zero bit in v marks a query position that is part of the LCS
+  uint64x2_t v = vdupq_n_u64(~0ULL);
+  uint64x2_t u;
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= (uint64_t(1) << i);
+  }
+
+  uint64x2_t d_wrd_lens = vld1q_u64(input.d_wrd_lens);
+
+  int max_d_wrd_len = std::ranges::max(input.d_wrd_lens);
+
+  for (int i = 0; i < max_d_wrd_len; i++) {
+    uint64_t c_bm_0 = bm[input.d_wrds[0][i] - 'a'];
+    uint64_t c_bm_1 = bm[input.d_wrds[1][i] - 'a'];
+    uint64x2_t c_bm = {c_bm_0, c_bm_1};
+
+    u = vandq_u64(v, c_bm);
+    uint64x2_t v_next = vorrq_u64(vaddq_u64(v, u), vsubq_u64(v, u));
+
+    uint64x2_t continue_eval = vcltq_u64(vdupq_n_u64(i), d_wrd_lens);
+    v = vbslq_u64(continue_eval, v_next, v);
+  }
+
+  // indel = m + n - 2 * lcs, and lcs = m - popcount(v), so the distance is
+  // n - m + 2 * popcount(v) over the low m bits
+  uint64x2_t q_mask = vdupq_n_u64(~0ULL >> (64 - q_wrd_len));
+  uint64x2_t ones = vpaddlq_u32(vpaddlq_u16(
+      vpaddlq_u8(vcntq_u8(vreinterpretq_u8_u64(vandq_u64(v, q_mask))))));
+  uint64x2_t scores = vaddq_u64(vsubq_u64(d_wrd_lens, vdupq_n_u64(q_wrd_len)),
+                                vshlq_n_u64(ones, 1));
+
+  return std::array<uint64_t, 2>{vgetq_lane_u64(scores, 0),
+                                 vgetq_lane_u64(scores, 1)};
+}
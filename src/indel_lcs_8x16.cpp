@@ -0,0 +1,65 @@
+#include "levenshtein_myers.hpp"
+#include <algorithm>
+#include <arm_neon.h>
+
+std::array<uint8_t, 16> indel_lcs_8x16(const Myers8x16Input &input) {
+  if (input.q_wrd_len == 0)
+    return std::to_array(input.d_wrd_lens);
+
+  uint8_t bm[ALPHABET_LEN] = {0}; // Bitmap for each letter in the alphabet
+
+  const char *q_wrd = input.q_wrd;
+  uint8_t q_wrd_len = input.q_wrd_len;
+
+  // A zero bit in v marks a query position that is part of the LCS
+  uint8x16_t v = vdupq_n_u8(0xFF);
+  uint8x16_t u;
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= 1 << i;
+  }
+
+  uint8x16_t d_wrd_lens = vld1q_u8(input.d_wrd_lens);
+
+  int max_d_wrd_len = std::ranges::max(input.d_wrd_lens);
+
+  for (int i = 0; i < max_d_wrd_len; i++) {
+    uint8_t c_bm_0 = bm[input.d_wrds[0][i] - 'a'];
+    uint8_t c_bm_1 = bm[input.d_wrds[1][i] - 'a'];
+    uint8_t c_bm_2 = bm[input.d_wrds[2][i] - 'a'];
+    uint8_t c_bm_3 = bm[input.d_wrds[3][i] - 'a'];
+    uint8_t c_bm_4 = bm[input.d_wrds[4][i] - 'a'];
+    uint8_t c_bm_5 = bm[input.d_wrds[5][i] - 'a'];
+    uint8_t c_bm_6 = bm[input.d_wrds[6][i] - 'a'];
+    uint8_t c_bm_7 = bm[input.d_wrds[7][i] - 'a'];
+    uint8_t c_bm_8 = bm[input.d_wrds[8][i] - 'a'];
+    uint8_t c_bm_9 = bm[input.d_wrds[9][i] - 'a'];
+    uint8_t c_bm_10 = bm[input.d_wrds[10][i] - 'a'];
+    uint8_t c_bm_11 = bm[input.d_wrds[11][i] - 'a'];
+    uint8_t c_bm_12 = bm[input.d_wrds[12][i] - 'a'];
+    uint8_t c_bm_13 = bm[input.d_wrds[13][i] - 'a'];
+    uint8_t c_bm_14 = bm[input.d_wrds[14][i] - 'a'];
+    uint8_t c_bm_15 = bm[input.d_wrds[15][i] - 'a'];
+    uint8x16_t c_bm = {c_bm_0,  c_bm_1,  c_bm_2,  c_bm_3, c_bm_4,  c_bm_5,
+                       c_bm_6,  c_bm_7,  c_bm_8,  c_bm_9, c_bm_10, c_bm_11,
+                       c_bm_12, c_bm_13, c_bm_14, c_bm_15};
+
+    u = vandq_u8(v, c_bm);
+    uint8x16_t v_next = vorrq_u8(vaddq_u8(v, u), vsubq_u8(v, u));
+
+    uint8x16_t continue_eval = vcltq_u8(vdupq_n_u8(i), d_wrd_lens);
+    v = vbslq_u8(continue_eval, v_next, v);
+  }
+
+  // indel = m + n - 2 * lcs, and lcs = m - popcount(v), so the distance is
+  // n - m + 2 * popcount(v) over the low m bits
+  uint8x16_t q_mask = vdupq_n_u8(0xFF >> (8 - q_wrd_len));
+  uint8x16_t ones = vcntq_u8(vandq_u8(v, q_mask));
+  uint8x16_t scores = vaddq_u8(vsubq_u8(d_wrd_lens, vdupq_n_u8(q_wrd_len)),
+                                vshlq_n_u8(ones, 1));
+
+  std::array<uint8_t, 16> out;
+  vst1q_u8(out.data(), scores);
+  return out;
+}
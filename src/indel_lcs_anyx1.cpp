@@ -0,0 +1,51 @@
+#include "levenshtein_myers.hpp"
+#include <algorithm>
+#include <bit>
+#include <vector>
+
+uint32_t indel_lcs_anyx1(const char *q_wrd, int q_wrd_len, const char *d_wrd,
+                         int d_wrd_len) {
+  if (q_wrd_len == 0)
+    return d_wrd_len;
+
+  int blocks = (q_wrd_len + 63) / 64;
+
+  // Bitmap for each letter in the alphabet, `blocks` words per letter
+  std::vector<uint64_t> bm(size_t(ALPHABET_LEN) * blocks, 0);
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[size_t(q_wrd[i] - 'a') * blocks + i / 64] |= uint64_t(1) << (i % 64);
+  }
+
+  std::vector<uint64_t> v(blocks, ~0ULL);
+
+  for (int i = 0; i < d_wrd_len; i++) {
+    const uint64_t *c_bm = &bm[size_t(d_wrd[i] - 'a') * blocks];
+
+    // Multiword (v + u) | (v - u), carrying and borrowing across words
+    uint64_t carry = 0, borrow = 0;
+    for (int b = 0; b < blocks; b++) {
+      uint64_t u = v[b] & c_bm[b];
+
+      uint64_t sum = v[b] + u;
+      uint64_t carry_out = sum < u;
+      sum += carry;
+      carry_out |= sum < carry;
+
+      uint64_t diff = v[b] - u;
+      uint64_t borrow_out = v[b] < u;
+      borrow_out |= diff < borrow;
+      diff -= borrow;
+
+      v[b] = sum | diff;
+      carry = carry_out;
+      borrow = borrow_out;
+    }
+  }
+
+  int ones = 0;
+  for (int b = 0; b < blocks; b++) {
+    int bits = std::min(64, q_wrd_len - b * 64);
+    ones += std::popcount(v[b] & (~0ULL >> (64 - bits)));
+  }
+  return d_wrd_len - q_wrd_len + 2 * ones;
+}
@@ -0,0 +1,124 @@
+#include "levenshtein_arena.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+static bool fail(std::string *error, const char *msg) {
+  if (error)
+    *error = msg;
+  return false;
+}
+
+static size_t align_up(size_t n) {
+  return (n + MYERS_ARENA_ALIGN - 1) & ~size_t(MYERS_ARENA_ALIGN - 1);
+}
+
+// Move on to the next chunk, reusing one kept by levenshtein_arena_clear if
+// there is one. Reused chunks may hold old words of any bytes, so every
+// chunk is (re)filled with 'a' as it is taken.
+static void next_chunk(MyersArena &arena) {
+  if (!arena.chunks.empty() && arena.current + 1 < arena.chunks.size()) {
+    arena.current++;
+  } else {
+    size_t lines = arena.chunk_bytes / MYERS_ARENA_ALIGN;
+    arena.chunks.emplace_back(new MyersArenaLine[lines]);
+    arena.current = arena.chunks.size() - 1;
+  }
+  std::memset(arena.chunks[arena.current].get(), 'a', arena.chunk_bytes);
+  arena.used = 0;
+}
+
+void levenshtein_arena_init(MyersArena &arena, int max_len) {
+  arena.max_len = std::max(max_len, 0);
+  arena.chunk_bytes = std::max<size_t>(
+      MYERS_ARENA_CHUNK, align_up(size_t(arena.max_len) + MYERS_ARENA_ALIGN));
+  arena.chunks.clear();
+  arena.current = 0;
+  arena.used = 0;
+  arena.wrds.clear();
+  arena.lens.clear();
+}
+
+const char *levenshtein_arena_add(MyersArena &arena, const char *wrd,
+                                  int len) {
+  if (len < 0 || len > arena.max_len)
+    return nullptr;
+  // A word may start wherever max_len bytes still fit before the chunk end
+  if (arena.chunks.empty() || arena.used + arena.max_len > arena.chunk_bytes)
+    next_chunk(arena);
+
+  char *dst =
+      reinterpret_cast<char *>(arena.chunks[arena.current].get()) + arena.used;
+  std::memcpy(dst, wrd, len);
+  arena.used = align_up(arena.used + std::max(len, 1));
+  arena.wrds.push_back(dst);
+  arena.lens.push_back(len);
+  return dst;
+}
+
+void levenshtein_arena_clear(MyersArena &arena) {
+  // Words may have held any bytes, so the first chunk is refilled with 'a'
+  // now and the others as next_chunk reaches them
+  if (!arena.chunks.empty())
+    std::memset(arena.chunks[0].get(), 'a', arena.chunk_bytes);
+  arena.current = 0;
+  arena.used = 0;
+  arena.wrds.clear();
+  arena.lens.clear();
+}
+
+size_t levenshtein_arena_memory(const MyersArena &arena) {
+  return arena.chunks.size() * arena.chunk_bytes +
+         arena.wrds.capacity() * sizeof(const char *) +
+         arena.lens.capacity() * sizeof(int);
+}
+
+template <typename Input, int Lanes>
+static bool build_inputs(const MyersArena &arena, std::vector<Input> &inputs,
+                         std::string *error) {
+  using Len = std::remove_reference_t<decltype(Input{}.d_wrd_lens[0])>;
+  if (std::any_of(arena.lens.begin(), arena.lens.end(), [](int len) {
+        return uint64_t(len) > std::numeric_limits<Len>::max();
+      }))
+    return fail(error, "word too long for the lane type");
+
+  size_t n = arena.wrds.size();
+  inputs.resize((n + Lanes - 1) / Lanes);
+  for (size_t g = 0; g < inputs.size(); g++) {
+    Input &input = inputs[g];
+    input.q_wrd = nullptr;
+    input.q_wrd_len = 0;
+    size_t base = g * Lanes;
+    for (int k = 0; k < Lanes; k++) {
+      size_t i = base + k < n ? base + k : base;
+      input.d_wrds[k] = arena.wrds[i];
+      input.d_wrd_lens[k] = arena.lens[i];
+    }
+  }
+  return true;
+}
+
+bool levenshtein_arena_inputs(const MyersArena &arena,
+                              std::vector<Myers8x16Input> &inputs,
+                              std::string *error) {
+  return build_inputs<Myers8x16Input, 16>(arena, inputs, error);
+}
+
+bool levenshtein_arena_inputs(const MyersArena &arena,
+                              std::vector<Myers16x8Input> &inputs,
+                              std::string *error) {
+  return build_inputs<Myers16x8Input, 8>(arena, inputs, error);
+}
+
+bool levenshtein_arena_inputs(const MyersArena &arena,
+                              std::vector<Myers32x4Input> &inputs,
+                              std::string *error) {
+  return build_inputs<Myers32x4Input, 4>(arena, inputs, error);
+}
+
+bool levenshtein_arena_inputs(const MyersArena &arena,
+                              std::vector<Myers64x2Input> &inputs,
+                              std::string *error) {
+  return build_inputs<Myers64x2Input, 2>(arena, inputs, error);
+}
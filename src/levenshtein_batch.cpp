@@ -0,0 +1,180 @@
+#include "levenshtein_batch.hpp"
+#include <numeric>
+
+int levenshtein_batch_width(int q_wrd_len, uint32_t max_d_wrd_len) {
+  int width = q_wrd_len <= 8    ? 8
+              : q_wrd_len <= 16 ? 16
+              : q_wrd_len <= 32 ? 32
+              : q_wrd_len <= 64 ? 64
+                                : 0;
+  if (width == 8 && max_d_wrd_len > UINT8_MAX)
+    width = 16;
+  if (width == 16 && max_d_wrd_len > UINT16_MAX)
+    width = 32;
+  return width;
+}
+
+// The kernels for one lane width, with or without a bound
+template <bool Bounded> struct BatchKernels {
+  static auto run(const Myers8x16Input &input, uint32_t max_dist) {
+    if constexpr (Bounded)
+      return levenshtein_myers_8x16_bounded(
+          input, std::min<uint32_t>(max_dist, UINT8_MAX));
+    else
+      return levenshtein_myers_8x16(input);
+  }
+  static auto run(const Myers16x8Input &input, uint32_t max_dist) {
+    if constexpr (Bounded)
+      return levenshtein_myers_16x8_bounded(
+          input, std::min<uint32_t>(max_dist, UINT16_MAX));
+    else
+      return levenshtein_myers_16x8(input);
+  }
+  static auto run(const Myers32x4Input &input, uint32_t max_dist) {
+    if constexpr (Bounded)
+      return levenshtein_myers_32x4_bounded(input, max_dist);
+    else
+      return levenshtein_myers_32x4(input);
+  }
+  static auto run(const Myers64x2Input &input, uint32_t max_dist) {
+    if constexpr (Bounded)
+      return levenshtein_myers_64x2_bounded(input, max_dist);
+    else
+      return levenshtein_myers_64x2(input);
+  }
+};
+
+// Fill `Lanes`-wide inputs from the 16 gathered words and run them
+template <bool Bounded, typename Input, int Lanes>
+static void run_lanes(const char *q_wrd, int q_wrd_len, const char *const *wrds,
+                      const int *lens, uint32_t m, uint32_t max_dist,
+                      uint32_t *distances) {
+  for (uint32_t k = 0; k < m; k += Lanes) {
+    Input input{q_wrd, q_wrd_len};
+    for (int j = 0; j < Lanes; j++) {
+      input.d_wrds[j] = wrds[k + j];
+      input.d_wrd_lens[j] = lens[k + j];
+    }
+    auto r = BatchKernels<Bounded>::run(input, max_dist);
+    std::copy(r.begin(), r.begin() + std::min<uint32_t>(Lanes, m - k),
+              distances + k);
+  }
+}
+
+template <bool Bounded>
+static void batch(int width, const char *q_wrd, int q_wrd_len,
+                  const char *const *d_wrds, const int *d_wrd_lens, uint32_t n,
+                  uint32_t max_dist, uint32_t *distances) {
+  const char *wrds[16];
+  int lens[16];
+  for (uint32_t base = 0; base < n; base += 16) {
+    uint32_t m = std::min<uint32_t>(16, n - base);
+    for (uint32_t k = 0; k < 16; k++) {
+      wrds[k] = d_wrds[base + (k < m ? k : 0)];
+      lens[k] = d_wrd_lens[base + (k < m ? k : 0)];
+    }
+
+    uint32_t *out = distances + base;
+    switch (width) {
+    case 8:
+      run_lanes<Bounded, Myers8x16Input, 16>(q_wrd, q_wrd_len, wrds, lens, m,
+                                             max_dist, out);
+      break;
+    case 16:
+      run_lanes<Bounded, Myers16x8Input, 8>(q_wrd, q_wrd_len, wrds, lens, m,
+                                            max_dist, out);
+      break;
+    case 32:
+      run_lanes<Bounded, Myers32x4Input, 4>(q_wrd, q_wrd_len, wrds, lens, m,
+                                            max_dist, out);
+      break;
+    case 64:
+      run_lanes<Bounded, Myers64x2Input, 2>(q_wrd, q_wrd_len, wrds, lens, m,
+                                            max_dist, out);
+      break;
+    default:
+      for (uint32_t k = 0; k < m; k++) {
+        if constexpr (Bounded)
+          out[k] = levenshtein_myers_anyx1_bounded(q_wrd, q_wrd_len, wrds[k],
+                                                   lens[k], max_dist);
+        else
+          out[k] = levenshtein_myers_anyx1(q_wrd, q_wrd_len, wrds[k], lens[k]);
+      }
+      break;
+    }
+  }
+}
+
+void levenshtein_batch(int width, const char *q_wrd, int q_wrd_len,
+                       const char *const *d_wrds, const int *d_wrd_lens,
+                       uint32_t n, uint32_t *distances) {
+  batch<false>(width, q_wrd, q_wrd_len, d_wrds, d_wrd_lens, n, 0, distances);
+}
+
+void levenshtein_batch_bounded(int width, const char *q_wrd, int q_wrd_len,
+                               const char *const *d_wrds,
+                               const int *d_wrd_lens, uint32_t n,
+                               uint32_t max_dist, uint32_t *distances) {
+  batch<true>(width, q_wrd, q_wrd_len, d_wrds, d_wrd_lens, n, max_dist,
+              distances);
+}
+
+void levenshtein_batch_copied(int width, const char *q_wrd, int q_wrd_len,
+                              const char *const *d_wrds,
+                              const int *d_wrd_lens, uint32_t n,
+                              uint32_t max_dist, uint32_t *distances) {
+  thread_local std::vector<char> scratch;
+  const char *wrds[16];
+  int lens[16];
+  for (uint32_t base = 0; base < n; base += 16) {
+    uint32_t m = std::min<uint32_t>(16, n - base);
+    int max_len = 0;
+    for (uint32_t k = 0; k < m; k++)
+      max_len = std::max(max_len, d_wrd_lens[base + k]);
+
+    scratch.assign(size_t(m) * max_len, 'a');
+    for (uint32_t k = 0; k < m; k++) {
+      char *slot = scratch.data() + size_t(k) * max_len;
+      std::copy(d_wrds[base + k], d_wrds[base + k] + d_wrd_lens[base + k],
+                slot);
+      wrds[k] = slot;
+      lens[k] = d_wrd_lens[base + k];
+    }
+
+    int w = std::max(width, levenshtein_batch_width(q_wrd_len, max_len));
+    if (max_dist == UINT32_MAX)
+      batch<false>(w, q_wrd, q_wrd_len, wrds, lens, m, 0, distances + base);
+    else
+      batch<true>(w, q_wrd, q_wrd_len, wrds, lens, m, max_dist,
+                  distances + base);
+  }
+}
+
+void levenshtein_sort_strings(const std::vector<std::string> &strs,
+                              MyersSortedStrings &sorted) {
+  size_t n = strs.size();
+  sorted.ids.resize(n);
+  std::iota(sorted.ids.begin(), sorted.ids.end(), 0);
+  std::stable_sort(sorted.ids.begin(), sorted.ids.end(),
+                   [&](uint32_t a, uint32_t b) {
+                     return strs[a].size() < strs[b].size();
+                   });
+
+  size_t total = 0, max_len = 0;
+  for (const auto &s : strs) {
+    total += s.size();
+    max_len = std::max(max_len, s.size());
+  }
+  sorted.data.assign(total + max_len, 'a');
+
+  sorted.wrds.resize(n);
+  sorted.lens.resize(n);
+  size_t off = 0;
+  for (size_t i = 0; i < n; i++) {
+    const std::string &s = strs[sorted.ids[i]];
+    std::copy(s.begin(), s.end(), sorted.data.begin() + off);
+    sorted.wrds[i] = sorted.data.data() + off;
+    sorted.lens[i] = s.size();
+    off += s.size();
+  }
+}
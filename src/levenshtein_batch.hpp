@@ -0,0 +1,75 @@
+#pragma once
+#include "levenshtein_myers.hpp"
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Internal helpers that run one query against many pointer/length words with
+// the narrowest batch kernel that fits. Shared by the dictionary, matrix and
+// join code.
+
+// Kernel width for a query against words of at most `max_d_wrd_len`: the
+// narrowest that fits the query and whose score type cannot overflow, or 0
+// for anyx1
+int levenshtein_batch_width(int q_wrd_len, uint32_t max_d_wrd_len);
+
+// Distances from the query to `n` words. Lanes past `n` repeat the first
+// word. The batch kernels read every lane up to the longest word of its
+// group, so each word must be followed by readable a-z bytes that far.
+void levenshtein_batch(int width, const char *q_wrd, int q_wrd_len,
+                       const char *const *d_wrds, const int *d_wrd_lens,
+                       uint32_t n, uint32_t *distances);
+
+// Same, with the _bounded kernels: distances above `max_dist` may be
+// reported as any larger value
+void levenshtein_batch_bounded(int width, const char *q_wrd, int q_wrd_len,
+                               const char *const *d_wrds,
+                               const int *d_wrd_lens, uint32_t n,
+                               uint32_t max_dist, uint32_t *distances);
+
+// Same, for words without padding: each group of 16 is first copied into
+// equal-sized slots padded with 'a', and runs on `width` lanes or wider if a
+// word would overflow the score type. Runs the _bounded kernels unless
+// `max_dist` is UINT32_MAX.
+void levenshtein_batch_copied(int width, const char *q_wrd, int q_wrd_len,
+                              const char *const *d_wrds,
+                              const int *d_wrd_lens, uint32_t n,
+                              uint32_t max_dist, uint32_t *distances);
+
+// Strings in ascending length order, back to back, followed by padding so
+// kernels may read past the end of any of them
+struct MyersSortedStrings {
+  std::vector<char> data;
+  std::vector<const char *> wrds;
+  std::vector<int> lens;
+  std::vector<uint32_t> ids; // Original index of each sorted string
+};
+
+void levenshtein_sort_strings(const std::vector<std::string> &strs,
+                              MyersSortedStrings &sorted);
+
+// Run fn(task) for every task index on n_threads workers (0 means one per
+// core). Tasks are handed out dynamically.
+template <typename F>
+void levenshtein_parallel_for(size_t n_tasks, int n_threads, F fn) {
+  if (n_threads <= 0)
+    n_threads = std::max(1u, std::thread::hardware_concurrency());
+  n_threads = std::min<size_t>(n_threads, n_tasks);
+
+  std::atomic<size_t> next{0};
+  auto worker = [&]() {
+    for (size_t t; (t = next.fetch_add(1)) < n_tasks;)
+      fn(t);
+  };
+  if (n_threads <= 1) {
+    worker();
+    return;
+  }
+  std::vector<std::thread> threads;
+  for (int i = 0; i < n_threads; i++)
+    threads.emplace_back(worker);
+  for (auto &t : threads)
+    t.join();
+}
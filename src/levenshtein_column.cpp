@@ -0,0 +1,145 @@
+#include "levenshtein_column.hpp"
+#include "levenshtein_batch.hpp"
+#include "levenshtein_distance.hpp"
+
+static bool row_valid(const MyersStringColumn &col, size_t row) {
+  if (col.validity == nullptr)
+    return true;
+  int64_t i = col.offset + int64_t(row);
+  return (col.validity[i / 8] >> (i % 8)) & 1;
+}
+
+static int64_t row_offset(const MyersStringColumn &col, size_t row) {
+  int64_t i = col.offset + int64_t(row);
+  return col.offsets32 != nullptr ? col.offsets32[i] : col.offsets64[i];
+}
+
+static const char *row_at(const MyersStringColumn &col, size_t row,
+                          int *len) {
+  int64_t start = row_offset(col, row);
+  *len = int(row_offset(col, row + 1) - start);
+  return col.data + start;
+}
+
+// Run the query over the non-null rows in groups of 16 and hand each group
+// to emit(rows, distances, m). `max_dist` is read again for every group, so
+// emit may tighten it.
+template <typename F>
+static void scan_groups(const char *q_wrd, int q_wrd_len,
+                        const MyersStringColumn &col,
+                        const uint32_t &max_dist, F emit) {
+  thread_local std::vector<char> scratch;
+  const char *end = col.data + row_offset(col, col.length);
+  const char *wrds[16];
+  int lens[16];
+  uint64_t rows[16];
+  uint32_t distances[16];
+  uint32_t m = 0;
+
+  auto flush = [&]() {
+    int max_len = *std::max_element(lens, lens + m);
+    int width = levenshtein_batch_width(q_wrd_len, max_len);
+    if (width != 0) {
+      // Rows whose lane would be read past the end of the values
+      size_t tail = 0;
+      for (uint32_t k = 0; k < m; k++)
+        if (end - wrds[k] < max_len)
+          tail++;
+      if (tail > 0) {
+        scratch.assign(tail * max_len, 'a');
+        char *slot = scratch.data();
+        for (uint32_t k = 0; k < m; k++) {
+          if (end - wrds[k] < max_len) {
+            std::copy(wrds[k], wrds[k] + lens[k], slot);
+            wrds[k] = slot;
+            slot += max_len;
+          }
+        }
+      }
+    }
+
+    if (max_dist == UINT32_MAX)
+      levenshtein_batch(width, q_wrd, q_wrd_len, wrds, lens, m, distances);
+    else
+      levenshtein_batch_bounded(width, q_wrd, q_wrd_len, wrds, lens, m,
+                                max_dist, distances);
+    emit(rows, distances, m);
+    m = 0;
+  };
+
+  for (size_t r = 0; r < col.length; r++) {
+    if (!row_valid(col, r))
+      continue;
+    wrds[m] = row_at(col, r, &lens[m]);
+    rows[m] = r;
+    if (++m == 16)
+      flush();
+  }
+  if (m > 0)
+    flush();
+}
+
+void levenshtein_column_scan(const char *q_wrd, int q_wrd_len,
+                             const MyersStringColumn &col, uint32_t max_dist,
+                             uint32_t *distances) {
+  std::fill(distances, distances + col.length, MYERS_COLUMN_NULL);
+  scan_groups(q_wrd, q_wrd_len, col, max_dist,
+              [&](const uint64_t *rows, const uint32_t *d, uint32_t m) {
+                for (uint32_t k = 0; k < m; k++)
+                  distances[rows[k]] = d[k];
+              });
+}
+
+static bool hit_less(const MyersColumnHit &a, const MyersColumnHit &b) {
+  return a.distance < b.distance ||
+         (a.distance == b.distance && a.row < b.row);
+}
+
+size_t levenshtein_column_top_k(const char *q_wrd, int q_wrd_len,
+                                const MyersStringColumn &col, size_t k,
+                                MyersColumnHit *hits) {
+  if (k == 0)
+    return 0;
+
+  // `hits` is a max-heap of the best rows so far; a row enters only if it
+  // beats the worst of them, so nothing above that distance matters
+  size_t n = 0;
+  uint32_t max_dist = UINT32_MAX;
+  scan_groups(q_wrd, q_wrd_len, col, max_dist,
+              [&](const uint64_t *rows, const uint32_t *d, uint32_t m) {
+                for (uint32_t j = 0; j < m; j++) {
+                  MyersColumnHit hit{rows[j], d[j]};
+                  if (n < k) {
+                    hits[n++] = hit;
+                    std::push_heap(hits, hits + n, hit_less);
+                  } else if (hit_less(hit, hits[0])) {
+                    std::pop_heap(hits, hits + n, hit_less);
+                    hits[n - 1] = hit;
+                    std::push_heap(hits, hits + n, hit_less);
+                  } else {
+                    continue;
+                  }
+                  if (n == k)
+                    max_dist = hits[0].distance;
+                }
+              });
+  std::sort_heap(hits, hits + n, hit_less);
+  return n;
+}
+
+void levenshtein_column_pairwise(const MyersStringColumn &a,
+                                 const MyersStringColumn &b,
+                                 uint32_t *distances) {
+  // Every pair has its own pattern, so the single-pair dispatcher runs
+  // directly on the value buffers; it reads no byte past either row
+  for (size_t i = 0; i < a.length; i++) {
+    if (!row_valid(a, i) || !row_valid(b, i)) {
+      distances[i] = MYERS_COLUMN_NULL;
+      continue;
+    }
+    int a_len, b_len;
+    const char *a_row = row_at(a, i, &a_len);
+    const char *b_row = row_at(b, i, &b_len);
+    distances[i] = levenshtein_distance(a_row, a_len, b_row, b_len);
+  }
+}
@@ -0,0 +1,557 @@
+#include "levenshtein_dictionary.hpp"
+#include "levenshtein_batch.hpp"
+#include <algorithm>
+#include <arm_neon.h>
+#include <bit>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <numeric>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static size_t align_up(size_t v) {
+  return (v + MYERS_DICT_ALIGN - 1) & ~size_t(MYERS_DICT_ALIGN - 1);
+}
+
+static uint64_t fnv1a(const void *data, size_t size,
+                      uint64_t h = 14695981039346656037ULL) {
+  const uint8_t *p = (const uint8_t *)data;
+  for (size_t i = 0; i < size; i++) {
+    h ^= p[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+static uint64_t header_checksum(const MyersDictHeader &header,
+                                const MyersDictBucket *buckets) {
+  MyersDictHeader h = header;
+  h.checksum = 0;
+  uint64_t sum = fnv1a(&h, sizeof(h));
+  return fnv1a(buckets, header.n_buckets * sizeof(MyersDictBucket), sum);
+}
+
+static bool fail(std::string *error, const char *msg) {
+  if (error)
+    *error = msg;
+  return false;
+}
+
+bool levenshtein_dictionary_build(const std::vector<std::string> &words,
+                                  std::vector<uint8_t> &image,
+                                  std::string *error) {
+  for (const auto &w : words) {
+    for (char c : w) {
+      if (c < 'a' || c > 'z')
+        return fail(error, "words must consist of a-z only");
+    }
+  }
+  if (words.size() > UINT32_MAX)
+    return fail(error, "too many words");
+
+  uint32_t n_words = words.size();
+  std::vector<uint32_t> ids(n_words);
+  std::iota(ids.begin(), ids.end(), 0);
+  std::stable_sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b) {
+    return words[a].size() < words[b].size();
+  });
+
+  // Group the sorted words into one bucket per length
+  std::vector<MyersDictBucket> buckets;
+  uint64_t blocks_size = 0;
+  uint64_t words_size = 0;
+  uint32_t max_wrd_len = 0;
+  for (uint32_t i = 0; i < n_words; i++) {
+    uint32_t len = words[ids[i]].size();
+    if (buckets.empty() || buckets.back().wrd_len != len) {
+      if (!buckets.empty())
+        blocks_size += uint64_t(buckets.back().n_blocks) *
+                       buckets.back().wrd_len * MYERS_BLOCK_LANES;
+      buckets.push_back({len, 0, i, 0, blocks_size});
+    }
+    MyersDictBucket &b = buckets.back();
+    b.n_words++;
+    b.n_blocks = (b.n_words + MYERS_BLOCK_LANES - 1) / MYERS_BLOCK_LANES;
+    words_size += len;
+    max_wrd_len = std::max(max_wrd_len, len);
+  }
+  if (!buckets.empty())
+    blocks_size += uint64_t(buckets.back().n_blocks) *
+                   buckets.back().wrd_len * MYERS_BLOCK_LANES;
+
+  // Kernels may read up to a full word past the end of the last one
+  uint64_t words_pad = std::max<uint64_t>(max_wrd_len, MYERS_BLOCK_LANES);
+
+  MyersDictHeader header = {};
+  std::memcpy(header.magic, MYERS_DICT_MAGIC, sizeof(MYERS_DICT_MAGIC));
+  header.version = MYERS_DICT_VERSION;
+  header.header_size = sizeof(MyersDictHeader);
+  header.n_words = n_words;
+  header.n_buckets = buckets.size();
+  header.max_wrd_len = max_wrd_len;
+  header.block_lanes = MYERS_BLOCK_LANES;
+  header.buckets_off = align_up(sizeof(MyersDictHeader));
+  header.ids_off =
+      align_up(header.buckets_off + buckets.size() * sizeof(MyersDictBucket));
+  header.offsets_off = align_up(header.ids_off + n_words * sizeof(uint32_t));
+  header.hists_off =
+      align_up(header.offsets_off + (n_words + 1) * sizeof(uint64_t));
+  header.words_off =
+      align_up(header.hists_off + uint64_t(n_words) * MYERS_DICT_HIST_BINS);
+  header.blocks_off = align_up(header.words_off + words_size + words_pad);
+  header.file_size = align_up(header.blocks_off + blocks_size);
+  header.checksum = header_checksum(header, buckets.data());
+
+  image.assign(header.file_size, 0);
+  std::memcpy(image.data(), &header, sizeof(header));
+  std::memcpy(image.data() + header.buckets_off, buckets.data(),
+              buckets.size() * sizeof(MyersDictBucket));
+  std::memcpy(image.data() + header.ids_off, ids.data(),
+              n_words * sizeof(uint32_t));
+
+  uint64_t *offsets = (uint64_t *)(image.data() + header.offsets_off);
+  uint8_t *hists = image.data() + header.hists_off;
+  char *out_words = (char *)(image.data() + header.words_off);
+  uint64_t off = 0;
+  for (uint32_t i = 0; i < n_words; i++) {
+    const std::string &w = words[ids[i]];
+    uint8_t *hist = hists + uint64_t(i) * MYERS_DICT_HIST_BINS;
+    for (char c : w) {
+      if (hist[c - 'a'] != UINT8_MAX)
+        hist[c - 'a']++;
+    }
+    offsets[i] = off;
+    std::memcpy(out_words + off, w.data(), w.size());
+    off += w.size();
+  }
+  offsets[n_words] = off;
+  std::memset(out_words + off, 'a', words_pad);
+
+  uint8_t *blocks = image.data() + header.blocks_off;
+  for (const MyersDictBucket &b : buckets) {
+    uint8_t *block = blocks + b.blocks_off;
+    size_t block_bytes = size_t(b.wrd_len) * MYERS_BLOCK_LANES;
+    std::memset(block, MYERS_PAD_SYMBOL, b.n_blocks * block_bytes);
+    for (uint32_t j = 0; j < b.n_words; j++) {
+      const std::string &w = words[ids[b.first + j]];
+      uint8_t *lane = block + (j / MYERS_BLOCK_LANES) * block_bytes +
+                      j % MYERS_BLOCK_LANES;
+      for (uint32_t i = 0; i < b.wrd_len; i++)
+        lane[i * MYERS_BLOCK_LANES] = w[i] - 'a';
+    }
+  }
+
+  return true;
+}
+
+bool levenshtein_dictionary_build(const std::vector<std::string> &words,
+                                  const char *path, std::string *error) {
+  std::vector<uint8_t> image;
+  if (!levenshtein_dictionary_build(words, image, error))
+    return false;
+
+  FILE *f = std::fopen(path, "wb");
+  if (!f)
+    return fail(error, "cannot open output file");
+  bool ok = std::fwrite(image.data(), 1, image.size(), f) == image.size();
+  ok = (std::fclose(f) == 0) && ok;
+  if (!ok)
+    return fail(error, "write failed");
+  return true;
+}
+
+bool levenshtein_dictionary_from_memory(MyersDictionary &dict,
+                                        const void *data, size_t size,
+                                        std::string *error) {
+  dict = {};
+  const uint8_t *base = (const uint8_t *)data;
+  if (size < sizeof(MyersDictHeader))
+    return fail(error, "file too small");
+
+  const MyersDictHeader *h = (const MyersDictHeader *)base;
+  if (std::memcmp(h->magic, MYERS_DICT_MAGIC, sizeof(MYERS_DICT_MAGIC)) != 0)
+    return fail(error, "bad magic");
+  if (h->version != MYERS_DICT_VERSION)
+    return fail(error, "unsupported version");
+  if (h->header_size != sizeof(MyersDictHeader) ||
+      h->block_lanes != MYERS_BLOCK_LANES)
+    return fail(error, "incompatible layout");
+  if (h->file_size != size)
+    return fail(error, "size mismatch");
+
+  // Sections must be aligned, in order, and inside the image
+  uint64_t ends[] = {
+      h->buckets_off + uint64_t(h->n_buckets) * sizeof(MyersDictBucket),
+      h->ids_off + uint64_t(h->n_words) * sizeof(uint32_t),
+      h->offsets_off + (uint64_t(h->n_words) + 1) * sizeof(uint64_t),
+      h->hists_off + uint64_t(h->n_words) * MYERS_DICT_HIST_BINS,
+      h->words_off, h->blocks_off};
+  uint64_t starts[] = {h->buckets_off, h->ids_off, h->offsets_off,
+                       h->hists_off, h->words_off, h->blocks_off};
+  uint64_t prev_end = sizeof(MyersDictHeader);
+  for (int i = 0; i < 6; i++) {
+    if (starts[i] % MYERS_DICT_ALIGN != 0 || starts[i] < prev_end ||
+        ends[i] > size)
+      return fail(error, "bad section offsets");
+    prev_end = ends[i];
+  }
+
+  const MyersDictBucket *buckets =
+      (const MyersDictBucket *)(base + h->buckets_off);
+  if (header_checksum(*h, buckets) != h->checksum)
+    return fail(error, "checksum mismatch");
+
+  // The bucket table is small; check it is consistent with the header
+  uint64_t blocks_size = size - h->blocks_off;
+  uint32_t next_first = 0;
+  for (uint32_t b = 0; b < h->n_buckets; b++) {
+    const MyersDictBucket &bucket = buckets[b];
+    if (b > 0 && bucket.wrd_len <= buckets[b - 1].wrd_len)
+      return fail(error, "buckets not sorted");
+    if (bucket.first != next_first || bucket.wrd_len > h->max_wrd_len ||
+        bucket.n_blocks != (uint64_t(bucket.n_words) + MYERS_BLOCK_LANES - 1) /
+                               MYERS_BLOCK_LANES ||
+        bucket.blocks_off + uint64_t(bucket.n_blocks) * bucket.wrd_len *
+                                MYERS_BLOCK_LANES >
+            blocks_size)
+      return fail(error, "bad bucket");
+    next_first += bucket.n_words;
+  }
+  if (next_first != h->n_words)
+    return fail(error, "bucket counts do not add up");
+
+  // Only the last offset is read, to bound the words section
+  const uint64_t *offsets = (const uint64_t *)(base + h->offsets_off);
+  if (h->words_off + offsets[h->n_words] + h->max_wrd_len > h->blocks_off)
+    return fail(error, "words section overflows");
+
+  dict.base = base;
+  dict.size = size;
+  dict.header = h;
+  dict.buckets = buckets;
+  dict.ids = (const uint32_t *)(base + h->ids_off);
+  dict.offsets = offsets;
+  dict.hists = base + h->hists_off;
+  dict.words = (const char *)(base + h->words_off);
+  dict.blocks = base + h->blocks_off;
+  return true;
+}
+
+bool levenshtein_dictionary_open(MyersDictionary &dict, const char *path,
+                                 std::string *error) {
+  dict = {};
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0)
+    return fail(error, "cannot open file");
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+    ::close(fd);
+    return fail(error, "cannot stat file");
+  }
+
+  void *mem = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mem == MAP_FAILED)
+    return fail(error, "mmap failed");
+
+  if (!levenshtein_dictionary_from_memory(dict, mem, st.st_size, error)) {
+    ::munmap(mem, st.st_size);
+    return false;
+  }
+  dict.mapped = true;
+  return true;
+}
+
+void levenshtein_dictionary_close(MyersDictionary &dict) {
+  if (dict.mapped)
+    ::munmap((void *)dict.base, dict.size);
+  dict = {};
+}
+
+// Run every block of a bucket and hand each kernel result to
+// sink(first, n, r): `r` holds the lanes of words first .. first + N - 1 of
+// the bucket, of which the first `n` are real
+template <typename Sink>
+static void scan_bucket(const MyersDictionary &dict,
+                        const MyersDictBucket &bucket, const char *q_wrd,
+                        int q_wrd_len, Sink &sink) {
+  int width = levenshtein_batch_width(q_wrd_len, bucket.wrd_len);
+
+  size_t block_bytes = size_t(bucket.wrd_len) * MYERS_BLOCK_LANES;
+  const uint8_t *block = dict.blocks + bucket.blocks_off;
+
+  for (uint32_t blk = 0; blk < bucket.n_blocks; blk++) {
+    uint32_t first = blk * MYERS_BLOCK_LANES;
+    uint32_t n = std::min<uint32_t>(MYERS_BLOCK_LANES, bucket.n_words - first);
+    MyersBlockInput input{q_wrd, q_wrd_len, block, (int)bucket.wrd_len};
+
+    switch (width) {
+    case 8:
+      sink(first, n, levenshtein_myers_8x16_block(input));
+      break;
+    case 16:
+      for (uint32_t k = 0; k < n; k += 8) {
+        input.d_syms = block + k;
+        sink(first + k, std::min<uint32_t>(8, n - k),
+             levenshtein_myers_16x8_block(input));
+      }
+      break;
+    case 32:
+      for (uint32_t k = 0; k < n; k += 4) {
+        input.d_syms = block + k;
+        sink(first + k, std::min<uint32_t>(4, n - k),
+             levenshtein_myers_32x4_block(input));
+      }
+      break;
+    case 64:
+      for (uint32_t k = 0; k < n; k += 2) {
+        input.d_syms = block + k;
+        sink(first + k, std::min<uint32_t>(2, n - k),
+             levenshtein_myers_64x2_block(input));
+      }
+      break;
+    default:
+      for (uint32_t k = 0; k < n; k++) {
+        int len;
+        const char *w =
+            levenshtein_dictionary_word(dict, bucket.first + first + k, &len);
+        sink(first + k, 1,
+             std::array<uint32_t, 1>{
+                 levenshtein_myers_anyx1(q_wrd, q_wrd_len, w, len)});
+      }
+      break;
+    }
+    block += block_bytes;
+  }
+}
+
+// Writes each distance to the slot of the word's original index
+struct StoreSink {
+  const uint32_t *ids; // Of the bucket
+  uint32_t *distances;
+
+  template <typename T, size_t N>
+  void operator()(uint32_t first, uint32_t n, const std::array<T, N> &r) {
+    for (uint32_t k = 0; k < n; k++)
+      distances[ids[first + k]] = r[k];
+  }
+};
+
+void levenshtein_dictionary_scan(const MyersDictionary &dict,
+                                 const char *q_wrd, int q_wrd_len,
+                                 uint32_t *distances) {
+  for (uint32_t b = 0; b < dict.header->n_buckets; b++) {
+    const MyersDictBucket &bucket = dict.buckets[b];
+    StoreSink sink{dict.ids + bucket.first, distances};
+    scan_bucket(dict, bucket, q_wrd, q_wrd_len, sink);
+  }
+}
+
+// Lanes within the bound as a bit mask with 64 / N bits per lane, of which
+// only the lowest is kept. The comparison runs on the kernel's own lane type
+// and is narrowed to 64 bits (shift-right-narrow for bytes, plain narrowing
+// for wider lanes), which stands in for the movemask NEON lacks.
+static uint64_t within_mask(const std::array<uint8_t, 16> &r, uint32_t bound) {
+  uint8x16_t le = vcleq_u8(vld1q_u8(r.data()),
+                           vdupq_n_u8(std::min<uint32_t>(bound, UINT8_MAX)));
+  uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(le), 4);
+  return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) &
+         0x1111111111111111ULL;
+}
+
+static uint64_t within_mask(const std::array<uint16_t, 8> &r, uint32_t bound) {
+  uint16x8_t le = vcleq_u16(vld1q_u16(r.data()),
+                            vdupq_n_u16(std::min<uint32_t>(bound, UINT16_MAX)));
+  return vget_lane_u64(vreinterpret_u64_u8(vmovn_u16(le)), 0) &
+         0x0101010101010101ULL;
+}
+
+static uint64_t within_mask(const std::array<uint32_t, 4> &r, uint32_t bound) {
+  uint32x4_t le = vcleq_u32(vld1q_u32(r.data()), vdupq_n_u32(bound));
+  return vget_lane_u64(vreinterpret_u64_u16(vmovn_u32(le)), 0) &
+         0x0001000100010001ULL;
+}
+
+static uint64_t within_mask(const std::array<uint64_t, 2> &r, uint32_t bound) {
+  return uint64_t(r[0] <= bound) | uint64_t(r[1] <= bound) << 32;
+}
+
+static uint64_t within_mask(const std::array<uint32_t, 1> &r, uint32_t bound) {
+  return r[0] <= bound;
+}
+
+// Compacts the original ids of words within the bound into `out`, or only
+// counts them if `out` is null
+struct CompactSink {
+  const uint32_t *ids; // Of the bucket
+  uint32_t max_dist;
+  uint32_t *out;
+  size_t count;
+
+  template <typename T, size_t N>
+  void operator()(uint32_t first, uint32_t n, const std::array<T, N> &r) {
+    constexpr int stride = 64 / N;
+    uint64_t mask = within_mask(r, max_dist);
+    if (n < N)
+      mask &= (uint64_t(1) << (n * stride)) - 1;
+    if (!out) {
+      count += std::popcount(mask);
+      return;
+    }
+    while (mask) {
+      out[count++] = ids[first + std::countr_zero(mask) / stride];
+      mask &= mask - 1;
+    }
+  }
+};
+
+static size_t scan_compact(const MyersDictionary &dict, const char *q_wrd,
+                           int q_wrd_len, uint32_t max_dist, uint32_t *ids) {
+  size_t count = 0;
+  for (uint32_t b = 0; b < dict.header->n_buckets; b++) {
+    const MyersDictBucket &bucket = dict.buckets[b];
+    if (std::abs((int64_t)bucket.wrd_len - q_wrd_len) > max_dist)
+      continue;
+    CompactSink sink{dict.ids + bucket.first, max_dist, ids, count};
+    scan_bucket(dict, bucket, q_wrd, q_wrd_len, sink);
+    count = sink.count;
+  }
+  return count;
+}
+
+size_t levenshtein_dictionary_scan_ids(const MyersDictionary &dict,
+                                       const char *q_wrd, int q_wrd_len,
+                                       uint32_t max_dist, uint32_t *ids) {
+  return scan_compact(dict, q_wrd, q_wrd_len, max_dist, ids);
+}
+
+size_t levenshtein_dictionary_count_within(const MyersDictionary &dict,
+                                           const char *q_wrd, int q_wrd_len,
+                                           uint32_t max_dist) {
+  return scan_compact(dict, q_wrd, q_wrd_len, max_dist, nullptr);
+}
+
+// Counts every distance, clamped to the last bin. Neighbouring lanes go to
+// four interleaved copies of the histogram, so runs of equal distances do
+// not serialize on one counter.
+struct HistogramSink {
+  uint64_t *counts; // 4 copies of n_bins counters
+  uint32_t n_bins;
+
+  template <typename T, size_t N>
+  void operator()(uint32_t /*first*/, uint32_t n, const std::array<T, N> &r) {
+    uint32_t last = n_bins - 1;
+    for (uint32_t k = 0; k < n; k++)
+      counts[(k & 3) * n_bins + std::min<uint64_t>(r[k], last)]++;
+  }
+};
+
+void levenshtein_dictionary_scan_histogram(const MyersDictionary &dict,
+                                           const char *q_wrd, int q_wrd_len,
+                                           uint64_t *hist, int n_bins) {
+  if (n_bins <= 0)
+    return;
+  uint32_t last = n_bins - 1;
+  std::vector<uint64_t> counts(size_t(4) * n_bins, 0);
+  HistogramSink sink{counts.data(), uint32_t(n_bins)};
+  for (uint32_t b = 0; b < dict.header->n_buckets; b++) {
+    const MyersDictBucket &bucket = dict.buckets[b];
+    // The length difference is a lower bound, so whole buckets may land in
+    // the last bin without running a kernel
+    if (std::abs((int64_t)bucket.wrd_len - q_wrd_len) >= last) {
+      hist[last] += bucket.n_words;
+      continue;
+    }
+    scan_bucket(dict, bucket, q_wrd, q_wrd_len, sink);
+  }
+  for (int c = 0; c < 4; c++) {
+    for (int i = 0; i < n_bins; i++)
+      hist[i] += counts[size_t(c) * n_bins + i];
+  }
+}
+
+// Run the surviving words of one bucket through the pointer-based kernels.
+// All survivors share one length, so unused lanes repeat the first word.
+static void verify_survivors(const MyersDictionary &dict, int width,
+                             const char *q_wrd, int q_wrd_len,
+                             const uint32_t *survivors, uint32_t n,
+                             uint32_t *distances) {
+  std::vector<const char *> wrds(n);
+  std::vector<int> lens(n);
+  for (uint32_t k = 0; k < n; k++)
+    wrds[k] = levenshtein_dictionary_word(dict, survivors[k], &lens[k]);
+  levenshtein_batch(width, q_wrd, q_wrd_len, wrds.data(), lens.data(), n,
+                    distances);
+}
+
+void levenshtein_dictionary_scan_within(const MyersDictionary &dict,
+                                        const char *q_wrd, int q_wrd_len,
+                                        uint32_t max_dist,
+                                        std::vector<MyersScanMatch> &matches,
+                                        MyersScanStats *stats) {
+  MyersScanStats local = {};
+
+  alignas(16) uint8_t q_hist[MYERS_DICT_HIST_BINS] = {0};
+  for (int i = 0; i < q_wrd_len; i++) {
+    if (q_hist[q_wrd[i] - 'a'] != UINT8_MAX)
+      q_hist[q_wrd[i] - 'a']++;
+  }
+  uint8x16_t q_hist_lo = vld1q_u8(q_hist);
+  uint8x16_t q_hist_hi = vld1q_u8(q_hist + 16);
+
+  // Each edit changes the histogram L1 distance by at most two
+  uint64_t max_l1 = 2 * uint64_t(max_dist);
+
+  std::vector<uint32_t> survivors;
+  std::vector<uint32_t> distances;
+  for (uint32_t b = 0; b < dict.header->n_buckets; b++) {
+    const MyersDictBucket &bucket = dict.buckets[b];
+    local.candidates += bucket.n_words;
+
+    uint32_t len_diff = std::abs((int64_t)bucket.wrd_len - q_wrd_len);
+    if (len_diff > max_dist) {
+      local.rejected_length += bucket.n_words;
+      continue;
+    }
+
+    survivors.clear();
+    const uint8_t *hist =
+        dict.hists + uint64_t(bucket.first) * MYERS_DICT_HIST_BINS;
+    for (uint32_t j = 0; j < bucket.n_words; j++) {
+      uint8x16_t lo = vabdq_u8(vld1q_u8(hist), q_hist_lo);
+      uint8x16_t hi = vabdq_u8(vld1q_u8(hist + 16), q_hist_hi);
+      uint32_t l1 = vaddlvq_u8(lo) + vaddlvq_u8(hi);
+      if (l1 <= max_l1)
+        survivors.push_back(bucket.first + j);
+      hist += MYERS_DICT_HIST_BINS;
+    }
+    local.rejected_histogram += bucket.n_words - survivors.size();
+    if (survivors.empty())
+      continue;
+
+    distances.resize(survivors.size());
+    verify_survivors(dict, levenshtein_batch_width(q_wrd_len, bucket.wrd_len),
+                     q_wrd, q_wrd_len, survivors.data(), survivors.size(),
+                     distances.data());
+    local.verified += survivors.size();
+
+    for (size_t j = 0; j < survivors.size(); j++) {
+      if (distances[j] <= max_dist) {
+        matches.push_back({dict.ids[survivors[j]], distances[j]});
+        local.matches++;
+      }
+    }
+  }
+
+  if (stats) {
+    stats->candidates += local.candidates;
+    stats->rejected_length += local.rejected_length;
+    stats->rejected_histogram += local.rejected_histogram;
+    stats->verified += local.verified;
+    stats->matches += local.matches;
+  }
+}
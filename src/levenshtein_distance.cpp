@@ -0,0 +1,174 @@
+#include "levenshtein_distance.hpp"
+#include "levenshtein_batch.hpp"
+#include "levenshtein_trim.hpp"
+#include "levenshtein_tune.hpp"
+#include <atomic>
+#include <climits>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+
+static const int CLASS_MAX_LEN[MYERS_PLAN_CLASSES] = {8, 16, 32, 64, INT_MAX};
+
+static const int KERNEL_MAX_LEN[MYERS_KERNEL_COUNT] = {32, 64, INT_MAX, 8,
+                                                       16, 32, 64};
+
+static const char *const KERNEL_NAMES[MYERS_KERNEL_COUNT] = {
+    "32x1", "64x1", "anyx1", "8x16", "16x8", "32x4", "64x2"};
+
+// From the README tables: the batch kernel with the most lanes that fits
+// wins once there are two words to fill it with; single pairs go to the
+// narrowest scalar kernel. 128x1 is not implemented, so longer patterns use
+// the multi-word recurrence.
+static const MyersPlan DEFAULT_PLAN = {{
+    {MYERS_KERNEL_32X1, MYERS_KERNEL_8X16, 2},
+    {MYERS_KERNEL_32X1, MYERS_KERNEL_16X8, 2},
+    {MYERS_KERNEL_32X1, MYERS_KERNEL_32X4, 2},
+    {MYERS_KERNEL_64X1, MYERS_KERNEL_64X2, 2},
+    {MYERS_KERNEL_ANYX1, MYERS_KERNEL_ANYX1, 0},
+}};
+
+const MyersPlan &levenshtein_plan_default() { return DEFAULT_PLAN; }
+
+// Plans that were set are kept for the life of the process, so a reference
+// handed out by levenshtein_plan_current never dangles
+static std::mutex plans_mutex;
+static std::deque<MyersPlan> plans;
+static std::atomic<const MyersPlan *> current_plan{&DEFAULT_PLAN};
+
+bool levenshtein_plan_set(const MyersPlan &plan) {
+  if (!levenshtein_plan_valid(plan))
+    return false;
+  std::lock_guard<std::mutex> lock(plans_mutex);
+  plans.push_back(plan);
+  current_plan.store(&plans.back(), std::memory_order_release);
+  return true;
+}
+
+const MyersPlan &levenshtein_plan_current() {
+  static std::once_flag env_once;
+  std::call_once(env_once, [] {
+    if (const char *path = std::getenv("LEVENSHTEIN_PLAN_CACHE"))
+      levenshtein_plan_init(path, nullptr);
+  });
+  return *current_plan.load(std::memory_order_acquire);
+}
+
+int levenshtein_plan_class(int len) {
+  int c = 0;
+  while (len > CLASS_MAX_LEN[c])
+    c++;
+  return c;
+}
+
+int levenshtein_kernel_max_len(int kernel) { return KERNEL_MAX_LEN[kernel]; }
+
+const char *levenshtein_kernel_name(int kernel) { return KERNEL_NAMES[kernel]; }
+
+bool levenshtein_plan_valid(const MyersPlan &plan) {
+  for (int c = 0; c < MYERS_PLAN_CLASSES; c++) {
+    const MyersPlanEntry &e = plan.classes[c];
+    if (e.single > MYERS_KERNEL_ANYX1 || e.batch >= MYERS_KERNEL_COUNT)
+      return false;
+    if (KERNEL_MAX_LEN[e.single] < CLASS_MAX_LEN[c] ||
+        KERNEL_MAX_LEN[e.batch] < CLASS_MAX_LEN[c])
+      return false;
+  }
+  return true;
+}
+
+static uint32_t run_single(int kernel, const char *q_wrd, int q_wrd_len,
+                           const char *d_wrd, int d_wrd_len) {
+  switch (kernel) {
+  case MYERS_KERNEL_32X1:
+    return levenshtein_myers_32x1(q_wrd, q_wrd_len, d_wrd, d_wrd_len);
+  case MYERS_KERNEL_64X1:
+    return levenshtein_myers_64x1(q_wrd, q_wrd_len, d_wrd, d_wrd_len);
+  default:
+    // The distance never exceeds the longer length, so this bound is exact
+    return levenshtein_myers_anyx1_bounded(q_wrd, q_wrd_len, d_wrd, d_wrd_len,
+                                           std::max(q_wrd_len, d_wrd_len));
+  }
+}
+
+static uint32_t distance_single(const MyersPlan &plan, const char *a,
+                                int a_len, const char *b, int b_len) {
+  size_t prefix = levenshtein_common_prefix(a, a_len, b, b_len);
+  size_t suffix =
+      levenshtein_common_suffix(a + prefix, a_len - prefix, b + prefix,
+                                b_len - prefix);
+  a += prefix;
+  b += prefix;
+  a_len -= prefix + suffix;
+  b_len -= prefix + suffix;
+
+  if (a_len > b_len) {
+    std::swap(a, b);
+    std::swap(a_len, b_len);
+  }
+  if (a_len == 0)
+    return b_len;
+
+  int kernel = plan.classes[levenshtein_plan_class(a_len)].single;
+  return run_single(kernel, a, a_len, b, b_len);
+}
+
+uint32_t levenshtein_distance(const char *a, int a_len, const char *b,
+                              int b_len) {
+  return distance_single(levenshtein_plan_current(), a, a_len, b, b_len);
+}
+
+// `padded_len` is the length every word may be read up to without a copy
+// (an arena's max_len), or -1 if the words have to be copied first
+static void distance_batch(const char *q_wrd, int q_wrd_len,
+                           const char *const *d_wrds, const int *d_wrd_lens,
+                           size_t n, int padded_len, uint32_t *distances) {
+  const MyersPlan &plan = levenshtein_plan_current();
+  const MyersPlanEntry &entry = plan.classes[levenshtein_plan_class(q_wrd_len)];
+
+  int width = 0;
+  switch (entry.batch) {
+  case MYERS_KERNEL_8X16:
+    width = 8;
+    break;
+  case MYERS_KERNEL_16X8:
+    width = 16;
+    break;
+  case MYERS_KERNEL_32X4:
+    width = 32;
+    break;
+  case MYERS_KERNEL_64X2:
+    width = 64;
+    break;
+  }
+
+  if (width == 0 || n < entry.min_batch) {
+    for (size_t i = 0; i < n; i++)
+      distances[i] =
+          distance_single(plan, q_wrd, q_wrd_len, d_wrds[i], d_wrd_lens[i]);
+    return;
+  }
+
+  if (padded_len >= 0) {
+    int w = std::max(width, levenshtein_batch_width(q_wrd_len, padded_len));
+    levenshtein_batch(w, q_wrd, q_wrd_len, d_wrds, d_wrd_lens, uint32_t(n),
+                      distances);
+    return;
+  }
+
+  // The kernels read every lane up to the longest word of the group
+  levenshtein_batch_copied(width, q_wrd, q_wrd_len, d_wrds, d_wrd_lens,
+                           uint32_t(n), UINT32_MAX, distances);
+}
+
+void levenshtein_distance(const char *q_wrd, int q_wrd_len,
+                          const char *const *d_wrds, const int *d_wrd_lens,
+                          size_t n, uint32_t *distances) {
+  distance_batch(q_wrd, q_wrd_len, d_wrds, d_wrd_lens, n, -1, distances);
+}
+
+void levenshtein_distance(const char *q_wrd, int q_wrd_len,
+                          const MyersArena &arena, uint32_t *distances) {
+  distance_batch(q_wrd, q_wrd_len, arena.wrds.data(), arena.lens.data(),
+                 arena.wrds.size(), arena.max_len, distances);
+}
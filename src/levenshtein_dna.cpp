@@ -0,0 +1,223 @@
+#include "levenshtein_bio.hpp"
+#include <algorithm>
+#include <arm_neon.h>
+#include <cstring>
+
+bool levenshtein_dna_pack(const char *seq, int len, uint8_t *packed) {
+  if (len <= 0)
+    return true; // Nothing to write; `packed` may be null
+  std::memset(packed, 0, MYERS_DNA_BYTES(len));
+  for (int i = 0; i < len; i++) {
+    uint8_t code;
+    switch (seq[i]) {
+    case 'A':
+    case 'a':
+      code = 0;
+      break;
+    case 'C':
+    case 'c':
+      code = 1;
+      break;
+    case 'G':
+    case 'g':
+      code = 2;
+      break;
+    case 'T':
+    case 't':
+      code = 3;
+      break;
+    default:
+      return false;
+    }
+    packed[i / 4] |= code << (2 * (i % 4));
+  }
+  return true;
+}
+
+static uint8_t code_at(const uint8_t *packed, int i) {
+  return (packed[i / 4] >> (2 * (i % 4))) & 3;
+}
+
+char levenshtein_dna_base(const uint8_t *packed, int i) {
+  return "ACGT"[code_at(packed, i)];
+}
+
+// Pattern bitmaps of the four bases, for the pattern or its reverse
+// complement
+static void dna_table(const uint8_t *q_seq, int q_len, int strand,
+                      uint64_t bm[4]) {
+  std::fill(bm, bm + 4, 0);
+  for (int i = 0; i < q_len; i++) {
+    uint8_t code = strand == MYERS_DNA_REVCOMP
+                       ? code_at(q_seq, q_len - 1 - i) ^ 3
+                       : code_at(q_seq, i);
+    bm[code] |= uint64_t(1) << i;
+  }
+}
+
+// Bases first .. first + 31 (first a multiple of 4) as one word, base
+// `first` in the low bits. Reads no byte past the sequence; missing bases
+// are zero.
+static uint64_t load_bases_64(const uint8_t *seq, int len, int first) {
+  uint64_t v = 0;
+  int off = first / 4;
+  int n = std::min(8, MYERS_DNA_BYTES(len) - off);
+  if (n > 0)
+    std::memcpy(&v, seq + off, n);
+  return v;
+}
+
+static uint32_t load_bases_32(const uint8_t *seq, int len, int first) {
+  uint32_t v = 0;
+  int off = first / 4;
+  int n = std::min(4, MYERS_DNA_BYTES(len) - off);
+  if (n > 0)
+    std::memcpy(&v, seq + off, n);
+  return v;
+}
+
+uint32_t levenshtein_dna_64x1(const uint8_t *q_seq, int q_len,
+                              const uint8_t *d_seq, int d_len, int strand) {
+  if (q_len == 0)
+    return d_len;
+
+  uint64_t bm[4];
+  dna_table(q_seq, q_len, strand, bm);
+  uint64_t p0 = bm[0], p1 = bm[1], p2 = bm[2], p3 = bm[3];
+
+  uint64_t vp = ~0ULL;
+  uint64_t vn = 0;
+  uint64_t hi_bit = uint64_t(1) << (q_len - 1);
+  uint32_t score = q_len;
+  uint64_t text = 0;
+
+  for (int i = 0; i < d_len; i++) {
+    if ((i & 31) == 0)
+      text = load_bases_64(d_seq, d_len, i);
+    uint64_t lo = 0 - (text & 1);
+    uint64_t hi = 0 - ((text >> 1) & 1);
+    uint64_t eq = (hi & ((lo & p3) | (~lo & p2))) |
+                  (~hi & ((lo & p1) | (~lo & p0)));
+    text >>= 2;
+
+    uint64_t x = eq | vn;
+    uint64_t d0 = ((vp + (x & vp)) ^ vp) | x;
+    uint64_t hn = vp & d0;
+    uint64_t hp = vn | ~(vp | d0);
+    uint64_t y = (hp << 1) | 1;
+    vn = y & d0;
+    vp = (hn << 1) | ~(y | d0);
+
+    if ((hp & hi_bit) != 0) {
+      score++;
+    } else if ((hn & hi_bit) != 0) {
+      score--;
+    }
+  }
+
+  return score;
+}
+
+std::array<uint64_t, 2> levenshtein_dna_64x2(const MyersDna64x2Input &input,
+                                             int strand) {
+  if (input.q_len == 0)
+    return std::to_array(input.d_lens);
+
+  uint64_t bm[4];
+  dna_table(input.q_seq, input.q_len, strand, bm);
+  uint64x2_t p0 = vdupq_n_u64(bm[0]), p1 = vdupq_n_u64(bm[1]);
+  uint64x2_t p2 = vdupq_n_u64(bm[2]), p3 = vdupq_n_u64(bm[3]);
+
+  const uint64x2_t zero = vdupq_n_u64(0);
+  const uint64x2_t one = vdupq_n_u64(1);
+  const uint64x2_t ones = vdupq_n_u64(~0ULL);
+  uint64x2_t scores = vdupq_n_u64(input.q_len);
+  uint64x2_t vp = ones;
+  uint64x2_t vn = zero;
+  uint64x2_t hi_bit = vdupq_n_u64(uint64_t(1) << (input.q_len - 1));
+  uint64x2_t d_lens = vld1q_u64(input.d_lens);
+  int max_d_len = std::max(input.d_lens[0], input.d_lens[1]);
+  uint64x2_t text = zero;
+
+  for (int i = 0; i < max_d_len; i++) {
+    if ((i & 31) == 0) {
+      text = uint64x2_t{
+          load_bases_64(input.d_seqs[0], input.d_lens[0], i),
+          load_bases_64(input.d_seqs[1], input.d_lens[1], i)};
+    }
+    uint64x2_t lo = vsubq_u64(zero, vandq_u64(text, one));
+    uint64x2_t hi = vsubq_u64(zero, vandq_u64(vshrq_n_u64(text, 1), one));
+    uint64x2_t eq =
+        vbslq_u64(hi, vbslq_u64(lo, p3, p2), vbslq_u64(lo, p1, p0));
+    text = vshrq_n_u64(text, 2);
+
+    uint64x2_t x = vorrq_u64(eq, vn);
+    uint64x2_t d0 =
+        vorrq_u64(veorq_u64(vaddq_u64(vandq_u64(vp, x), vp), vp), x);
+    uint64x2_t hn = vandq_u64(vp, d0);
+    uint64x2_t hp = vorrq_u64(vn, veorq_u64(vorrq_u64(vp, d0), ones));
+    uint64x2_t y = vorrq_u64(vshlq_n_u64(hp, 1), one);
+    vn = vandq_u64(y, d0);
+    vp = vorrq_u64(vshlq_n_u64(hn, 1), veorq_u64(vorrq_u64(y, d0), ones));
+
+    // hp and hn never share a bit; lanes past their length stay put
+    uint64x2_t active = vcltq_u64(vdupq_n_u64(i), d_lens);
+    scores = vsubq_u64(scores, vandq_u64(active, vtstq_u64(hp, hi_bit)));
+    scores = vaddq_u64(scores, vandq_u64(active, vtstq_u64(hn, hi_bit)));
+  }
+
+  return std::array<uint64_t, 2>{vgetq_lane_u64(scores, 0),
+                                 vgetq_lane_u64(scores, 1)};
+}
+
+std::array<uint32_t, 4> levenshtein_dna_32x4(const MyersDna32x4Input &input,
+                                             int strand) {
+  if (input.q_len == 0)
+    return std::to_array(input.d_lens);
+
+  uint64_t bm[4];
+  dna_table(input.q_seq, input.q_len, strand, bm);
+  uint32x4_t p0 = vdupq_n_u32(bm[0]), p1 = vdupq_n_u32(bm[1]);
+  uint32x4_t p2 = vdupq_n_u32(bm[2]), p3 = vdupq_n_u32(bm[3]);
+
+  const uint32x4_t zero = vdupq_n_u32(0);
+  const uint32x4_t one = vdupq_n_u32(1);
+  uint32x4_t scores = vdupq_n_u32(input.q_len);
+  uint32x4_t vp = vdupq_n_u32(~0U);
+  uint32x4_t vn = zero;
+  uint32x4_t hi_bit = vdupq_n_u32(uint32_t(1) << (input.q_len - 1));
+  uint32x4_t d_lens = vld1q_u32(input.d_lens);
+  int max_d_len = *std::max_element(input.d_lens, input.d_lens + 4);
+  uint32x4_t text = zero;
+
+  for (int i = 0; i < max_d_len; i++) {
+    if ((i & 15) == 0) {
+      text = uint32x4_t{load_bases_32(input.d_seqs[0], input.d_lens[0], i),
+                        load_bases_32(input.d_seqs[1], input.d_lens[1], i),
+                        load_bases_32(input.d_seqs[2], input.d_lens[2], i),
+                        load_bases_32(input.d_seqs[3], input.d_lens[3], i)};
+    }
+    uint32x4_t lo = vsubq_u32(zero, vandq_u32(text, one));
+    uint32x4_t hi = vsubq_u32(zero, vandq_u32(vshrq_n_u32(text, 1), one));
+    uint32x4_t eq =
+        vbslq_u32(hi, vbslq_u32(lo, p3, p2), vbslq_u32(lo, p1, p0));
+    text = vshrq_n_u32(text, 2);
+
+    uint32x4_t x = vorrq_u32(eq, vn);
+    uint32x4_t d0 =
+        vorrq_u32(veorq_u32(vaddq_u32(vandq_u32(vp, x), vp), vp), x);
+    uint32x4_t hn = vandq_u32(vp, d0);
+    uint32x4_t hp = vorrq_u32(vn, vmvnq_u32(vorrq_u32(vp, d0)));
+    uint32x4_t y = vorrq_u32(vshlq_n_u32(hp, 1), one);
+    vn = vandq_u32(y, d0);
+    vp = vorrq_u32(vshlq_n_u32(hn, 1), vmvnq_u32(vorrq_u32(y, d0)));
+
+    uint32x4_t active = vcltq_u32(vdupq_n_u32(i), d_lens);
+    scores = vsubq_u32(scores, vandq_u32(active, vtstq_u32(hp, hi_bit)));
+    scores = vaddq_u32(scores, vandq_u32(active, vtstq_u32(hn, hi_bit)));
+  }
+
+  std::array<uint32_t, 4> out;
+  vst1q_u32(out.data(), scores);
+  return out;
+}
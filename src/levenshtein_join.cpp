@@ -0,0 +1,197 @@
+#include "levenshtein_join.hpp"
+#include "levenshtein_batch.hpp"
+#include <mutex>
+
+// Pairs buffered per worker before they are handed to the callback
+#define JOIN_FLUSH 4096
+
+// Left strings per task
+#define JOIN_CHUNK 256
+
+static uint64_t segment_hash(const char *s, int len) {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (int i = 0; i < len; i++) {
+    h ^= (uint8_t)s[i];
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
+// Even partition of a length-l string into k + 1 segments: the first ones
+// are floor(l / (k + 1)) long, the last l % (k + 1) are one longer
+static void segment(int len, uint32_t max_dist, int idx, int *start,
+                    int *seg_len) {
+  int parts = max_dist + 1;
+  int shorter = parts - len % parts;
+  int base = len / parts;
+  *seg_len = base + (idx >= shorter);
+  *start = idx * base + std::max(0, idx - shorter);
+}
+
+struct SegmentEntry {
+  uint64_t hash;
+  uint32_t id; // Position in the sorted right set
+  bool operator<(const SegmentEntry &o) const {
+    return hash < o.hash || (hash == o.hash && id < o.id);
+  }
+};
+
+// Inverted index over the segments of one right-side length
+struct LengthIndex {
+  uint32_t first, count; // Range in the sorted right set
+  std::vector<std::vector<SegmentEntry>> segments; // Per segment index
+};
+
+void levenshtein_join(const std::vector<std::string> &left,
+                      const std::vector<std::string> &right,
+                      uint32_t max_dist, const MyersJoinCallback &emit,
+                      int n_threads, MyersJoinStats *stats) {
+  if (left.empty() || right.empty())
+    return;
+
+  MyersSortedStrings sorted;
+  levenshtein_sort_strings(right, sorted);
+  int max_len = sorted.lens.back();
+
+  // Strings shorter than max_dist + 1 have empty segments, which match
+  // anything: every string of such a length is a candidate
+  std::vector<LengthIndex> index(max_len + 1);
+  for (uint32_t i = 0; i < sorted.ids.size();) {
+    int len = sorted.lens[i];
+    uint32_t j = i;
+    while (j < sorted.ids.size() && sorted.lens[j] == len)
+      j++;
+    LengthIndex &li = index[len];
+    li.first = i;
+    li.count = j - i;
+    if ((uint32_t)len > max_dist) {
+      li.segments.resize(max_dist + 1);
+      for (uint32_t s = 0; s <= max_dist; s++) {
+        int start, seg_len;
+        segment(len, max_dist, s, &start, &seg_len);
+        auto &entries = li.segments[s];
+        entries.reserve(li.count);
+        for (uint32_t id = i; id < j; id++)
+          entries.push_back(
+              {segment_hash(sorted.wrds[id] + start, seg_len), id});
+        std::sort(entries.begin(), entries.end());
+      }
+    }
+    i = j;
+  }
+
+  std::mutex emit_mutex;
+  std::atomic<uint64_t> total_candidates{0}, total_pairs{0};
+  size_t n_tasks = (left.size() + JOIN_CHUNK - 1) / JOIN_CHUNK;
+
+  levenshtein_parallel_for(n_tasks, n_threads, [&](size_t task) {
+    std::vector<MyersJoinPair> pairs;
+    std::vector<uint32_t> candidates;
+    std::vector<const char *> wrds;
+    std::vector<int> lens;
+    std::vector<uint32_t> distances;
+    uint64_t n_candidates = 0, n_pairs = 0;
+
+    auto flush = [&]() {
+      std::lock_guard<std::mutex> lock(emit_mutex);
+      emit(pairs.data(), pairs.size());
+      pairs.clear();
+    };
+
+    size_t end = std::min(left.size(), (task + 1) * JOIN_CHUNK);
+    for (size_t a = task * JOIN_CHUNK; a < end; a++) {
+      const char *q_wrd = left[a].c_str();
+      int q_wrd_len = left[a].size();
+
+      int lo = std::max<int64_t>(0, (int64_t)q_wrd_len - max_dist);
+      int hi = std::min<int64_t>(max_len, (int64_t)q_wrd_len + max_dist);
+      for (int len = lo; len <= hi; len++) {
+        const LengthIndex &li = index[len];
+        if (li.count == 0)
+          continue;
+
+        candidates.clear();
+        if (li.segments.empty()) {
+          for (uint32_t id = li.first; id < li.first + li.count; id++)
+            candidates.push_back(id);
+        } else {
+          // Multi-match-aware substring selection: segment s can only
+          // match at a start within s of its own and within max_dist - s
+          // of where the length difference puts it
+          int delta = q_wrd_len - len;
+          for (int s = 0; s <= (int)max_dist; s++) {
+            int start, seg_len;
+            segment(len, max_dist, s, &start, &seg_len);
+            int first = std::max({0, start - s,
+                                  start + delta - ((int)max_dist - s)});
+            int last = std::min({q_wrd_len - seg_len, start + s,
+                                 start + delta + ((int)max_dist - s)});
+            const auto &entries = li.segments[s];
+            for (int p = first; p <= last; p++) {
+              uint64_t h = segment_hash(q_wrd + p, seg_len);
+              auto it = std::lower_bound(entries.begin(), entries.end(),
+                                         SegmentEntry{h, 0});
+              for (; it != entries.end() && it->hash == h; ++it)
+                candidates.push_back(it->id);
+            }
+          }
+          // A string sharing several segments is verified once
+          std::sort(candidates.begin(), candidates.end());
+          candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                           candidates.end());
+        }
+        if (candidates.empty())
+          continue;
+        n_candidates += candidates.size();
+
+        wrds.resize(candidates.size());
+        lens.resize(candidates.size());
+        distances.resize(candidates.size());
+        for (size_t c = 0; c < candidates.size(); c++) {
+          wrds[c] = sorted.wrds[candidates[c]];
+          lens[c] = len;
+        }
+        levenshtein_batch_bounded(levenshtein_batch_width(q_wrd_len, len),
+                                  q_wrd, q_wrd_len, wrds.data(), lens.data(),
+                                  candidates.size(), max_dist,
+                                  distances.data());
+
+        for (size_t c = 0; c < candidates.size(); c++) {
+          if (distances[c] <= max_dist) {
+            pairs.push_back({(uint32_t)a, sorted.ids[candidates[c]],
+                             distances[c]});
+            n_pairs++;
+            if (pairs.size() == JOIN_FLUSH)
+              flush();
+          }
+        }
+      }
+    }
+    if (!pairs.empty())
+      flush();
+    total_candidates += n_candidates;
+    total_pairs += n_pairs;
+  });
+
+  if (stats) {
+    stats->candidates += total_candidates;
+    stats->pairs += total_pairs;
+  }
+}
+
+size_t levenshtein_join(const std::vector<std::string> &left,
+                        const std::vector<std::string> &right,
+                        uint32_t max_dist, MyersJoinPair *out,
+                        size_t capacity, int n_threads) {
+  size_t total = 0;
+  levenshtein_join(
+      left, right, max_dist,
+      [&](const MyersJoinPair *pairs, size_t n) {
+        for (size_t i = 0; i < n; i++, total++) {
+          if (total < capacity)
+            out[total] = pairs[i];
+        }
+      },
+      n_threads, nullptr);
+  return total;
+}
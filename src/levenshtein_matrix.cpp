@@ -0,0 +1,110 @@
+#include "levenshtein_matrix.hpp"
+#include "levenshtein_batch.hpp"
+#include <algorithm>
+#include <limits>
+
+template <typename T> static inline T saturate(uint32_t d) {
+  return std::min<uint32_t>(d, std::numeric_limits<T>::max());
+}
+
+template <typename T>
+static void matrix_condensed(const std::vector<std::string> &strs, T *out,
+                             int n_threads) {
+  size_t n = strs.size();
+  if (n < 2)
+    return;
+  MyersSortedStrings sorted;
+  levenshtein_sort_strings(strs, sorted);
+
+  // Tiles on and above the diagonal
+  size_t n_blocks = (n + MYERS_MATRIX_TILE - 1) / MYERS_MATRIX_TILE;
+  std::vector<std::pair<uint32_t, uint32_t>> tiles;
+  for (uint32_t bi = 0; bi < n_blocks; bi++)
+    for (uint32_t bj = bi; bj < n_blocks; bj++)
+      tiles.push_back({bi, bj});
+
+  levenshtein_parallel_for(tiles.size(), n_threads, [&](size_t t) {
+    uint32_t distances[MYERS_MATRIX_TILE];
+    size_t i_begin = size_t(tiles[t].first) * MYERS_MATRIX_TILE;
+    size_t i_end = std::min(n, i_begin + MYERS_MATRIX_TILE);
+    size_t j_begin = size_t(tiles[t].second) * MYERS_MATRIX_TILE;
+    size_t j_end = std::min(n, j_begin + MYERS_MATRIX_TILE);
+
+    for (size_t i = i_begin; i < i_end; i++) {
+      // Sorted by length, so the query is never the longer string
+      size_t j0 = std::max(j_begin, i + 1);
+      if (j0 >= j_end)
+        continue;
+      int width = levenshtein_batch_width(sorted.lens[i],
+                                          sorted.lens[j_end - 1]);
+      levenshtein_batch(width, sorted.wrds[i], sorted.lens[i],
+                        &sorted.wrds[j0], &sorted.lens[j0], j_end - j0,
+                        distances);
+
+      uint32_t a = sorted.ids[i];
+      for (size_t j = j0; j < j_end; j++) {
+        uint32_t b = sorted.ids[j];
+        size_t idx = a < b ? levenshtein_condensed_index(n, a, b)
+                           : levenshtein_condensed_index(n, b, a);
+        out[idx] = saturate<T>(distances[j - j0]);
+      }
+    }
+  });
+}
+
+template <typename T>
+static void matrix(const std::vector<std::string> &queries,
+                   const std::vector<std::string> &targets, T *out,
+                   int n_threads) {
+  size_t n = queries.size(), m = targets.size();
+  if (n == 0 || m == 0)
+    return;
+  MyersSortedStrings sorted_q, sorted_t;
+  levenshtein_sort_strings(queries, sorted_q);
+  levenshtein_sort_strings(targets, sorted_t);
+
+  size_t q_blocks = (n + MYERS_MATRIX_TILE - 1) / MYERS_MATRIX_TILE;
+  size_t t_blocks = (m + MYERS_MATRIX_TILE - 1) / MYERS_MATRIX_TILE;
+
+  levenshtein_parallel_for(q_blocks * t_blocks, n_threads, [&](size_t t) {
+    uint32_t distances[MYERS_MATRIX_TILE];
+    size_t i_begin = (t / t_blocks) * MYERS_MATRIX_TILE;
+    size_t i_end = std::min(n, i_begin + MYERS_MATRIX_TILE);
+    size_t j_begin = (t % t_blocks) * MYERS_MATRIX_TILE;
+    size_t j_end = std::min(m, j_begin + MYERS_MATRIX_TILE);
+
+    for (size_t i = i_begin; i < i_end; i++) {
+      int width = levenshtein_batch_width(sorted_q.lens[i],
+                                          sorted_t.lens[j_end - 1]);
+      levenshtein_batch(width, sorted_q.wrds[i], sorted_q.lens[i],
+                        &sorted_t.wrds[j_begin], &sorted_t.lens[j_begin],
+                        j_end - j_begin, distances);
+
+      T *row = out + size_t(sorted_q.ids[i]) * m;
+      for (size_t j = j_begin; j < j_end; j++)
+        row[sorted_t.ids[j]] = saturate<T>(distances[j - j_begin]);
+    }
+  });
+}
+
+void levenshtein_matrix_condensed(const std::vector<std::string> &strs,
+                                  uint8_t *out, int n_threads) {
+  matrix_condensed(strs, out, n_threads);
+}
+
+void levenshtein_matrix_condensed(const std::vector<std::string> &strs,
+                                  uint16_t *out, int n_threads) {
+  matrix_condensed(strs, out, n_threads);
+}
+
+void levenshtein_matrix(const std::vector<std::string> &queries,
+                        const std::vector<std::string> &targets, uint8_t *out,
+                        int n_threads) {
+  matrix(queries, targets, out, n_threads);
+}
+
+void levenshtein_matrix(const std::vector<std::string> &queries,
+                        const std::vector<std::string> &targets, uint16_t *out,
+                        int n_threads) {
+  matrix(queries, targets, out, n_threads);
+}
@@ -0,0 +1,167 @@
+#include "levenshtein_minhash.hpp"
+#include <algorithm>
+#include <cmath>
+
+static bool fail(std::string *error, const char *msg) {
+  if (error)
+    *error = msg;
+  return false;
+}
+
+static uint64_t mix64(uint64_t h) {
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+  return h;
+}
+
+// FNV-1a of one shingle, finalized so that the multiply-add hash functions
+// below see well-mixed inputs
+static uint64_t shingle_hash(const char *s, int len) {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (int i = 0; i < len; i++) {
+    h ^= (uint8_t)s[i];
+    h *= 0x100000001b3ULL;
+  }
+  return mix64(h);
+}
+
+// Band keys of one string, `bands` entries. Strings shorter than a shingle
+// are a single shingle; the empty string has an empty set and an all-ones
+// signature.
+static void band_keys(const MyersMinHashIndex &index, const char *s, int len,
+                      std::vector<uint64_t> &sig, std::vector<uint64_t> &keys) {
+  const MyersMinHashParams &p = index.params;
+  size_t n_hashes = size_t(p.bands) * p.rows;
+  sig.assign(n_hashes, ~0ULL);
+
+  int w = std::min(p.shingle, len);
+  for (int i = 0; w > 0 && i + w <= len; i++) {
+    uint64_t x = shingle_hash(s + i, w);
+    for (size_t h = 0; h < n_hashes; h++)
+      sig[h] = std::min(sig[h], index.mul[h] * x + index.add[h]);
+  }
+
+  keys.resize(p.bands);
+  for (int b = 0; b < p.bands; b++) {
+    uint64_t key = 0x9e3779b97f4a7c15ULL * (b + 1);
+    for (int r = 0; r < p.rows; r++)
+      key = mix64(key ^ sig[size_t(b) * p.rows + r]);
+    keys[b] = key;
+  }
+}
+
+double levenshtein_minhash_probability(double jaccard, int bands, int rows) {
+  return 1.0 - std::pow(1.0 - std::pow(jaccard, rows), bands);
+}
+
+bool levenshtein_minhash_build(const std::vector<std::string> &strs,
+                               const MyersMinHashParams &params,
+                               MyersMinHashIndex &index, std::string *error) {
+  if (params.shingle < 1 || params.shingle > MYERS_MINHASH_MAX_SHINGLE)
+    return fail(error, "shingle out of range");
+  if (params.bands < 1 || params.rows < 1 ||
+      params.bands * params.rows > MYERS_MINHASH_MAX_HASHES)
+    return fail(error, "bands * rows out of range");
+  if (strs.size() >= UINT32_MAX)
+    return fail(error, "too many strings");
+
+  index.params = params;
+  index.n_strs = strs.size();
+
+  index.offsets.resize(strs.size() + 1);
+  index.offsets[0] = 0;
+  for (size_t i = 0; i < strs.size(); i++)
+    index.offsets[i + 1] = index.offsets[i] + strs[i].size();
+  index.data.resize(index.offsets.back());
+  for (size_t i = 0; i < strs.size(); i++)
+    std::copy(strs[i].begin(), strs[i].end(),
+              index.data.begin() + index.offsets[i]);
+
+  // Hash functions h(x) = mul * x + add over 2^64, seeded by splitmix64
+  size_t n_hashes = size_t(params.bands) * params.rows;
+  index.mul.resize(n_hashes);
+  index.add.resize(n_hashes);
+  uint64_t state = params.seed;
+  for (size_t h = 0; h < n_hashes; h++) {
+    index.mul[h] = mix64(state += 0x9e3779b97f4a7c15ULL) | 1;
+    index.add[h] = mix64(state += 0x9e3779b97f4a7c15ULL);
+  }
+
+  size_t n = strs.size();
+  index.buckets.resize(n * params.bands);
+  std::vector<uint64_t> sig, keys;
+  for (size_t i = 0; i < n; i++) {
+    band_keys(index, strs[i].data(), strs[i].size(), sig, keys);
+    for (int b = 0; b < params.bands; b++)
+      index.buckets[b * n + i] = {keys[b], (uint32_t)i};
+  }
+  for (int b = 0; b < params.bands; b++) {
+    std::sort(index.buckets.begin() + b * n, index.buckets.begin() + (b + 1) * n,
+              [](const MyersMinHashEntry &x, const MyersMinHashEntry &y) {
+                return x.key < y.key || (x.key == y.key && x.id < y.id);
+              });
+  }
+  return true;
+}
+
+size_t levenshtein_minhash_memory(const MyersMinHashIndex &index) {
+  return index.data.capacity() +
+         index.offsets.capacity() * sizeof(uint64_t) +
+         (index.mul.capacity() + index.add.capacity()) * sizeof(uint64_t) +
+         index.buckets.capacity() * sizeof(MyersMinHashEntry);
+}
+
+void levenshtein_minhash_search(const MyersMinHashIndex &index,
+                                const char *q_wrd, int q_wrd_len,
+                                uint32_t max_dist,
+                                std::vector<MyersScanMatch> &matches,
+                                MyersMinHashStats *stats) {
+  MyersMinHashStats local = {};
+  thread_local std::vector<uint64_t> sig, keys;
+  thread_local std::vector<uint32_t> candidates;
+
+  band_keys(index, q_wrd, q_wrd_len, sig, keys);
+
+  size_t n = index.n_strs;
+  candidates.clear();
+  for (int b = 0; b < index.params.bands; b++) {
+    auto first = index.buckets.begin() + b * n;
+    auto last = first + n;
+    auto it = std::lower_bound(first, last, keys[b],
+                               [](const MyersMinHashEntry &e, uint64_t key) {
+                                 return e.key < key;
+                               });
+    for (; it != last && it->key == keys[b]; ++it)
+      candidates.push_back(it->id);
+  }
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                   candidates.end());
+  local.candidates = candidates.size();
+
+  for (uint32_t id : candidates) {
+    const char *d_wrd = index.data.data() + index.offsets[id];
+    int d_wrd_len = index.offsets[id + 1] - index.offsets[id];
+    uint32_t len_diff = q_wrd_len > d_wrd_len ? q_wrd_len - d_wrd_len
+                                              : d_wrd_len - q_wrd_len;
+    if (len_diff > max_dist)
+      continue;
+
+    local.verified++;
+    uint32_t d = levenshtein_myers_anyx1_bounded(q_wrd, q_wrd_len, d_wrd,
+                                                 d_wrd_len, max_dist);
+    if (d <= max_dist) {
+      matches.push_back({id, d});
+      local.matches++;
+    }
+  }
+
+  if (stats) {
+    stats->candidates += local.candidates;
+    stats->verified += local.verified;
+    stats->matches += local.matches;
+  }
+}
@@ -1,4 +1,5 @@
 #include "levenshtein_myers.hpp"
+#include <algorithm>
 #include <arm_neon.h>
 
 static const uint16x8_t NULL_V_16 = vdupq_n_u16(0);
@@ -68,3 +69,222 @@ std::array<uint16_t, 8> levenshtein_myers_16x8(const Myers16x8Input &input) {
   vst1q_u16(out.data(), scores);
   return out;
 }
+
+std::array<uint16_t, 8>
+levenshtein_myers_16x8_block(const MyersBlockInput &input) {
+  std::array<uint16_t, 8> out;
+  if (input.q_wrd_len == 0) {
+    out.fill(input.d_wrd_len);
+    return out;
+  }
+
+  uint16_t bm[ALPHABET_LEN + 1] = {0}; // Last entry is the pad symbol
+
+  const char *q_wrd = input.q_wrd;
+  uint16_t q_wrd_len = input.q_wrd_len;
+  uint16x8_t scores = vdupq_n_u16(q_wrd_len);
+
+  uint16x8_t vp = vdupq_n_u16(0xFFFF);
+  uint16x8_t vn = vdupq_n_u16(0);
+  uint16x8_t x, y, hn, hp, d0;
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= 1 << i;
+  }
+
+  uint16x8_t q_wrd_len_ls = vshlq_u16(ONE_V_16, vdupq_n_u16(q_wrd_len - 1));
+
+  for (int i = 0; i < input.d_wrd_len; i++) {
+    const uint8_t *syms = input.d_syms + i * MYERS_BLOCK_LANES;
+    uint16x8_t c_bm = {bm[syms[0]], bm[syms[1]], bm[syms[2]], bm[syms[3]],
+                       bm[syms[4]], bm[syms[5]], bm[syms[6]], bm[syms[7]]};
+
+    x = vorrq_u16(c_bm, vn);
+    d0 = vorrq_u16(veorq_u16(vaddq_u16(vandq_u16(vp, x), vp), vp), x);
+    hn = vandq_u16(vp, d0);
+    hp = vorrq_u16(vn, vmvnq_u16(vorrq_u16(vp, d0)));
+    y = vorrq_u16(vshlq_n_u16(hp, 1), ONE_V_16);
+    vn = vandq_u16(y, d0);
+    vp = vorrq_u16(vshlq_n_u16(hn, 1), vmvnq_u16(vorrq_u16(y, d0)));
+
+    // All lanes share d_wrd_len, so no per-lane length mask is needed
+    scores = vsubq_u16(scores, vtstq_u16(hp, q_wrd_len_ls));
+    scores = vaddq_u16(scores, vtstq_u16(hn, q_wrd_len_ls));
+  }
+
+  vst1q_u16(out.data(), scores);
+  return out;
+}
+
+std::array<uint16_t, 8>
+levenshtein_myers_16x8_prefix(const Myers16x8Input &input,
+                              uint16_t max_dist) {
+  // The empty prefix is m edits away, so no larger bound is needed. Scores
+  // above max_dist are reported as max_dist + 1
+  if (max_dist > input.q_wrd_len)
+    max_dist = input.q_wrd_len;
+  uint16x8_t cap = vdupq_n_u16(max_dist + 1);
+  uint16x8_t min_scores = vminq_u16(vdupq_n_u16(input.q_wrd_len), cap);
+  if (input.q_wrd_len == 0) {
+    std::array<uint16_t, 8> out;
+    vst1q_u16(out.data(), min_scores);
+    return out;
+  }
+
+  uint16_t bm[ALPHABET_LEN] = {0}; // Bitmap for each letter in the alphabet
+
+  const char *q_wrd = input.q_wrd;
+  uint16_t q_wrd_len = input.q_wrd_len;
+  uint16x8_t scores = vdupq_n_u16(q_wrd_len);
+
+  uint16x8_t vp = vdupq_n_u16(0xFFFF);
+  uint16x8_t vn = vdupq_n_u16(0);
+  uint16x8_t x, y, hn, hp, d0;
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= 1 << i;
+  }
+
+  uint16x8_t d_wrd_lens = vld1q_u16(input.d_wrd_lens);
+
+  uint16x8_t q_wrd_len_ls = vshlq_u16(ONE_V_16, vdupq_n_u16(q_wrd_len - 1));
+
+  // Past column m + max_dist every score is at least j - m > max_dist
+  int max_d_wrd_len =
+      std::min<int>(std::ranges::max(input.d_wrd_lens), q_wrd_len + max_dist);
+
+  // A lane stays active while a later column may still lower its minimum:
+  // the score drops by at most one per remaining column
+  uint16x8_t active = vcltq_u16(NULL_V_16, min_scores);
+
+  for (int i = 0; i < max_d_wrd_len; i++) {
+    uint16_t c_bm_0 = bm[input.d_wrds[0][i] - 'a'];
+    uint16_t c_bm_1 = bm[input.d_wrds[1][i] - 'a'];
+    uint16_t c_bm_2 = bm[input.d_wrds[2][i] - 'a'];
+    uint16_t c_bm_3 = bm[input.d_wrds[3][i] - 'a'];
+    uint16_t c_bm_4 = bm[input.d_wrds[4][i] - 'a'];
+    uint16_t c_bm_5 = bm[input.d_wrds[5][i] - 'a'];
+    uint16_t c_bm_6 = bm[input.d_wrds[6][i] - 'a'];
+    uint16_t c_bm_7 = bm[input.d_wrds[7][i] - 'a'];
+    uint16x8_t c_bm = {c_bm_0, c_bm_1, c_bm_2, c_bm_3,
+                       c_bm_4, c_bm_5, c_bm_6, c_bm_7};
+
+    x = vorrq_u16(c_bm, vn);
+    d0 = vorrq_u16(veorq_u16(vaddq_u16(vandq_u16(vp, x), vp), vp), x);
+    hn = vandq_u16(vp, d0);
+    hp = vorrq_u16(vn, vmvnq_u16(vorrq_u16(vp, d0)));
+    y = vorrq_u16(vshlq_n_u16(hp, 1), ONE_V_16);
+    vn = vandq_u16(y, d0);
+    vp = vorrq_u16(vshlq_n_u16(hn, 1), vmvnq_u16(vorrq_u16(y, d0)));
+
+    uint16x8_t i_v = vdupq_n_u16(i);
+    active = vandq_u16(active, vcltq_u16(i_v, d_wrd_lens));
+    scores = vsubq_u16(scores, vandq_u16(active, vtstq_u16(hp, q_wrd_len_ls)));
+    scores = vaddq_u16(scores, vandq_u16(active, vtstq_u16(hn, q_wrd_len_ls)));
+    min_scores = vminq_u16(min_scores, scores);
+
+    uint16x8_t remaining = vsubq_u16(d_wrd_lens, vaddq_u16(i_v, ONE_V_16));
+    active = vandq_u16(
+        active, vcltq_u16(scores, vqaddq_u16(min_scores, remaining)));
+    if (vmaxvq_u16(active) == 0)
+      break;
+  }
+
+  std::array<uint16_t, 8> out;
+  vst1q_u16(out.data(), min_scores);
+  return out;
+}
+
+std::array<uint16_t, 8>
+levenshtein_myers_16x8_bounded(const Myers16x8Input &input,
+                               uint16_t max_dist) {
+  // Scores above max_dist are reported as max_dist + 1
+  if (max_dist == UINT16_MAX)
+    max_dist = UINT16_MAX - 1;
+  uint16x8_t cap = vdupq_n_u16(max_dist + 1);
+  uint16x8_t d_wrd_lens = vld1q_u16(input.d_wrd_lens);
+  if (input.q_wrd_len == 0) {
+    std::array<uint16_t, 8> out;
+    vst1q_u16(out.data(), vminq_u16(d_wrd_lens, cap));
+    return out;
+  }
+
+  uint16_t bm[ALPHABET_LEN] = {0}; // Bitmap for each letter in the alphabet
+
+  const char *q_wrd = input.q_wrd;
+  uint16_t q_wrd_len = input.q_wrd_len;
+  uint16x8_t scores = vdupq_n_u16(q_wrd_len);
+
+  uint16x8_t vp = vdupq_n_u16(0xFFFF);
+  uint16x8_t vn = vdupq_n_u16(0);
+  uint16x8_t x, y, hn, hp, d0;
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= 1 << i;
+  }
+
+  uint16x8_t q_wrd_len_ls = vshlq_u16(ONE_V_16, vdupq_n_u16(q_wrd_len - 1));
+  uint16x8_t q_wrd_len_v = vdupq_n_u16(q_wrd_len);
+
+  // The length difference alone may already exceed the bound
+  uint16x8_t len_diff = vabdq_u16(d_wrd_lens, q_wrd_len_v);
+  uint16x8_t alive = vcleq_u16(len_diff, vdupq_n_u16(max_dist));
+
+  int max_d_wrd_len = std::ranges::max(input.d_wrd_lens);
+
+  for (int i = 0; i < max_d_wrd_len; i++) {
+    uint16x8_t step = vandq_u16(alive, vcltq_u16(vdupq_n_u16(i), d_wrd_lens));
+    if (vmaxvq_u16(step) == 0)
+      break;
+
+    uint16_t c_bm_0 = bm[input.d_wrds[0][i] - 'a'];
+    uint16_t c_bm_1 = bm[input.d_wrds[1][i] - 'a'];
+    uint16_t c_bm_2 = bm[input.d_wrds[2][i] - 'a'];
+    uint16_t c_bm_3 = bm[input.d_wrds[3][i] - 'a'];
+    uint16_t c_bm_4 = bm[input.d_wrds[4][i] - 'a'];
+    uint16_t c_bm_5 = bm[input.d_wrds[5][i] - 'a'];
+    uint16_t c_bm_6 = bm[input.d_wrds[6][i] - 'a'];
+    uint16_t c_bm_7 = bm[input.d_wrds[7][i] - 'a'];
+    uint16x8_t c_bm = {c_bm_0, c_bm_1, c_bm_2, c_bm_3,
+                       c_bm_4, c_bm_5, c_bm_6, c_bm_7};
+
+    x = vorrq_u16(c_bm, vn);
+    d0 = vorrq_u16(veorq_u16(vaddq_u16(vandq_u16(vp, x), vp), vp), x);
+    hn = vandq_u16(vp, d0);
+    hp = vorrq_u16(vn, vmvnq_u16(vorrq_u16(vp, d0)));
+    y = vorrq_u16(vshlq_n_u16(hp, 1), ONE_V_16);
+    vn = vandq_u16(y, d0);
+    vp = vorrq_u16(vshlq_n_u16(hn, 1), vmvnq_u16(vorrq_u16(y, d0)));
+
+    uint16x8_t j_v = vdupq_n_u16(i + 1);
+    scores = vsubq_u16(scores, vandq_u16(step, vtstq_u16(hp, q_wrd_len_ls)));
+    scores = vaddq_u16(scores, vandq_u16(step, vtstq_u16(hn, q_wrd_len_ls)));
+
+    // Scores never decrease along a diagonal, so the cell of this column on
+    // the diagonal ending in D[m][n] bounds the final score from below.
+    // Its row is j + m - n, read off vp / vn with a popcount.
+    uint16x8_t on_diag =
+        vcleq_u16(d_wrd_lens, vqaddq_u16(j_v, q_wrd_len_v));
+    uint16x8_t row = vsubq_u16(vaddq_u16(j_v, q_wrd_len_v), d_wrd_lens);
+    uint16x8_t row_mask =
+        vsubq_u16(vshlq_u16(ONE_V_16, vreinterpretq_s16_u16(row)), ONE_V_16);
+    uint16x8_t pos = vpaddlq_u8(
+        vcntq_u8(vreinterpretq_u8_u16(vandq_u16(vp, row_mask))));
+    uint16x8_t neg = vpaddlq_u8(
+        vcntq_u8(vreinterpretq_u8_u16(vandq_u16(vn, row_mask))));
+    uint16x8_t diag = vsubq_u16(vaddq_u16(j_v, pos), neg);
+
+    uint16x8_t exceeded =
+        vandq_u16(vandq_u16(step, on_diag), vcgeq_u16(diag, cap));
+    alive = vandq_u16(alive, vmvnq_u16(exceeded));
+  }
+
+  // Lanes that stopped early are over the bound
+  scores = vbslq_u16(alive, scores, cap);
+  std::array<uint16_t, 8> out;
+  vst1q_u16(out.data(), vminq_u16(scores, cap));
+  return out;
+}
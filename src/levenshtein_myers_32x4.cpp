@@ -1,4 +1,5 @@
 #include "levenshtein_myers.hpp"
+#include <algorithm>
 #include <arm_neon.h>
 
 static const uint32x4_t NULL_V = vdupq_n_u32(0);
@@ -63,3 +64,211 @@ std::array<uint32_t, 4> levenshtein_myers_32x4(const Myers32x4Input &input) {
   vst1q_u32(out.data(), scores);
   return out;
 }
+
+std::array<uint32_t, 4>
+levenshtein_myers_32x4_block(const MyersBlockInput &input) {
+  std::array<uint32_t, 4> out;
+  if (input.q_wrd_len == 0) {
+    out.fill(input.d_wrd_len);
+    return out;
+  }
+
+  uint32_t bm[ALPHABET_LEN + 1] = {0}; // Last entry is the pad symbol
+
+  const char *q_wrd = input.q_wrd;
+  uint32_t q_wrd_len = input.q_wrd_len;
+  uint32x4_t scores = vdupq_n_u32(q_wrd_len);
+
+  uint32x4_t vp = vdupq_n_u32(0xFFFFFFFF);
+  uint32x4_t vn = vdupq_n_u32(0);
+  uint32x4_t x, y, hn, hp, d0;
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= 1 << i;
+  }
+
+  uint32x4_t q_wrd_len_ls = vshlq_u32(ONE_V, vdupq_n_u32(q_wrd_len - 1));
+
+  for (int i = 0; i < input.d_wrd_len; i++) {
+    const uint8_t *syms = input.d_syms + i * MYERS_BLOCK_LANES;
+    uint32x4_t c_bm = {bm[syms[0]], bm[syms[1]], bm[syms[2]], bm[syms[3]]};
+
+    x = vorrq_u32(c_bm, vn);
+    d0 = vorrq_u32(veorq_u32(vaddq_u32(vandq_u32(vp, x), vp), vp), x);
+    hn = vandq_u32(vp, d0);
+    hp = vorrq_u32(vn, vmvnq_u32(vorrq_u32(vp, d0)));
+    y = vorrq_u32(vshlq_n_u32(hp, 1), ONE_V);
+    vn = vandq_u32(y, d0);
+    vp = vorrq_u32(vshlq_n_u32(hn, 1), vmvnq_u32(vorrq_u32(y, d0)));
+
+    // All lanes share d_wrd_len, so no per-lane length mask is needed
+    scores = vsubq_u32(scores, vtstq_u32(hp, q_wrd_len_ls));
+    scores = vaddq_u32(scores, vtstq_u32(hn, q_wrd_len_ls));
+  }
+
+  vst1q_u32(out.data(), scores);
+  return out;
+}
+
+std::array<uint32_t, 4>
+levenshtein_myers_32x4_prefix(const Myers32x4Input &input,
+                              uint32_t max_dist) {
+  // The empty prefix is m edits away, so no larger bound is needed. Scores
+  // above max_dist are reported as max_dist + 1
+  if (max_dist > input.q_wrd_len)
+    max_dist = input.q_wrd_len;
+  uint32x4_t cap = vdupq_n_u32(max_dist + 1);
+  uint32x4_t min_scores = vminq_u32(vdupq_n_u32(input.q_wrd_len), cap);
+  if (input.q_wrd_len == 0) {
+    std::array<uint32_t, 4> out;
+    vst1q_u32(out.data(), min_scores);
+    return out;
+  }
+
+  uint32_t bm[ALPHABET_LEN] = {0}; // Bitmap for each letter in the alphabet
+
+  const char *q_wrd = input.q_wrd;
+  uint32_t q_wrd_len = input.q_wrd_len;
+  uint32x4_t scores = vdupq_n_u32(q_wrd_len);
+
+  uint32x4_t vp = vdupq_n_u32(0xFFFFFFFF);
+  uint32x4_t vn = vdupq_n_u32(0);
+  uint32x4_t x, y, hn, hp, d0;
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= 1 << i;
+  }
+
+  uint32x4_t d_wrd_lens = vld1q_u32(input.d_wrd_lens);
+
+  uint32x4_t q_wrd_len_ls = vshlq_u32(ONE_V, vdupq_n_u32(q_wrd_len - 1));
+
+  // Past column m + max_dist every score is at least j - m > max_dist
+  int max_d_wrd_len =
+      std::min<int>(std::ranges::max(input.d_wrd_lens), q_wrd_len + max_dist);
+
+  // A lane stays active while a later column may still lower its minimum:
+  // the score drops by at most one per remaining column
+  uint32x4_t active = vcltq_u32(NULL_V, min_scores);
+
+  for (int i = 0; i < max_d_wrd_len; i++) {
+    uint32_t c_bm_0 = bm[input.d_wrds[0][i] - 'a'];
+    uint32_t c_bm_1 = bm[input.d_wrds[1][i] - 'a'];
+    uint32_t c_bm_2 = bm[input.d_wrds[2][i] - 'a'];
+    uint32_t c_bm_3 = bm[input.d_wrds[3][i] - 'a'];
+    uint32x4_t c_bm = {c_bm_0, c_bm_1, c_bm_2, c_bm_3};
+
+    x = vorrq_u32(c_bm, vn);
+    d0 = vorrq_u32(veorq_u32(vaddq_u32(vandq_u32(vp, x), vp), vp), x);
+    hn = vandq_u32(vp, d0);
+    hp = vorrq_u32(vn, vmvnq_u32(vorrq_u32(vp, d0)));
+    y = vorrq_u32(vshlq_n_u32(hp, 1), ONE_V);
+    vn = vandq_u32(y, d0);
+    vp = vorrq_u32(vshlq_n_u32(hn, 1), vmvnq_u32(vorrq_u32(y, d0)));
+
+    uint32x4_t i_v = vdupq_n_u32(i);
+    active = vandq_u32(active, vcltq_u32(i_v, d_wrd_lens));
+    scores = vsubq_u32(scores, vandq_u32(active, vtstq_u32(hp, q_wrd_len_ls)));
+    scores = vaddq_u32(scores, vandq_u32(active, vtstq_u32(hn, q_wrd_len_ls)));
+    min_scores = vminq_u32(min_scores, scores);
+
+    uint32x4_t remaining = vsubq_u32(d_wrd_lens, vaddq_u32(i_v, ONE_V));
+    active = vandq_u32(
+        active, vcltq_u32(scores, vqaddq_u32(min_scores, remaining)));
+    if (vmaxvq_u32(active) == 0)
+      break;
+  }
+
+  std::array<uint32_t, 4> out;
+  vst1q_u32(out.data(), min_scores);
+  return out;
+}
+
+std::array<uint32_t, 4>
+levenshtein_myers_32x4_bounded(const Myers32x4Input &input,
+                               uint32_t max_dist) {
+  // Scores above max_dist are reported as max_dist + 1
+  if (max_dist == UINT32_MAX)
+    max_dist = UINT32_MAX - 1;
+  uint32x4_t cap = vdupq_n_u32(max_dist + 1);
+  uint32x4_t d_wrd_lens = vld1q_u32(input.d_wrd_lens);
+  if (input.q_wrd_len == 0) {
+    std::array<uint32_t, 4> out;
+    vst1q_u32(out.data(), vminq_u32(d_wrd_lens, cap));
+    return out;
+  }
+
+  uint32_t bm[ALPHABET_LEN] = {0}; // Bitmap for each letter in the alphabet
+
+  const char *q_wrd = input.q_wrd;
+  uint32_t q_wrd_len = input.q_wrd_len;
+  uint32x4_t scores = vdupq_n_u32(q_wrd_len);
+
+  uint32x4_t vp = vdupq_n_u32(0xFFFFFFFF);
+  uint32x4_t vn = vdupq_n_u32(0);
+  uint32x4_t x, y, hn, hp, d0;
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= 1 << i;
+  }
+
+  uint32x4_t q_wrd_len_ls = vshlq_u32(ONE_V, vdupq_n_u32(q_wrd_len - 1));
+  uint32x4_t q_wrd_len_v = vdupq_n_u32(q_wrd_len);
+
+  // The length difference alone may already exceed the bound
+  uint32x4_t len_diff = vabdq_u32(d_wrd_lens, q_wrd_len_v);
+  uint32x4_t alive = vcleq_u32(len_diff, vdupq_n_u32(max_dist));
+
+  int max_d_wrd_len = std::ranges::max(input.d_wrd_lens);
+
+  for (int i = 0; i < max_d_wrd_len; i++) {
+    uint32x4_t step = vandq_u32(alive, vcltq_u32(vdupq_n_u32(i), d_wrd_lens));
+    if (vmaxvq_u32(step) == 0)
+      break;
+
+    uint32_t c_bm_0 = bm[input.d_wrds[0][i] - 'a'];
+    uint32_t c_bm_1 = bm[input.d_wrds[1][i] - 'a'];
+    uint32_t c_bm_2 = bm[input.d_wrds[2][i] - 'a'];
+    uint32_t c_bm_3 = bm[input.d_wrds[3][i] - 'a'];
+    uint32x4_t c_bm = {c_bm_0, c_bm_1, c_bm_2, c_bm_3};
+
+    x = vorrq_u32(c_bm, vn);
+    d0 = vorrq_u32(veorq_u32(vaddq_u32(vandq_u32(vp, x), vp), vp), x);
+    hn = vandq_u32(vp, d0);
+    hp = vorrq_u32(vn, vmvnq_u32(vorrq_u32(vp, d0)));
+    y = vorrq_u32(vshlq_n_u32(hp, 1), ONE_V);
+    vn = vandq_u32(y, d0);
+    vp = vorrq_u32(vshlq_n_u32(hn, 1), vmvnq_u32(vorrq_u32(y, d0)));
+
+    uint32x4_t j_v = vdupq_n_u32(i + 1);
+    scores = vsubq_u32(scores, vandq_u32(step, vtstq_u32(hp, q_wrd_len_ls)));
+    scores = vaddq_u32(scores, vandq_u32(step, vtstq_u32(hn, q_wrd_len_ls)));
+
+    // Scores never decrease along a diagonal, so the cell of this column on
+    // the diagonal ending in D[m][n] bounds the final score from below.
+    // Its row is j + m - n, read off vp / vn with a popcount.
+    uint32x4_t on_diag =
+        vcleq_u32(d_wrd_lens, vqaddq_u32(j_v, q_wrd_len_v));
+    uint32x4_t row = vsubq_u32(vaddq_u32(j_v, q_wrd_len_v), d_wrd_lens);
+    uint32x4_t row_mask =
+        vsubq_u32(vshlq_u32(ONE_V, vreinterpretq_s32_u32(row)), ONE_V);
+    uint32x4_t pos = vpaddlq_u16(
+        vpaddlq_u8(vcntq_u8(vreinterpretq_u8_u32(vandq_u32(vp, row_mask)))));
+    uint32x4_t neg = vpaddlq_u16(
+        vpaddlq_u8(vcntq_u8(vreinterpretq_u8_u32(vandq_u32(vn, row_mask)))));
+    uint32x4_t diag = vsubq_u32(vaddq_u32(j_v, pos), neg);
+
+    uint32x4_t exceeded =
+        vandq_u32(vandq_u32(step, on_diag), vcgeq_u32(diag, cap));
+    alive = vandq_u32(alive, vmvnq_u32(exceeded));
+  }
+
+  // Lanes that stopped early are over the bound
+  scores = vbslq_u32(alive, scores, cap);
+  std::array<uint32_t, 4> out;
+  vst1q_u32(out.data(), vminq_u32(scores, cap));
+  return out;
+}
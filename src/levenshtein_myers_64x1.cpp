@@ -1,4 +1,5 @@
 #include "levenshtein_myers.hpp"
+#include <algorithm>
 #include <arm_neon.h>
 
 uint32_t levenshtein_myers_64x1(const char *q_wrd, int q_wrd_len,
@@ -37,3 +38,53 @@ uint32_t levenshtein_myers_64x1(const char *q_wrd, int q_wrd_len,
 
   return score;
 }
+
+uint32_t levenshtein_myers_64x1_prefix(const char *q_wrd, int q_wrd_len,
+                                       const char *d_wrd, int d_wrd_len,
+                                       uint32_t max_dist) {
+  // The empty prefix is m edits away, so no larger bound is needed. Scores
+  // above max_dist are reported as max_dist + 1
+  max_dist = std::min<uint32_t>(max_dist, q_wrd_len);
+  uint32_t min_score = std::min<uint32_t>(q_wrd_len, max_dist + 1);
+  if (q_wrd_len == 0)
+    return 0;
+
+  uint64_t bm[ALPHABET_LEN] = {0}; // Bitmap for each letter in the alphabet
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= (uint64_t(1) << i);
+  }
+
+  uint64_t vp = ~0ULL;
+  uint64_t vn = 0;
+  uint32_t score = q_wrd_len;
+
+  // Past column m + max_dist every score is at least j - m > max_dist
+  int cols = std::min<int>(d_wrd_len, q_wrd_len + max_dist);
+
+  for (int i = 0; i < cols; i++) {
+    uint64_t c_bm = bm[d_wrd[i] - 'a'];
+
+    uint64_t x = c_bm | vn;
+    uint64_t d0 = ((vp + (x & vp)) ^ vp) | x;
+    uint64_t hn = vp & d0;
+    uint64_t hp = vn | ~(vp | d0);
+    uint64_t y = (hp << 1) | 1;
+    vn = y & d0;
+    vp = (hn << 1) | ~(y | d0);
+
+    if ((hp & (uint64_t(1) << (q_wrd_len - 1))) != 0) {
+      score++;
+    } else if ((hn & (uint64_t(1) << (q_wrd_len - 1))) != 0) {
+      score--;
+    }
+    min_score = std::min(min_score, score);
+
+    // The score drops by at most one per remaining column
+    if (score >= min_score + (d_wrd_len - i - 1))
+      break;
+  }
+
+  return min_score;
+}
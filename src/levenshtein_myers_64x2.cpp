@@ -1,4 +1,5 @@
 #include "levenshtein_myers.hpp"
+#include <algorithm>
 #include <arm_neon.h>
 
 static const uint64x2_t NULL_V = vdupq_n_u64(0);
@@ -6,6 +7,16 @@ static const uint64x2_t ONE_V = vdupq_n_u64(1);
 
 uint64x2_t not_u64(uint64x2_t a) { return veorq_u64(a, vdupq_n_u64(~0ULL)); }
 
+// There is no vminq_u64
+static inline uint64x2_t min_u64(uint64x2_t a, uint64x2_t b) {
+  return vbslq_u64(vcltq_u64(a, b), a, b);
+}
+
+// Nor vabdq_u64
+static inline uint64x2_t abd_u64(uint64x2_t a, uint64x2_t b) {
+  return vbslq_u64(vcgtq_u64(a, b), vsubq_u64(a, b), vsubq_u64(b, a));
+}
+
 std::array<uint64_t, 2> levenshtein_myers_64x2(const Myers64x2Input &input) {
   if (input.q_wrd_len == 0)
     return std::to_array(input.d_wrd_lens);
@@ -62,3 +73,205 @@ std::array<uint64_t, 2> levenshtein_myers_64x2(const Myers64x2Input &input) {
   return std::array<uint64_t, 2>{vgetq_lane_u64(scores, 0),
                                  vgetq_lane_u64(scores, 1)};
 }
+
+std::array<uint64_t, 2>
+levenshtein_myers_64x2_block(const MyersBlockInput &input) {
+  if (input.q_wrd_len == 0)
+    return std::array<uint64_t, 2>{(uint64_t)input.d_wrd_len,
+                                   (uint64_t)input.d_wrd_len};
+
+  uint64_t bm[ALPHABET_LEN + 1] = {0}; // Last entry is the pad symbol
+
+  const char *q_wrd = input.q_wrd;
+  uint64_t q_wrd_len = input.q_wrd_len;
+  uint64x2_t scores = vdupq_n_u64(q_wrd_len);
+
+  uint64x2_t vp = vdupq_n_u64(~0ULL);
+  uint64x2_t vn = vdupq_n_u64(0);
+  uint64x2_t x, y, hn, hp, d0;
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[(unsigned char)q_wrd[i] - 'a'] |= (uint64_t(1) << i);
+  }
+
+  uint64x2_t q_wrd_len_ls = vshlq_u64(ONE_V, vdupq_n_u64(q_wrd_len - 1));
+
+  for (int i = 0; i < input.d_wrd_len; i++) {
+    const uint8_t *syms = input.d_syms + i * MYERS_BLOCK_LANES;
+    uint64x2_t c_bm = {bm[syms[0]], bm[syms[1]]};
+
+    x = vorrq_u64(c_bm, vn);
+    d0 = vorrq_u64(veorq_u64(vaddq_u64(vandq_u64(vp, x), vp), vp), x);
+    hn = vandq_u64(vp, d0);
+    hp = vorrq_u64(vn, not_u64(vorrq_u64(vp, d0)));
+    y = vorrq_u64(vshlq_n_u64(hp, 1), ONE_V);
+    vn = vandq_u64(y, d0);
+    vp = vorrq_u64(vshlq_n_u64(hn, 1), not_u64(vorrq_u64(y, d0)));
+
+    // All lanes share d_wrd_len, so no per-lane length mask is needed
+    scores = vsubq_u64(scores, vtstq_u64(hp, q_wrd_len_ls));
+    scores = vaddq_u64(scores, vtstq_u64(hn, q_wrd_len_ls));
+  }
+
+  return std::array<uint64_t, 2>{vgetq_lane_u64(scores, 0),
+                                 vgetq_lane_u64(scores, 1)};
+}
+
+std::array<uint64_t, 2>
+levenshtein_myers_64x2_prefix(const Myers64x2Input &input,
+                              uint64_t max_dist) {
+  // The empty prefix is m edits away, so no larger bound is needed. Scores
+  // above max_dist are reported as max_dist + 1
+  if (max_dist > input.q_wrd_len)
+    max_dist = input.q_wrd_len;
+  uint64x2_t cap = vdupq_n_u64(max_dist + 1);
+  uint64x2_t min_scores = min_u64(vdupq_n_u64(input.q_wrd_len), cap);
+  if (input.q_wrd_len == 0) {
+    std::array<uint64_t, 2> out;
+    vst1q_u64(out.data(), min_scores);
+    return out;
+  }
+
+  uint64_t bm[ALPHABET_LEN] = {0}; // Bitmap for each letter in the alphabet
+
+  const char *q_wrd = input.q_wrd;
+  uint64_t q_wrd_len = input.q_wrd_len;
+  uint64x2_t scores = vdupq_n_u64(q_wrd_len);
+
+  uint64x2_t vp = vdupq_n_u64(~0ULL);
+  uint64x2_t vn = vdupq_n_u64(0);
+  uint64x2_t x, y, hn, hp, d0;
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= (uint64_t(1) << i);
+  }
+
+  uint64x2_t d_wrd_lens = vld1q_u64(input.d_wrd_lens);
+
+  uint64x2_t q_wrd_len_ls = vshlq_u64(ONE_V, vdupq_n_u64(q_wrd_len - 1));
+
+  // Past column m + max_dist every score is at least j - m > max_dist
+  int max_d_wrd_len =
+      std::min<int>(std::max(input.d_wrd_lens[0], input.d_wrd_lens[1]), q_wrd_len + max_dist);
+
+  // A lane stays active while a later column may still lower its minimum:
+  // the score drops by at most one per remaining column
+  uint64x2_t active = vcltq_u64(NULL_V, min_scores);
+
+  for (int i = 0; i < max_d_wrd_len; i++) {
+    uint64_t c_bm_0 = bm[input.d_wrds[0][i] - 'a'];
+    uint64_t c_bm_1 = bm[input.d_wrds[1][i] - 'a'];
+    uint64x2_t c_bm = {c_bm_0, c_bm_1};
+
+    x = vorrq_u64(c_bm, vn);
+    d0 = vorrq_u64(veorq_u64(vaddq_u64(vandq_u64(vp, x), vp), vp), x);
+    hn = vandq_u64(vp, d0);
+    hp = vorrq_u64(vn, not_u64(vorrq_u64(vp, d0)));
+    y = vorrq_u64(vshlq_n_u64(hp, 1), ONE_V);
+    vn = vandq_u64(y, d0);
+    vp = vorrq_u64(vshlq_n_u64(hn, 1), not_u64(vorrq_u64(y, d0)));
+
+    uint64x2_t i_v = vdupq_n_u64(i);
+    active = vandq_u64(active, vcltq_u64(i_v, d_wrd_lens));
+    scores = vsubq_u64(scores, vandq_u64(active, vtstq_u64(hp, q_wrd_len_ls)));
+    scores = vaddq_u64(scores, vandq_u64(active, vtstq_u64(hn, q_wrd_len_ls)));
+    min_scores = min_u64(min_scores, scores);
+
+    uint64x2_t remaining = vsubq_u64(d_wrd_lens, vaddq_u64(i_v, ONE_V));
+    active = vandq_u64(
+        active, vcltq_u64(scores, vqaddq_u64(min_scores, remaining)));
+    if (vmaxvq_u32(vreinterpretq_u32_u64(active)) == 0)
+      break;
+  }
+
+  std::array<uint64_t, 2> out;
+  vst1q_u64(out.data(), min_scores);
+  return out;
+}
+
+std::array<uint64_t, 2>
+levenshtein_myers_64x2_bounded(const Myers64x2Input &input,
+                               uint64_t max_dist) {
+  // Scores above max_dist are reported as max_dist + 1
+  if (max_dist == UINT64_MAX)
+    max_dist = UINT64_MAX - 1;
+  uint64x2_t cap = vdupq_n_u64(max_dist + 1);
+  uint64x2_t d_wrd_lens = vld1q_u64(input.d_wrd_lens);
+  if (input.q_wrd_len == 0) {
+    std::array<uint64_t, 2> out;
+    vst1q_u64(out.data(), min_u64(d_wrd_lens, cap));
+    return out;
+  }
+
+  uint64_t bm[ALPHABET_LEN] = {0}; // Bitmap for each letter in the alphabet
+
+  const char *q_wrd = input.q_wrd;
+  uint64_t q_wrd_len = input.q_wrd_len;
+  uint64x2_t scores = vdupq_n_u64(q_wrd_len);
+
+  uint64x2_t vp = vdupq_n_u64(~0ULL);
+  uint64x2_t vn = vdupq_n_u64(0);
+  uint64x2_t x, y, hn, hp, d0;
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= (uint64_t(1) << i);
+  }
+
+  uint64x2_t q_wrd_len_ls = vshlq_u64(ONE_V, vdupq_n_u64(q_wrd_len - 1));
+  uint64x2_t q_wrd_len_v = vdupq_n_u64(q_wrd_len);
+
+  // The length difference alone may already exceed the bound
+  uint64x2_t len_diff = abd_u64(d_wrd_lens, q_wrd_len_v);
+  uint64x2_t alive = vcleq_u64(len_diff, vdupq_n_u64(max_dist));
+
+  int max_d_wrd_len = std::max(input.d_wrd_lens[0], input.d_wrd_lens[1]);
+
+  for (int i = 0; i < max_d_wrd_len; i++) {
+    uint64x2_t step = vandq_u64(alive, vcltq_u64(vdupq_n_u64(i), d_wrd_lens));
+    if (vmaxvq_u32(vreinterpretq_u32_u64(step)) == 0)
+      break;
+
+    uint64_t c_bm_0 = bm[input.d_wrds[0][i] - 'a'];
+    uint64_t c_bm_1 = bm[input.d_wrds[1][i] - 'a'];
+    uint64x2_t c_bm = {c_bm_0, c_bm_1};
+
+    x = vorrq_u64(c_bm, vn);
+    d0 = vorrq_u64(veorq_u64(vaddq_u64(vandq_u64(vp, x), vp), vp), x);
+    hn = vandq_u64(vp, d0);
+    hp = vorrq_u64(vn, not_u64(vorrq_u64(vp, d0)));
+    y = vorrq_u64(vshlq_n_u64(hp, 1), ONE_V);
+    vn = vandq_u64(y, d0);
+    vp = vorrq_u64(vshlq_n_u64(hn, 1), not_u64(vorrq_u64(y, d0)));
+
+    uint64x2_t j_v = vdupq_n_u64(i + 1);
+    scores = vsubq_u64(scores, vandq_u64(step, vtstq_u64(hp, q_wrd_len_ls)));
+    scores = vaddq_u64(scores, vandq_u64(step, vtstq_u64(hn, q_wrd_len_ls)));
+
+    // Scores never decrease along a diagonal, so the cell of this column on
+    // the diagonal ending in D[m][n] bounds the final score from below.
+    // Its row is j + m - n, read off vp / vn with a popcount.
+    uint64x2_t on_diag =
+        vcleq_u64(d_wrd_lens, vqaddq_u64(j_v, q_wrd_len_v));
+    uint64x2_t row = vsubq_u64(vaddq_u64(j_v, q_wrd_len_v), d_wrd_lens);
+    uint64x2_t row_mask =
+        vsubq_u64(vshlq_u64(ONE_V, vreinterpretq_s64_u64(row)), ONE_V);
+    uint64x2_t pos = vpaddlq_u32(vpaddlq_u16(
+        vpaddlq_u8(vcntq_u8(vreinterpretq_u8_u64(vandq_u64(vp, row_mask))))));
+    uint64x2_t neg = vpaddlq_u32(vpaddlq_u16(
+        vpaddlq_u8(vcntq_u8(vreinterpretq_u8_u64(vandq_u64(vn, row_mask))))));
+    uint64x2_t diag = vsubq_u64(vaddq_u64(j_v, pos), neg);
+
+    uint64x2_t exceeded =
+        vandq_u64(vandq_u64(step, on_diag), vcgeq_u64(diag, cap));
+    alive = vandq_u64(alive, not_u64(exceeded));
+  }
+
+  // Lanes that stopped early are over the bound
+  scores = vbslq_u64(alive, scores, cap);
+  std::array<uint64_t, 2> out;
+  vst1q_u64(out.data(), min_u64(scores, cap));
+  return out;
+}
@@ -1,4 +1,5 @@
 #include "levenshtein_myers.hpp"
+#include <algorithm>
 #include <arm_neon.h>
 
 static const uint8x16_t NULL_V_8 = vdupq_n_u8(0);
@@ -78,3 +79,242 @@ std::array<uint8_t, 16> levenshtein_myers_8x16(const Myers8x16Input &input) {
   vst1q_u8(out.data(), scores);
   return out;
 }
+
+std::array<uint8_t, 16>
+levenshtein_myers_8x16_block(const MyersBlockInput &input) {
+  std::array<uint8_t, 16> out;
+  if (input.q_wrd_len == 0) {
+    out.fill(input.d_wrd_len);
+    return out;
+  }
+
+  // 32 entries so the table fits two registers; the pad symbol maps to 0
+  alignas(16) uint8_t bm[32] = {0};
+
+  const char *q_wrd = input.q_wrd;
+  uint8_t q_wrd_len = input.q_wrd_len;
+  uint8x16_t scores = vdupq_n_u8(q_wrd_len);
+
+  uint8x16_t vp = vdupq_n_u8(0xFF);
+  uint8x16_t vn = vdupq_n_u8(0);
+  uint8x16_t x, y, hn, hp, d0;
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= 1 << i;
+  }
+  uint8x16x2_t bm_v = vld1q_u8_x2(bm);
+
+  uint8x16_t q_wrd_len_ls = vshlq_u8(ONE_V_8, vdupq_n_u8(q_wrd_len - 1));
+
+  for (int i = 0; i < input.d_wrd_len; i++) {
+    // The symbols are pre-encoded, so a table lookup replaces 16 gathers
+    uint8x16_t syms = vld1q_u8(input.d_syms + i * MYERS_BLOCK_LANES);
+    uint8x16_t c_bm = vqtbl2q_u8(bm_v, syms);
+
+    x = vorrq_u8(c_bm, vn);
+    d0 = vorrq_u8(veorq_u8(vaddq_u8(vandq_u8(vp, x), vp), vp), x);
+    hn = vandq_u8(vp, d0);
+    hp = vorrq_u8(vn, vmvnq_u8(vorrq_u8(vp, d0)));
+    y = vorrq_u8(vshlq_n_u8(hp, 1), ONE_V_8);
+    vn = vandq_u8(y, d0);
+    vp = vorrq_u8(vshlq_n_u8(hn, 1), vmvnq_u8(vorrq_u8(y, d0)));
+
+    // All lanes share d_wrd_len, so no per-lane length mask is needed
+    scores = vsubq_u8(scores, vtstq_u8(hp, q_wrd_len_ls));
+    scores = vaddq_u8(scores, vtstq_u8(hn, q_wrd_len_ls));
+  }
+
+  vst1q_u8(out.data(), scores);
+  return out;
+}
+
+std::array<uint8_t, 16>
+levenshtein_myers_8x16_prefix(const Myers8x16Input &input,
+                              uint8_t max_dist) {
+  // The empty prefix is m edits away, so no larger bound is needed. Scores
+  // above max_dist are reported as max_dist + 1
+  if (max_dist > input.q_wrd_len)
+    max_dist = input.q_wrd_len;
+  uint8x16_t cap = vdupq_n_u8(max_dist + 1);
+  uint8x16_t min_scores = vminq_u8(vdupq_n_u8(input.q_wrd_len), cap);
+  if (input.q_wrd_len == 0) {
+    std::array<uint8_t, 16> out;
+    vst1q_u8(out.data(), min_scores);
+    return out;
+  }
+
+  uint8_t bm[ALPHABET_LEN] = {0}; // Bitmap for each letter in the alphabet
+
+  const char *q_wrd = input.q_wrd;
+  uint8_t q_wrd_len = input.q_wrd_len;
+  uint8x16_t scores = vdupq_n_u8(q_wrd_len);
+
+  uint8x16_t vp = vdupq_n_u8(0xFF);
+  uint8x16_t vn = vdupq_n_u8(0);
+  uint8x16_t x, y, hn, hp, d0;
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= 1 << i;
+  }
+
+  uint8x16_t d_wrd_lens = vld1q_u8(input.d_wrd_lens);
+
+  uint8x16_t q_wrd_len_ls = vshlq_u8(ONE_V_8, vdupq_n_u8(q_wrd_len - 1));
+
+  // Past column m + max_dist every score is at least j - m > max_dist
+  int max_d_wrd_len =
+      std::min<int>(std::ranges::max(input.d_wrd_lens), q_wrd_len + max_dist);
+
+  // A lane stays active while a later column may still lower its minimum:
+  // the score drops by at most one per remaining column
+  uint8x16_t active = vcltq_u8(NULL_V_8, min_scores);
+
+  for (int i = 0; i < max_d_wrd_len; i++) {
+    uint8_t c_bm_0 = bm[input.d_wrds[0][i] - 'a'];
+    uint8_t c_bm_1 = bm[input.d_wrds[1][i] - 'a'];
+    uint8_t c_bm_2 = bm[input.d_wrds[2][i] - 'a'];
+    uint8_t c_bm_3 = bm[input.d_wrds[3][i] - 'a'];
+    uint8_t c_bm_4 = bm[input.d_wrds[4][i] - 'a'];
+    uint8_t c_bm_5 = bm[input.d_wrds[5][i] - 'a'];
+    uint8_t c_bm_6 = bm[input.d_wrds[6][i] - 'a'];
+    uint8_t c_bm_7 = bm[input.d_wrds[7][i] - 'a'];
+    uint8_t c_bm_8 = bm[input.d_wrds[8][i] - 'a'];
+    uint8_t c_bm_9 = bm[input.d_wrds[9][i] - 'a'];
+    uint8_t c_bm_10 = bm[input.d_wrds[10][i] - 'a'];
+    uint8_t c_bm_11 = bm[input.d_wrds[11][i] - 'a'];
+    uint8_t c_bm_12 = bm[input.d_wrds[12][i] - 'a'];
+    uint8_t c_bm_13 = bm[input.d_wrds[13][i] - 'a'];
+    uint8_t c_bm_14 = bm[input.d_wrds[14][i] - 'a'];
+    uint8_t c_bm_15 = bm[input.d_wrds[15][i] - 'a'];
+
+    uint8x16_t c_bm = {c_bm_0,  c_bm_1,  c_bm_2,  c_bm_3, c_bm_4,  c_bm_5,
+                       c_bm_6,  c_bm_7,  c_bm_8,  c_bm_9, c_bm_10, c_bm_11,
+                       c_bm_12, c_bm_13, c_bm_14, c_bm_15};
+
+    x = vorrq_u8(c_bm, vn);
+    d0 = vorrq_u8(veorq_u8(vaddq_u8(vandq_u8(vp, x), vp), vp), x);
+    hn = vandq_u8(vp, d0);
+    hp = vorrq_u8(vn, vmvnq_u8(vorrq_u8(vp, d0)));
+    y = vorrq_u8(vshlq_n_u8(hp, 1), ONE_V_8);
+    vn = vandq_u8(y, d0);
+    vp = vorrq_u8(vshlq_n_u8(hn, 1), vmvnq_u8(vorrq_u8(y, d0)));
+
+    uint8x16_t i_v = vdupq_n_u8(i);
+    active = vandq_u8(active, vcltq_u8(i_v, d_wrd_lens));
+    scores = vsubq_u8(scores, vandq_u8(active, vtstq_u8(hp, q_wrd_len_ls)));
+    scores = vaddq_u8(scores, vandq_u8(active, vtstq_u8(hn, q_wrd_len_ls)));
+    min_scores = vminq_u8(min_scores, scores);
+
+    uint8x16_t remaining = vsubq_u8(d_wrd_lens, vaddq_u8(i_v, ONE_V_8));
+    active = vandq_u8(
+        active, vcltq_u8(scores, vqaddq_u8(min_scores, remaining)));
+    if (vmaxvq_u8(active) == 0)
+      break;
+  }
+
+  std::array<uint8_t, 16> out;
+  vst1q_u8(out.data(), min_scores);
+  return out;
+}
+
+std::array<uint8_t, 16>
+levenshtein_myers_8x16_bounded(const Myers8x16Input &input,
+                               uint8_t max_dist) {
+  // Scores above max_dist are reported as max_dist + 1
+  if (max_dist == UINT8_MAX)
+    max_dist = UINT8_MAX - 1;
+  uint8x16_t cap = vdupq_n_u8(max_dist + 1);
+  uint8x16_t d_wrd_lens = vld1q_u8(input.d_wrd_lens);
+  if (input.q_wrd_len == 0) {
+    std::array<uint8_t, 16> out;
+    vst1q_u8(out.data(), vminq_u8(d_wrd_lens, cap));
+    return out;
+  }
+
+  uint8_t bm[ALPHABET_LEN] = {0}; // Bitmap for each letter in the alphabet
+
+  const char *q_wrd = input.q_wrd;
+  uint8_t q_wrd_len = input.q_wrd_len;
+  uint8x16_t scores = vdupq_n_u8(q_wrd_len);
+
+  uint8x16_t vp = vdupq_n_u8(0xFF);
+  uint8x16_t vn = vdupq_n_u8(0);
+  uint8x16_t x, y, hn, hp, d0;
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= 1 << i;
+  }
+
+  uint8x16_t q_wrd_len_ls = vshlq_u8(ONE_V_8, vdupq_n_u8(q_wrd_len - 1));
+  uint8x16_t q_wrd_len_v = vdupq_n_u8(q_wrd_len);
+
+  // The length difference alone may already exceed the bound
+  uint8x16_t len_diff = vabdq_u8(d_wrd_lens, q_wrd_len_v);
+  uint8x16_t alive = vcleq_u8(len_diff, vdupq_n_u8(max_dist));
+
+  int max_d_wrd_len = std::ranges::max(input.d_wrd_lens);
+
+  for (int i = 0; i < max_d_wrd_len; i++) {
+    uint8x16_t step = vandq_u8(alive, vcltq_u8(vdupq_n_u8(i), d_wrd_lens));
+    if (vmaxvq_u8(step) == 0)
+      break;
+
+    uint8_t c_bm_0 = bm[input.d_wrds[0][i] - 'a'];
+    uint8_t c_bm_1 = bm[input.d_wrds[1][i] - 'a'];
+    uint8_t c_bm_2 = bm[input.d_wrds[2][i] - 'a'];
+    uint8_t c_bm_3 = bm[input.d_wrds[3][i] - 'a'];
+    uint8_t c_bm_4 = bm[input.d_wrds[4][i] - 'a'];
+    uint8_t c_bm_5 = bm[input.d_wrds[5][i] - 'a'];
+    uint8_t c_bm_6 = bm[input.d_wrds[6][i] - 'a'];
+    uint8_t c_bm_7 = bm[input.d_wrds[7][i] - 'a'];
+    uint8_t c_bm_8 = bm[input.d_wrds[8][i] - 'a'];
+    uint8_t c_bm_9 = bm[input.d_wrds[9][i] - 'a'];
+    uint8_t c_bm_10 = bm[input.d_wrds[10][i] - 'a'];
+    uint8_t c_bm_11 = bm[input.d_wrds[11][i] - 'a'];
+    uint8_t c_bm_12 = bm[input.d_wrds[12][i] - 'a'];
+    uint8_t c_bm_13 = bm[input.d_wrds[13][i] - 'a'];
+    uint8_t c_bm_14 = bm[input.d_wrds[14][i] - 'a'];
+    uint8_t c_bm_15 = bm[input.d_wrds[15][i] - 'a'];
+
+    uint8x16_t c_bm = {c_bm_0,  c_bm_1,  c_bm_2,  c_bm_3, c_bm_4,  c_bm_5,
+                       c_bm_6,  c_bm_7,  c_bm_8,  c_bm_9, c_bm_10, c_bm_11,
+                       c_bm_12, c_bm_13, c_bm_14, c_bm_15};
+
+    x = vorrq_u8(c_bm, vn);
+    d0 = vorrq_u8(veorq_u8(vaddq_u8(vandq_u8(vp, x), vp), vp), x);
+    hn = vandq_u8(vp, d0);
+    hp = vorrq_u8(vn, vmvnq_u8(vorrq_u8(vp, d0)));
+    y = vorrq_u8(vshlq_n_u8(hp, 1), ONE_V_8);
+    vn = vandq_u8(y, d0);
+    vp = vorrq_u8(vshlq_n_u8(hn, 1), vmvnq_u8(vorrq_u8(y, d0)));
+
+    uint8x16_t j_v = vdupq_n_u8(i + 1);
+    scores = vsubq_u8(scores, vandq_u8(step, vtstq_u8(hp, q_wrd_len_ls)));
+    scores = vaddq_u8(scores, vandq_u8(step, vtstq_u8(hn, q_wrd_len_ls)));
+
+    // Scores never decrease along a diagonal, so the cell of this column on
+    // the diagonal ending in D[m][n] bounds the final score from below.
+    // Its row is j + m - n, read off vp / vn with a popcount.
+    uint8x16_t on_diag =
+        vcleq_u8(d_wrd_lens, vqaddq_u8(j_v, q_wrd_len_v));
+    uint8x16_t row = vsubq_u8(vaddq_u8(j_v, q_wrd_len_v), d_wrd_lens);
+    uint8x16_t row_mask =
+        vsubq_u8(vshlq_u8(ONE_V_8, vreinterpretq_s8_u8(row)), ONE_V_8);
+    uint8x16_t pos = vcntq_u8(vandq_u8(vp, row_mask));
+    uint8x16_t neg = vcntq_u8(vandq_u8(vn, row_mask));
+    uint8x16_t diag = vsubq_u8(vaddq_u8(j_v, pos), neg);
+
+    uint8x16_t exceeded =
+        vandq_u8(vandq_u8(step, on_diag), vcgeq_u8(diag, cap));
+    alive = vandq_u8(alive, vmvnq_u8(exceeded));
+  }
+
+  // Lanes that stopped early are over the bound
+  scores = vbslq_u8(alive, scores, cap);
+  std::array<uint8_t, 16> out;
+  vst1q_u8(out.data(), vminq_u8(scores, cap));
+  return out;
+}
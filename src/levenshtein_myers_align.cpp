@@ -0,0 +1,211 @@
+#include "levenshtein_myers.hpp"
+#include <algorithm>
+#include <bit>
+
+// Score of D[i][j] from the vertical deltas stored for column j: the top row
+// is j, and bit r of vp/vn is the +1/-1 step from row r to row r + 1.
+static inline uint32_t column_score(uint64_t vp, uint64_t vn, int i, int j) {
+  uint64_t mask = i == 64 ? ~0ULL : (uint64_t(1) << i) - 1;
+  return j + std::popcount(vp & mask) - std::popcount(vn & mask);
+}
+
+// Full traceback for q_wrd_len <= 64: run the 64x1 recurrence, keep the
+// vertical delta vectors of every column, then walk back from D[m][n].
+// Ops are appended to `ops` in order.
+static uint32_t align_64x1(const char *q_wrd, int q_wrd_len, const char *d_wrd,
+                           int d_wrd_len, std::string &ops) {
+  if (q_wrd_len == 0) {
+    ops.append(d_wrd_len, 'D');
+    return d_wrd_len;
+  }
+
+  uint64_t bm[256] = {0};
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[(unsigned char)q_wrd[i]] |= (uint64_t(1) << i);
+  }
+
+  // Column 0 is the all-ones vp of the first row
+  std::vector<uint64_t> col_vp(d_wrd_len + 1), col_vn(d_wrd_len + 1);
+  uint64_t vp = ~0ULL;
+  uint64_t vn = 0;
+  col_vp[0] = vp;
+  col_vn[0] = vn;
+
+  for (int j = 0; j < d_wrd_len; j++) {
+    uint64_t c_bm = bm[(unsigned char)d_wrd[j]];
+
+    uint64_t x = c_bm | vn;
+    uint64_t d0 = ((vp + (x & vp)) ^ vp) | x;
+    uint64_t hn = vp & d0;
+    uint64_t hp = vn | ~(vp | d0);
+    uint64_t y = (hp << 1) | 1;
+    vn = y & d0;
+    vp = (hn << 1) | ~(y | d0);
+
+    col_vp[j + 1] = vp;
+    col_vn[j + 1] = vn;
+  }
+
+  auto score = [&](int i, int j) {
+    return column_score(col_vp[j], col_vn[j], i, j);
+  };
+
+  uint32_t distance = score(q_wrd_len, d_wrd_len);
+
+  size_t start = ops.size();
+  int i = q_wrd_len, j = d_wrd_len;
+  while (i > 0 || j > 0) {
+    uint32_t s = score(i, j);
+    if (i > 0 && j > 0) {
+      uint32_t diag = score(i - 1, j - 1);
+      if (q_wrd[i - 1] == d_wrd[j - 1] && diag == s) {
+        ops.push_back('=');
+        i--, j--;
+        continue;
+      }
+      if (diag + 1 == s) {
+        ops.push_back('X');
+        i--, j--;
+        continue;
+      }
+    }
+    if (i > 0 && score(i - 1, j) + 1 == s) {
+      ops.push_back('I');
+      i--;
+    } else {
+      ops.push_back('D');
+      j--;
+    }
+  }
+  std::reverse(ops.begin() + start, ops.end());
+  return distance;
+}
+
+uint32_t levenshtein_myers_64x1_align(const char *q_wrd, int q_wrd_len,
+                                      const char *d_wrd, int d_wrd_len,
+                                      std::string &ops) {
+  ops.clear();
+  return align_64x1(q_wrd, q_wrd_len, d_wrd, d_wrd_len, ops);
+}
+
+// Scores of the last column of D(q, d) for a query of any length, computed
+// with Myers' block recurrence in O(m / 64) words. With `reverse` both
+// strings are read back to front. col[i] receives D[i][d_wrd_len].
+static void last_column(const char *q_wrd, int q_wrd_len, const char *d_wrd,
+                        int d_wrd_len, bool reverse,
+                        std::vector<uint32_t> &col) {
+  int blocks = (q_wrd_len + 63) / 64;
+  std::vector<uint64_t> peq(size_t(blocks) * 256, 0);
+  for (int i = 0; i < q_wrd_len; i++) {
+    unsigned char c = q_wrd[reverse ? q_wrd_len - 1 - i : i];
+    peq[size_t(c) * blocks + i / 64] |= uint64_t(1) << (i % 64);
+  }
+
+  std::vector<uint64_t> vp(blocks, ~0ULL), vn(blocks, 0);
+  for (int j = 0; j < d_wrd_len; j++) {
+    unsigned char c = d_wrd[reverse ? d_wrd_len - 1 - j : j];
+    const uint64_t *eq_col = &peq[size_t(c) * blocks];
+
+    // The top row of the edit distance matrix grows by one per column
+    int h_in = 1;
+    for (int b = 0; b < blocks; b++) {
+      uint64_t eq = eq_col[b];
+      uint64_t pv = vp[b], mv = vn[b];
+      uint64_t xv = eq | mv;
+      if (h_in < 0)
+        eq |= 1;
+      uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+      uint64_t ph = mv | ~(xh | pv);
+      uint64_t mh = pv & xh;
+
+      int h_out = (ph >> 63) ? 1 : (mh >> 63) ? -1 : 0;
+
+      ph <<= 1;
+      mh <<= 1;
+      if (h_in < 0)
+        mh |= 1;
+      else if (h_in > 0)
+        ph |= 1;
+      vp[b] = mh | ~(xv | ph);
+      vn[b] = ph & xv;
+      h_in = h_out;
+    }
+  }
+
+  col.resize(q_wrd_len + 1);
+  col[0] = d_wrd_len;
+  for (int i = 0; i < q_wrd_len; i++) {
+    uint64_t bit = uint64_t(1) << (i % 64);
+    col[i + 1] = col[i] + ((vp[i / 64] & bit) ? 1 : 0) -
+                 ((vn[i / 64] & bit) ? 1 : 0);
+  }
+}
+
+// Hirschberg: split the database string in half, find the query row where
+// an optimal path crosses the middle column from the forward and reverse
+// last columns, and recurse. Memory stays linear in the string lengths.
+static void align_hirschberg(const char *q_wrd, int q_wrd_len,
+                             const char *d_wrd, int d_wrd_len,
+                             std::string &ops) {
+  if (q_wrd_len <= 64) {
+    align_64x1(q_wrd, q_wrd_len, d_wrd, d_wrd_len, ops);
+    return;
+  }
+  if (d_wrd_len <= 64) {
+    // Swap roles so the short side is the bitvector, then swap the ops back
+    size_t start = ops.size();
+    align_64x1(d_wrd, d_wrd_len, q_wrd, q_wrd_len, ops);
+    for (size_t k = start; k < ops.size(); k++) {
+      if (ops[k] == 'I')
+        ops[k] = 'D';
+      else if (ops[k] == 'D')
+        ops[k] = 'I';
+    }
+    return;
+  }
+
+  int mid = d_wrd_len / 2;
+  std::vector<uint32_t> fwd, rev;
+  last_column(q_wrd, q_wrd_len, d_wrd, mid, false, fwd);
+  last_column(q_wrd, q_wrd_len, d_wrd + mid, d_wrd_len - mid, true, rev);
+
+  int split = 0;
+  uint32_t best = UINT32_MAX;
+  for (int i = 0; i <= q_wrd_len; i++) {
+    uint32_t cost = fwd[i] + rev[q_wrd_len - i];
+    if (cost < best) {
+      best = cost;
+      split = i;
+    }
+  }
+
+  // Release the columns before recursing
+  std::vector<uint32_t>().swap(fwd);
+  std::vector<uint32_t>().swap(rev);
+
+  align_hirschberg(q_wrd, split, d_wrd, mid, ops);
+  align_hirschberg(q_wrd + split, q_wrd_len - split, d_wrd + mid,
+                   d_wrd_len - mid, ops);
+}
+
+uint32_t levenshtein_myers_anyx1_align(const char *q_wrd, int q_wrd_len,
+                                       const char *d_wrd, int d_wrd_len,
+                                       std::string &ops) {
+  ops.clear();
+  align_hirschberg(q_wrd, q_wrd_len, d_wrd, d_wrd_len, ops);
+  return std::count_if(ops.begin(), ops.end(),
+                       [](char op) { return op != '='; });
+}
+
+std::string levenshtein_cigar(const std::string &ops) {
+  std::string cigar;
+  for (size_t i = 0; i < ops.size();) {
+    size_t run = 1;
+    while (i + run < ops.size() && ops[i + run] == ops[i])
+      run++;
+    cigar += std::to_string(run);
+    cigar += ops[i];
+    i += run;
+  }
+  return cigar;
+}
@@ -0,0 +1,67 @@
+#include "levenshtein_myers.hpp"
+#include <arm_neon.h>
+#include <cstring>
+
+void levenshtein_myers_search_16x8_init(MyersSearch16x8State &state,
+                                        const Myers16x8SearchInput &input) {
+  std::memset(state.bm, 0, sizeof(state.bm));
+
+  // Initialize the lane-interleaved bitmap
+  for (int k = 0; k < 8; k++) {
+    for (int i = 0; i < input.q_wrd_lens[k]; i++) {
+      state.bm[(unsigned char)input.q_wrds[k][i]][k] |= 1 << i;
+    }
+
+    int len = input.q_wrd_lens[k];
+    state.vp[k] = 0xFFFF;
+    state.vn[k] = 0;
+    state.scores[k] = len;
+    state.hi_bits[k] = len == 0 ? 0 : 1 << (len - 1);
+    state.max_dists[k] = input.max_dists[k];
+  }
+  state.pos = 0;
+}
+
+void levenshtein_myers_search_16x8(MyersSearch16x8State &state,
+                                   const char *text, size_t text_len,
+                                   std::vector<MyersSearchHit> &hits) {
+  uint16x8_t vp = vld1q_u16(state.vp);
+  uint16x8_t vn = vld1q_u16(state.vn);
+  uint16x8_t scores = vld1q_u16(state.scores);
+  uint16x8_t hi_bits = vld1q_u16(state.hi_bits);
+  uint16x8_t max_dists = vld1q_u16(state.max_dists);
+  uint16x8_t active = vtstq_u16(hi_bits, hi_bits);
+  uint16x8_t x, y, hn, hp, d0;
+
+  for (size_t i = 0; i < text_len; i++) {
+    uint16x8_t c_bm = vld1q_u16(state.bm[(unsigned char)text[i]]);
+
+    x = vorrq_u16(c_bm, vn);
+    d0 = vorrq_u16(veorq_u16(vaddq_u16(vandq_u16(vp, x), vp), vp), x);
+    hn = vandq_u16(vp, d0);
+    hp = vorrq_u16(vn, vmvnq_u16(vorrq_u16(vp, d0)));
+    y = vshlq_n_u16(hp, 1);
+    vn = vandq_u16(y, d0);
+    vp = vorrq_u16(vshlq_n_u16(hn, 1), vmvnq_u16(vorrq_u16(y, d0)));
+
+    // Masks are all-ones, so subtracting adds one and adding subtracts one
+    scores = vsubq_u16(scores, vtstq_u16(hp, hi_bits));
+    scores = vaddq_u16(scores, vtstq_u16(hn, hi_bits));
+
+    uint16x8_t is_hit = vandq_u16(vcleq_u16(scores, max_dists), active);
+    if (vmaxvq_u16(is_hit) != 0) {
+      uint16_t hit_lanes[8], hit_scores[8];
+      vst1q_u16(hit_lanes, is_hit);
+      vst1q_u16(hit_scores, scores);
+      for (int k = 0; k < 8; k++) {
+        if (hit_lanes[k])
+          hits.push_back({state.pos + i, hit_scores[k], (uint32_t)k});
+      }
+    }
+  }
+
+  vst1q_u16(state.vp, vp);
+  vst1q_u16(state.vn, vn);
+  vst1q_u16(state.scores, scores);
+  state.pos += text_len;
+}
@@ -0,0 +1,67 @@
+#include "levenshtein_myers.hpp"
+#include <arm_neon.h>
+#include <cstring>
+
+void levenshtein_myers_search_32x4_init(MyersSearch32x4State &state,
+                                        const Myers32x4SearchInput &input) {
+  std::memset(state.bm, 0, sizeof(state.bm));
+
+  // Initialize the lane-interleaved bitmap
+  for (int k = 0; k < 4; k++) {
+    for (int i = 0; i < int(input.q_wrd_lens[k]); i++) {
+      state.bm[(unsigned char)input.q_wrds[k][i]][k] |= 1 << i;
+    }
+
+    int len = input.q_wrd_lens[k];
+    state.vp[k] = 0xFFFFFFFF;
+    state.vn[k] = 0;
+    state.scores[k] = len;
+    state.hi_bits[k] = len == 0 ? 0 : 1 << (len - 1);
+    state.max_dists[k] = input.max_dists[k];
+  }
+  state.pos = 0;
+}
+
+void levenshtein_myers_search_32x4(MyersSearch32x4State &state,
+                                   const char *text, size_t text_len,
+                                   std::vector<MyersSearchHit> &hits) {
+  uint32x4_t vp = vld1q_u32(state.vp);
+  uint32x4_t vn = vld1q_u32(state.vn);
+  uint32x4_t scores = vld1q_u32(state.scores);
+  uint32x4_t hi_bits = vld1q_u32(state.hi_bits);
+  uint32x4_t max_dists = vld1q_u32(state.max_dists);
+  uint32x4_t active = vtstq_u32(hi_bits, hi_bits);
+  uint32x4_t x, y, hn, hp, d0;
+
+  for (size_t i = 0; i < text_len; i++) {
+    uint32x4_t c_bm = vld1q_u32(state.bm[(unsigned char)text[i]]);
+
+    x = vorrq_u32(c_bm, vn);
+    d0 = vorrq_u32(veorq_u32(vaddq_u32(vandq_u32(vp, x), vp), vp), x);
+    hn = vandq_u32(vp, d0);
+    hp = vorrq_u32(vn, vmvnq_u32(vorrq_u32(vp, d0)));
+    y = vshlq_n_u32(hp, 1);
+    vn = vandq_u32(y, d0);
+    vp = vorrq_u32(vshlq_n_u32(hn, 1), vmvnq_u32(vorrq_u32(y, d0)));
+
+    // Masks are all-ones, so subtracting adds one and adding subtracts one
+    scores = vsubq_u32(scores, vtstq_u32(hp, hi_bits));
+    scores = vaddq_u32(scores, vtstq_u32(hn, hi_bits));
+
+    uint32x4_t is_hit = vandq_u32(vcleq_u32(scores, max_dists), active);
+    if (vmaxvq_u32(is_hit) != 0) {
+      uint32_t hit_lanes[4], hit_scores[4];
+      vst1q_u32(hit_lanes, is_hit);
+      vst1q_u32(hit_scores, scores);
+      for (int k = 0; k < 4; k++) {
+        if (hit_lanes[k])
+          hits.push_back({state.pos + i, hit_scores[k], (uint32_t)k});
+      }
+    }
+  }
+
+  vst1q_u32(state.vp, vp);
+  vst1q_u32(state.vn, vn);
+  vst1q_u32(state.scores, scores);
+  state.pos += text_len;
+}
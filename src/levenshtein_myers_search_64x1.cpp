@@ -0,0 +1,73 @@
+#include "levenshtein_myers.hpp"
+#include <algorithm>
+#include <bit>
+
+void levenshtein_myers_search_64x1_init(MyersSearch64x1State &state,
+                                        const char *q_wrd, int q_wrd_len,
+                                        uint32_t max_dist) {
+  std::fill(std::begin(state.bm), std::end(state.bm), 0);
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    state.bm[(unsigned char)q_wrd[i]] |= (uint64_t(1) << i);
+  }
+
+  state.vp = ~0ULL;
+  state.vn = 0;
+  state.hi_bit = q_wrd_len == 0 ? 0 : uint64_t(1) << (q_wrd_len - 1);
+  state.score = q_wrd_len;
+  state.max_dist = max_dist;
+  state.pos = 0;
+}
+
+void levenshtein_myers_search_64x1_reset(MyersSearch64x1State &state,
+                                         uint64_t pos) {
+  // hi_bit marks the last pattern bit, so it also gives the pattern length
+  state.vp = ~0ULL;
+  state.vn = 0;
+  state.score = state.hi_bit == 0 ? 0 : std::countr_zero(state.hi_bit) + 1;
+  state.pos = pos;
+}
+
+void levenshtein_myers_search_64x1(MyersSearch64x1State &state,
+                                   const char *text, size_t text_len,
+                                   std::vector<MyersSearchHit> &hits) {
+  uint64_t hi_bit = state.hi_bit;
+  if (hi_bit == 0) {
+    state.pos += text_len;
+    return;
+  }
+
+  uint64_t vp = state.vp;
+  uint64_t vn = state.vn;
+  uint32_t score = state.score;
+  uint32_t max_dist = state.max_dist;
+
+  for (size_t i = 0; i < text_len; i++) {
+    uint64_t c_bm = state.bm[(unsigned char)text[i]];
+
+    uint64_t x = c_bm | vn;
+    uint64_t d0 = ((vp + (x & vp)) ^ vp) | x;
+    uint64_t hn = vp & d0;
+    uint64_t hp = vn | ~(vp | d0);
+    // No carry-in: the first row of the search matrix is all zeros
+    uint64_t y = hp << 1;
+    vn = y & d0;
+    vp = (hn << 1) | ~(y | d0);
+
+    if ((hp & hi_bit) != 0) {
+      score++;
+    } else if ((hn & hi_bit) != 0) {
+      score--;
+    }
+
+    if (score <= max_dist) {
+      hits.push_back({state.pos + i, score, 0});
+    }
+  }
+
+  state.vp = vp;
+  state.vn = vn;
+  state.score = score;
+  state.pos += text_len;
+}
@@ -0,0 +1,72 @@
+#include "levenshtein_myers.hpp"
+#include <arm_neon.h>
+#include <cstring>
+
+static uint64x2_t not_u64(uint64x2_t a) {
+  return veorq_u64(a, vdupq_n_u64(~0ULL));
+}
+
+void levenshtein_myers_search_64x2_init(MyersSearch64x2State &state,
+                                        const Myers64x2SearchInput &input) {
+  std::memset(state.bm, 0, sizeof(state.bm));
+
+  // Initialize the lane-interleaved bitmap
+  for (int k = 0; k < 2; k++) {
+    for (int i = 0; i < int(input.q_wrd_lens[k]); i++) {
+      state.bm[(unsigned char)input.q_wrds[k][i]][k] |= (uint64_t(1) << i);
+    }
+
+    int len = input.q_wrd_lens[k];
+    state.vp[k] = ~0ULL;
+    state.vn[k] = 0;
+    state.scores[k] = len;
+    state.hi_bits[k] = len == 0 ? 0 : uint64_t(1) << (len - 1);
+    state.max_dists[k] = input.max_dists[k];
+  }
+  state.pos = 0;
+}
+
+void levenshtein_myers_search_64x2(MyersSearch64x2State &state,
+                                   const char *text, size_t text_len,
+                                   std::vector<MyersSearchHit> &hits) {
+  uint64x2_t vp = vld1q_u64(state.vp);
+  uint64x2_t vn = vld1q_u64(state.vn);
+  uint64x2_t scores = vld1q_u64(state.scores);
+  uint64x2_t hi_bits = vld1q_u64(state.hi_bits);
+  uint64x2_t max_dists = vld1q_u64(state.max_dists);
+  uint64x2_t active = vtstq_u64(hi_bits, hi_bits);
+  uint64x2_t x, y, hn, hp, d0;
+
+  for (size_t i = 0; i < text_len; i++) {
+    uint64x2_t c_bm = vld1q_u64(state.bm[(unsigned char)text[i]]);
+
+    x = vorrq_u64(c_bm, vn);
+    d0 = vorrq_u64(veorq_u64(vaddq_u64(vandq_u64(vp, x), vp), vp), x);
+    hn = vandq_u64(vp, d0);
+    hp = vorrq_u64(vn, not_u64(vorrq_u64(vp, d0)));
+    y = vshlq_n_u64(hp, 1);
+    vn = vandq_u64(y, d0);
+    vp = vorrq_u64(vshlq_n_u64(hn, 1), not_u64(vorrq_u64(y, d0)));
+
+    // Masks are all-ones, so subtracting adds one and adding subtracts one
+    scores = vsubq_u64(scores, vtstq_u64(hp, hi_bits));
+    scores = vaddq_u64(scores, vtstq_u64(hn, hi_bits));
+
+    uint64x2_t is_hit = vandq_u64(vcleq_u64(scores, max_dists), active);
+    if (vmaxvq_u32(vreinterpretq_u32_u64(is_hit)) != 0) {
+      uint64_t hit_lanes[2], hit_scores[2];
+      vst1q_u64(hit_lanes, is_hit);
+      vst1q_u64(hit_scores, scores);
+      for (int k = 0; k < 2; k++) {
+        if (hit_lanes[k])
+          hits.push_back(
+              {state.pos + i, (uint32_t)hit_scores[k], (uint32_t)k});
+      }
+    }
+  }
+
+  vst1q_u64(state.vp, vp);
+  vst1q_u64(state.vn, vn);
+  vst1q_u64(state.scores, scores);
+  state.pos += text_len;
+}
@@ -0,0 +1,67 @@
+#include "levenshtein_myers.hpp"
+#include <arm_neon.h>
+#include <cstring>
+
+void levenshtein_myers_search_8x16_init(MyersSearch8x16State &state,
+                                        const Myers8x16SearchInput &input) {
+  std::memset(state.bm, 0, sizeof(state.bm));
+
+  // Initialize the lane-interleaved bitmap
+  for (int k = 0; k < 16; k++) {
+    for (int i = 0; i < input.q_wrd_lens[k]; i++) {
+      state.bm[(unsigned char)input.q_wrds[k][i]][k] |= 1 << i;
+    }
+
+    int len = input.q_wrd_lens[k];
+    state.vp[k] = 0xFF;
+    state.vn[k] = 0;
+    state.scores[k] = len;
+    state.hi_bits[k] = len == 0 ? 0 : 1 << (len - 1);
+    state.max_dists[k] = input.max_dists[k];
+  }
+  state.pos = 0;
+}
+
+void levenshtein_myers_search_8x16(MyersSearch8x16State &state,
+                                   const char *text, size_t text_len,
+                                   std::vector<MyersSearchHit> &hits) {
+  uint8x16_t vp = vld1q_u8(state.vp);
+  uint8x16_t vn = vld1q_u8(state.vn);
+  uint8x16_t scores = vld1q_u8(state.scores);
+  uint8x16_t hi_bits = vld1q_u8(state.hi_bits);
+  uint8x16_t max_dists = vld1q_u8(state.max_dists);
+  uint8x16_t active = vtstq_u8(hi_bits, hi_bits);
+  uint8x16_t x, y, hn, hp, d0;
+
+  for (size_t i = 0; i < text_len; i++) {
+    uint8x16_t c_bm = vld1q_u8(state.bm[(unsigned char)text[i]]);
+
+    x = vorrq_u8(c_bm, vn);
+    d0 = vorrq_u8(veorq_u8(vaddq_u8(vandq_u8(vp, x), vp), vp), x);
+    hn = vandq_u8(vp, d0);
+    hp = vorrq_u8(vn, vmvnq_u8(vorrq_u8(vp, d0)));
+    y = vshlq_n_u8(hp, 1);
+    vn = vandq_u8(y, d0);
+    vp = vorrq_u8(vshlq_n_u8(hn, 1), vmvnq_u8(vorrq_u8(y, d0)));
+
+    // Masks are all-ones, so subtracting adds one and adding subtracts one
+    scores = vsubq_u8(scores, vtstq_u8(hp, hi_bits));
+    scores = vaddq_u8(scores, vtstq_u8(hn, hi_bits));
+
+    uint8x16_t is_hit = vandq_u8(vcleq_u8(scores, max_dists), active);
+    if (vmaxvq_u8(is_hit) != 0) {
+      uint8_t hit_lanes[16], hit_scores[16];
+      vst1q_u8(hit_lanes, is_hit);
+      vst1q_u8(hit_scores, scores);
+      for (int k = 0; k < 16; k++) {
+        if (hit_lanes[k])
+          hits.push_back({state.pos + i, hit_scores[k], (uint32_t)k});
+      }
+    }
+  }
+
+  vst1q_u8(state.vp, vp);
+  vst1q_u8(state.vn, vn);
+  vst1q_u8(state.scores, scores);
+  state.pos += text_len;
+}
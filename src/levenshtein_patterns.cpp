@@ -0,0 +1,358 @@
+#include "levenshtein_patterns.hpp"
+#include <algorithm>
+#include <arm_neon.h>
+#include <cstring>
+#include <numeric>
+
+#define MASK_ROW (ALPHABET_LEN + 1)
+#define LENS_ROW (ALPHABET_LEN + 2)
+
+static bool fail(std::string *error, const char *msg) {
+  if (error)
+    *error = msg;
+  return false;
+}
+
+// Lane width of the narrowest kernel whose lanes hold a pattern of `len`
+static int lane_width(int len) {
+  if (len <= 8)
+    return 8;
+  if (len <= 16)
+    return 16;
+  if (len <= 32)
+    return 32;
+  return 64;
+}
+
+// Text bytes to table rows; anything but a-z maps to the all-zero row
+static void encode_text(const char *text, int text_len,
+                        std::vector<uint8_t> &syms) {
+  syms.resize(text_len);
+  for (int i = 0; i < text_len; i++) {
+    uint8_t c = text[i] - 'a';
+    syms[i] = c < ALPHABET_LEN ? c : ALPHABET_LEN;
+  }
+}
+
+// One kernel per lane width. Each streams the text once against the group's
+// patterns and stores the last-row scores modulo the lane width.
+static void scan_group_8(const uint8_t *table, const uint8_t *syms, int n,
+                         uint8_t *out) {
+  uint8x16_t mask = vld1q_u8(table + MASK_ROW * 16);
+  uint8x16_t scores = vld1q_u8(table + LENS_ROW * 16);
+  uint8x16_t vp = vdupq_n_u8(0xFF), vn = vdupq_n_u8(0);
+  uint8x16_t one = vdupq_n_u8(1);
+
+  for (int i = 0; i < n; i++) {
+    uint8x16_t c_bm = vld1q_u8(table + syms[i] * 16);
+    uint8x16_t x = vorrq_u8(c_bm, vn);
+    uint8x16_t d0 = vorrq_u8(veorq_u8(vaddq_u8(vandq_u8(vp, x), vp), vp), x);
+    uint8x16_t hn = vandq_u8(vp, d0);
+    uint8x16_t hp = vorrq_u8(vn, vmvnq_u8(vorrq_u8(vp, d0)));
+    uint8x16_t y = vorrq_u8(vshlq_n_u8(hp, 1), one);
+    vn = vandq_u8(y, d0);
+    vp = vorrq_u8(vshlq_n_u8(hn, 1), vmvnq_u8(vorrq_u8(y, d0)));
+
+    scores = vsubq_u8(scores, vtstq_u8(hp, mask));
+    scores = vaddq_u8(scores, vtstq_u8(hn, mask));
+  }
+  vst1q_u8(out, scores);
+}
+
+static void scan_group_16(const uint8_t *table, const uint8_t *syms, int n,
+                          uint8_t *out) {
+  const uint16_t *rows = (const uint16_t *)table;
+  uint16x8_t mask = vld1q_u16(rows + MASK_ROW * 8);
+  uint16x8_t scores = vld1q_u16(rows + LENS_ROW * 8);
+  uint16x8_t vp = vdupq_n_u16(0xFFFF), vn = vdupq_n_u16(0);
+  uint16x8_t one = vdupq_n_u16(1);
+
+  for (int i = 0; i < n; i++) {
+    uint16x8_t c_bm = vld1q_u16(rows + syms[i] * 8);
+    uint16x8_t x = vorrq_u16(c_bm, vn);
+    uint16x8_t d0 =
+        vorrq_u16(veorq_u16(vaddq_u16(vandq_u16(vp, x), vp), vp), x);
+    uint16x8_t hn = vandq_u16(vp, d0);
+    uint16x8_t hp = vorrq_u16(vn, vmvnq_u16(vorrq_u16(vp, d0)));
+    uint16x8_t y = vorrq_u16(vshlq_n_u16(hp, 1), one);
+    vn = vandq_u16(y, d0);
+    vp = vorrq_u16(vshlq_n_u16(hn, 1), vmvnq_u16(vorrq_u16(y, d0)));
+
+    scores = vsubq_u16(scores, vtstq_u16(hp, mask));
+    scores = vaddq_u16(scores, vtstq_u16(hn, mask));
+  }
+  vst1q_u16((uint16_t *)out, scores);
+}
+
+static void scan_group_32(const uint8_t *table, const uint8_t *syms, int n,
+                          uint8_t *out) {
+  const uint32_t *rows = (const uint32_t *)table;
+  uint32x4_t mask = vld1q_u32(rows + MASK_ROW * 4);
+  uint32x4_t scores = vld1q_u32(rows + LENS_ROW * 4);
+  uint32x4_t vp = vdupq_n_u32(0xFFFFFFFF), vn = vdupq_n_u32(0);
+  uint32x4_t one = vdupq_n_u32(1);
+
+  for (int i = 0; i < n; i++) {
+    uint32x4_t c_bm = vld1q_u32(rows + syms[i] * 4);
+    uint32x4_t x = vorrq_u32(c_bm, vn);
+    uint32x4_t d0 =
+        vorrq_u32(veorq_u32(vaddq_u32(vandq_u32(vp, x), vp), vp), x);
+    uint32x4_t hn = vandq_u32(vp, d0);
+    uint32x4_t hp = vorrq_u32(vn, vmvnq_u32(vorrq_u32(vp, d0)));
+    uint32x4_t y = vorrq_u32(vshlq_n_u32(hp, 1), one);
+    vn = vandq_u32(y, d0);
+    vp = vorrq_u32(vshlq_n_u32(hn, 1), vmvnq_u32(vorrq_u32(y, d0)));
+
+    scores = vsubq_u32(scores, vtstq_u32(hp, mask));
+    scores = vaddq_u32(scores, vtstq_u32(hn, mask));
+  }
+  vst1q_u32((uint32_t *)out, scores);
+}
+
+// There is no vmvnq_u64, so the negations use vornq_u64 (a | ~b)
+static void scan_group_64(const uint8_t *table, const uint8_t *syms, int n,
+                          uint8_t *out) {
+  const uint64_t *rows = (const uint64_t *)table;
+  uint64x2_t mask = vld1q_u64(rows + MASK_ROW * 2);
+  uint64x2_t scores = vld1q_u64(rows + LENS_ROW * 2);
+  uint64x2_t vp = vdupq_n_u64(~0ULL), vn = vdupq_n_u64(0);
+  uint64x2_t one = vdupq_n_u64(1);
+
+  for (int i = 0; i < n; i++) {
+    uint64x2_t c_bm = vld1q_u64(rows + syms[i] * 2);
+    uint64x2_t x = vorrq_u64(c_bm, vn);
+    uint64x2_t d0 =
+        vorrq_u64(veorq_u64(vaddq_u64(vandq_u64(vp, x), vp), vp), x);
+    uint64x2_t hn = vandq_u64(vp, d0);
+    uint64x2_t hp = vornq_u64(vn, vorrq_u64(vp, d0));
+    uint64x2_t y = vorrq_u64(vshlq_n_u64(hp, 1), one);
+    vn = vandq_u64(y, d0);
+    vp = vornq_u64(vshlq_n_u64(hn, 1), vorrq_u64(y, d0));
+
+    scores = vsubq_u64(scores, vtstq_u64(hp, mask));
+    scores = vaddq_u64(scores, vtstq_u64(hn, mask));
+  }
+  vst1q_u64((uint64_t *)out, scores);
+}
+
+// Distances of every lane of group `g`, in lane order
+static void scan_group(const MyersPatternSet &set, size_t g,
+                       const uint8_t *syms, int n, uint32_t *out) {
+  const MyersPatternGroup &group = set.groups[g];
+  const uint8_t *table = set.tables.data() + g * MYERS_PATTERN_GROUP_BYTES;
+
+  alignas(16) uint8_t raw[16];
+  switch (group.width) {
+  case 8:
+    scan_group_8(table, syms, n, raw);
+    break;
+  case 16:
+    scan_group_16(table, syms, n, raw);
+    break;
+  case 32:
+    scan_group_32(table, syms, n, raw);
+    break;
+  default:
+    scan_group_64(table, syms, n, raw);
+    break;
+  }
+
+  // D[m][n] lies in [n - m, n + m], a window narrower than the lane range,
+  // so the wrapped score identifies it
+  for (int k = 0; k < group.n_lanes; k++) {
+    uint32_t m = set.lens[group.first + k];
+    uint64_t s;
+    switch (group.width) {
+    case 8:
+      s = raw[k];
+      break;
+    case 16:
+      s = ((const uint16_t *)raw)[k];
+      break;
+    case 32:
+      s = ((const uint32_t *)raw)[k];
+      break;
+    default:
+      s = ((const uint64_t *)raw)[k];
+      break;
+    }
+    if (m == 0) {
+      out[k] = n;
+      continue;
+    }
+    uint64_t lane_mask =
+        group.width == 64 ? ~0ULL : (uint64_t(1) << group.width) - 1;
+    uint64_t low = uint64_t(n) > m ? n - m : 0;
+    out[k] = low + ((s - low) & lane_mask);
+  }
+}
+
+bool levenshtein_patterns_build(const std::vector<std::string> &patterns,
+                                MyersPatternSet &set, std::string *error) {
+  for (const auto &p : patterns) {
+    if (p.size() > MYERS_PATTERN_MAX_LEN)
+      return fail(error, "pattern too long");
+    for (char c : p) {
+      if (c < 'a' || c > 'z')
+        return fail(error, "patterns must consist of a-z only");
+    }
+  }
+
+  std::vector<uint32_t> order(patterns.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return patterns[a].size() < patterns[b].size();
+  });
+
+  set.n_patterns = patterns.size();
+  set.groups.clear();
+  set.ids.clear();
+  set.lens.clear();
+  set.tables.clear();
+
+  // Fill groups in length order; a group is closed when it is full or the
+  // next pattern needs wider lanes
+  for (size_t i = 0; i < order.size();) {
+    int width = lane_width(patterns[order[i]].size());
+    int lanes = 128 / width;
+    MyersPatternGroup group = {};
+    group.width = width;
+    group.first = set.ids.size();
+    group.min_len = patterns[order[i]].size();
+
+    size_t g = set.groups.size();
+    set.tables.resize((g + 1) * MYERS_PATTERN_GROUP_BYTES, 0);
+    uint8_t *table = set.tables.data() + g * MYERS_PATTERN_GROUP_BYTES;
+    int bytes = width / 8;
+
+    while (i < order.size() && group.n_lanes < lanes &&
+           lane_width(patterns[order[i]].size()) == width) {
+      const std::string &p = patterns[order[i]];
+      int k = group.n_lanes++;
+      for (size_t j = 0; j < p.size(); j++) {
+        uint64_t bit = uint64_t(1) << j;
+        uint8_t *row = table + (p[j] - 'a') * 16 + k * bytes;
+        uint64_t v = 0;
+        std::memcpy(&v, row, bytes);
+        v |= bit;
+        std::memcpy(row, &v, bytes);
+      }
+      uint64_t mask = p.empty() ? 0 : uint64_t(1) << (p.size() - 1);
+      uint64_t len = p.size();
+      std::memcpy(table + MASK_ROW * 16 + k * bytes, &mask, bytes);
+      std::memcpy(table + LENS_ROW * 16 + k * bytes, &len, bytes);
+
+      set.ids.push_back(order[i]);
+      set.lens.push_back(p.size());
+      group.max_len = p.size();
+      i++;
+    }
+    set.groups.push_back(group);
+  }
+  return true;
+}
+
+size_t levenshtein_patterns_memory(const MyersPatternSet &set) {
+  return set.groups.capacity() * sizeof(MyersPatternGroup) +
+         set.ids.capacity() * sizeof(uint32_t) + set.lens.capacity() +
+         set.tables.capacity();
+}
+
+void levenshtein_patterns_scan(const MyersPatternSet &set, const char *text,
+                               int text_len, uint32_t *distances) {
+  thread_local std::vector<uint8_t> syms;
+  encode_text(text, text_len, syms);
+
+  uint32_t out[16];
+  for (size_t g = 0; g < set.groups.size(); g++) {
+    const MyersPatternGroup &group = set.groups[g];
+    scan_group(set, g, syms.data(), text_len, out);
+    for (int k = 0; k < group.n_lanes; k++)
+      distances[set.ids[group.first + k]] = out[k];
+  }
+}
+
+void levenshtein_patterns_scan_within(const MyersPatternSet &set,
+                                      const char *text, int text_len,
+                                      uint32_t max_dist,
+                                      std::vector<MyersScanMatch> &matches,
+                                      MyersPatternStats *stats) {
+  MyersPatternStats local = {};
+  thread_local std::vector<uint8_t> syms;
+  encode_text(text, text_len, syms);
+
+  uint32_t out[16];
+  for (size_t g = 0; g < set.groups.size(); g++) {
+    const MyersPatternGroup &group = set.groups[g];
+    // Every pattern of the group differs from the text in length by more
+    // than max_dist
+    if (uint64_t(group.max_len) + max_dist < uint64_t(text_len) ||
+        uint64_t(group.min_len) > uint64_t(text_len) + max_dist) {
+      local.groups_skipped++;
+      continue;
+    }
+
+    local.groups_run++;
+    scan_group(set, g, syms.data(), text_len, out);
+    for (int k = 0; k < group.n_lanes; k++) {
+      if (out[k] <= max_dist) {
+        matches.push_back({set.ids[group.first + k], out[k]});
+        local.matches++;
+      }
+    }
+  }
+
+  if (stats) {
+    stats->groups_run += local.groups_run;
+    stats->groups_skipped += local.groups_skipped;
+    stats->matches += local.matches;
+  }
+}
+
+void levenshtein_patterns_scan_dictionary(
+    const MyersPatternSet &set, const MyersDictionary &dict, uint32_t max_dist,
+    std::vector<MyersPatternDictMatch> &matches, MyersPatternStats *stats) {
+  MyersPatternStats local = {};
+  thread_local std::vector<uint8_t> syms;
+  std::vector<uint32_t> reach;
+
+  uint32_t out[16];
+  for (uint32_t b = 0; b < dict.header->n_buckets; b++) {
+    const MyersDictBucket &bucket = dict.buckets[b];
+    uint64_t len = bucket.wrd_len;
+    reach.clear();
+    for (size_t g = 0; g < set.groups.size(); g++) {
+      const MyersPatternGroup &group = set.groups[g];
+      if (uint64_t(group.max_len) + max_dist < len ||
+          uint64_t(group.min_len) > len + max_dist)
+        local.groups_skipped += bucket.n_words;
+      else
+        reach.push_back(g);
+    }
+    if (reach.empty())
+      continue;
+
+    for (uint32_t i = 0; i < bucket.n_words; i++) {
+      uint32_t idx = bucket.first + i;
+      encode_text(dict.words + dict.offsets[idx], len, syms);
+      for (uint32_t g : reach) {
+        const MyersPatternGroup &group = set.groups[g];
+        local.groups_run++;
+        scan_group(set, g, syms.data(), len, out);
+        for (int k = 0; k < group.n_lanes; k++) {
+          if (out[k] <= max_dist) {
+            matches.push_back(
+                {set.ids[group.first + k], dict.ids[idx], out[k]});
+            local.matches++;
+          }
+        }
+      }
+    }
+  }
+
+  if (stats) {
+    stats->groups_run += local.groups_run;
+    stats->groups_skipped += local.groups_skipped;
+    stats->matches += local.matches;
+  }
+}
@@ -0,0 +1,105 @@
+#include "levenshtein_bio.hpp"
+#include <algorithm>
+#include <arm_neon.h>
+
+// Code of each letter, or -1; built from MYERS_PROTEIN_ALPHABET
+static const struct ProteinCodes {
+  int8_t codes[256];
+  ProteinCodes() {
+    std::fill(std::begin(codes), std::end(codes), -1);
+    for (int i = 0; i < MYERS_PROTEIN_LEN; i++) {
+      char c = MYERS_PROTEIN_ALPHABET[i];
+      codes[(uint8_t)c] = i;
+      codes[(uint8_t)(c - 'A' + 'a')] = i;
+    }
+  }
+} PROTEIN_CODES;
+
+bool levenshtein_protein_encode(const char *seq, int len, uint8_t *codes) {
+  for (int i = 0; i < len; i++) {
+    int8_t code = PROTEIN_CODES.codes[(uint8_t)seq[i]];
+    if (code < 0)
+      return false;
+    codes[i] = code;
+  }
+  return true;
+}
+
+uint32_t levenshtein_protein_64x1(const uint8_t *q_codes, int q_len,
+                                  const uint8_t *d_codes, int d_len) {
+  if (q_len == 0)
+    return d_len;
+
+  uint64_t bm[MYERS_PROTEIN_LEN] = {0};
+  for (int i = 0; i < q_len; i++) {
+    bm[q_codes[i]] |= (uint64_t(1) << i);
+  }
+
+  uint64_t vp = ~0ULL;
+  uint64_t vn = 0;
+  uint64_t hi_bit = uint64_t(1) << (q_len - 1);
+  uint32_t score = q_len;
+
+  for (int i = 0; i < d_len; i++) {
+    uint64_t x = bm[d_codes[i]] | vn;
+    uint64_t d0 = ((vp + (x & vp)) ^ vp) | x;
+    uint64_t hn = vp & d0;
+    uint64_t hp = vn | ~(vp | d0);
+    uint64_t y = (hp << 1) | 1;
+    vn = y & d0;
+    vp = (hn << 1) | ~(y | d0);
+
+    if ((hp & hi_bit) != 0) {
+      score++;
+    } else if ((hn & hi_bit) != 0) {
+      score--;
+    }
+  }
+
+  return score;
+}
+
+std::array<uint64_t, 2>
+levenshtein_protein_64x2(const MyersProtein64x2Input &input) {
+  if (input.q_len == 0)
+    return std::to_array(input.d_lens);
+
+  uint64_t bm[MYERS_PROTEIN_LEN] = {0};
+  for (int i = 0; i < input.q_len; i++) {
+    bm[input.q_codes[i]] |= (uint64_t(1) << i);
+  }
+
+  const uint64x2_t one = vdupq_n_u64(1);
+  const uint64x2_t ones = vdupq_n_u64(~0ULL);
+  uint64x2_t scores = vdupq_n_u64(input.q_len);
+  uint64x2_t vp = ones;
+  uint64x2_t vn = vdupq_n_u64(0);
+  uint64x2_t hi_bit = vdupq_n_u64(uint64_t(1) << (input.q_len - 1));
+  uint64x2_t d_lens = vld1q_u64(input.d_lens);
+  uint64_t max_d_len = std::max(input.d_lens[0], input.d_lens[1]);
+
+  for (uint64_t i = 0; i < max_d_len; i++) {
+    // A lane past its length reads its last residue again; its score is
+    // frozen below
+    uint64_t i0 = std::min(i, input.d_lens[0] - 1);
+    uint64_t i1 = std::min(i, input.d_lens[1] - 1);
+    uint64x2_t eq = {input.d_lens[0] ? bm[input.d_codes[0][i0]] : 0,
+                     input.d_lens[1] ? bm[input.d_codes[1][i1]] : 0};
+
+    uint64x2_t x = vorrq_u64(eq, vn);
+    uint64x2_t d0 =
+        vorrq_u64(veorq_u64(vaddq_u64(vandq_u64(vp, x), vp), vp), x);
+    uint64x2_t hn = vandq_u64(vp, d0);
+    uint64x2_t hp = vorrq_u64(vn, veorq_u64(vorrq_u64(vp, d0), ones));
+    uint64x2_t y = vorrq_u64(vshlq_n_u64(hp, 1), one);
+    vn = vandq_u64(y, d0);
+    vp = vorrq_u64(vshlq_n_u64(hn, 1), veorq_u64(vorrq_u64(y, d0), ones));
+
+    uint64x2_t active = vcltq_u64(vdupq_n_u64(i), d_lens);
+    scores = vsubq_u64(scores, vandq_u64(active, vtstq_u64(hp, hi_bit)));
+    scores = vaddq_u64(scores, vandq_u64(active, vtstq_u64(hn, hi_bit)));
+  }
+
+  return std::array<uint64_t, 2>{vgetq_lane_u64(scores, 0),
+                                 vgetq_lane_u64(scores, 1)};
+}
@@ -0,0 +1,238 @@
+#include "levenshtein_qgram.hpp"
+#include "levenshtein_batch.hpp"
+#include <numeric>
+
+static bool fail(std::string *error, const char *msg) {
+  if (error)
+    *error = msg;
+  return false;
+}
+
+static uint32_t gram_code(const char *s, int q) {
+  uint32_t code = 0;
+  for (int i = 0; i < q; i++)
+    code = code * ALPHABET_LEN + (s[i] - 'a');
+  return code;
+}
+
+static void put_varint(std::vector<uint8_t> &out, uint32_t v) {
+  while (v >= 0x80) {
+    out.push_back(uint8_t(v) | 0x80);
+    v >>= 7;
+  }
+  out.push_back(v);
+}
+
+static inline uint32_t get_varint(const uint8_t *&p) {
+  uint32_t v = 0;
+  for (int shift = 0;; shift += 7) {
+    uint8_t b = *p++;
+    v |= uint32_t(b & 0x7F) << shift;
+    if (!(b & 0x80))
+      return v;
+  }
+}
+
+// Grams of `s` with their number of occurrences, sorted by code
+static void count_grams(const char *s, int len, int q,
+                        std::vector<std::pair<uint32_t, uint32_t>> &grams) {
+  grams.clear();
+  for (int i = 0; i + q <= len; i++)
+    grams.push_back({gram_code(s + i, q), 1});
+  std::sort(grams.begin(), grams.end());
+  size_t out = 0;
+  for (size_t i = 0; i < grams.size(); i++) {
+    if (out > 0 && grams[out - 1].first == grams[i].first)
+      grams[out - 1].second++;
+    else
+      grams[out++] = grams[i];
+  }
+  grams.resize(out);
+}
+
+bool levenshtein_qgram_build(const std::vector<std::string> &strs, int q,
+                             MyersQgramIndex &index, std::string *error) {
+  if (q < MYERS_QGRAM_MIN_Q || q > MYERS_QGRAM_MAX_Q)
+    return fail(error, "q out of range");
+  for (const auto &s : strs) {
+    for (char c : s) {
+      if (c < 'a' || c > 'z')
+        return fail(error, "strings must consist of a-z only");
+    }
+  }
+
+  index.q = q;
+  index.n_strs = strs.size();
+  index.ids.resize(strs.size());
+  std::iota(index.ids.begin(), index.ids.end(), 0);
+  std::stable_sort(index.ids.begin(), index.ids.end(),
+                   [&](uint32_t a, uint32_t b) {
+                     return strs[a].size() < strs[b].size();
+                   });
+  index.max_len = strs.empty() ? 0 : strs[index.ids.back()].size();
+
+  index.offsets.assign(1, 0);
+  index.data.clear();
+  index.len_first.assign(index.max_len + 2, 0);
+  for (uint32_t id : index.ids) {
+    const std::string &s = strs[id];
+    index.data.insert(index.data.end(), s.begin(), s.end());
+    index.offsets.push_back(index.data.size());
+    index.len_first[s.size() + 1]++;
+  }
+  index.data.insert(index.data.end(), index.max_len, 'a');
+  std::partial_sum(index.len_first.begin(), index.len_first.end(),
+                   index.len_first.begin());
+
+  // Counting pass, then bucket the (id, count) entries per gram
+  uint32_t n_grams = 1;
+  for (int i = 0; i < q; i++)
+    n_grams *= ALPHABET_LEN;
+  std::vector<std::pair<uint32_t, uint32_t>> grams;
+  std::vector<uint64_t> starts(n_grams + 1, 0);
+  for (uint32_t i = 0; i < index.n_strs; i++) {
+    count_grams(&index.data[index.offsets[i]],
+                index.offsets[i + 1] - index.offsets[i], q, grams);
+    for (const auto &g : grams)
+      starts[g.first + 1]++;
+  }
+  std::partial_sum(starts.begin(), starts.end(), starts.begin());
+
+  std::vector<std::pair<uint32_t, uint32_t>> entries(starts.back());
+  std::vector<uint64_t> fill(starts.begin(), starts.end() - 1);
+  for (uint32_t i = 0; i < index.n_strs; i++) {
+    count_grams(&index.data[index.offsets[i]],
+                index.offsets[i + 1] - index.offsets[i], q, grams);
+    for (const auto &g : grams)
+      entries[fill[g.first]++] = {i, g.second};
+  }
+
+  // Ids ascend within each list, so they are stored as deltas
+  index.postings.clear();
+  index.gram_offsets.assign(n_grams + 1, 0);
+  for (uint32_t g = 0; g < n_grams; g++) {
+    index.gram_offsets[g] = index.postings.size();
+    uint32_t prev = 0;
+    for (uint64_t e = starts[g]; e < starts[g + 1]; e++) {
+      put_varint(index.postings, entries[e].first - prev);
+      put_varint(index.postings, entries[e].second);
+      prev = entries[e].first;
+    }
+  }
+  index.gram_offsets[n_grams] = index.postings.size();
+  index.postings.shrink_to_fit();
+  return true;
+}
+
+size_t levenshtein_qgram_memory(const MyersQgramIndex &index) {
+  return index.data.capacity() + index.postings.capacity() +
+         index.offsets.capacity() * sizeof(uint64_t) +
+         index.gram_offsets.capacity() * sizeof(uint64_t) +
+         (index.ids.capacity() + index.len_first.capacity()) *
+             sizeof(uint32_t);
+}
+
+// Verify the sorted ids in `candidates` (ascending, so grouped by length)
+static void verify(const MyersQgramIndex &index, const char *q_wrd,
+                   int q_wrd_len, uint32_t max_dist,
+                   const std::vector<uint32_t> &candidates,
+                   std::vector<MyersScanMatch> &matches,
+                   MyersQgramStats &local) {
+  std::vector<const char *> wrds;
+  std::vector<int> lens;
+  std::vector<uint32_t> distances;
+  for (size_t i = 0; i < candidates.size();) {
+    int len = index.offsets[candidates[i] + 1] - index.offsets[candidates[i]];
+    size_t j = i;
+    wrds.clear();
+    lens.clear();
+    for (; j < candidates.size(); j++) {
+      uint32_t id = candidates[j];
+      if ((int)(index.offsets[id + 1] - index.offsets[id]) != len)
+        break;
+      wrds.push_back(&index.data[index.offsets[id]]);
+      lens.push_back(len);
+    }
+    distances.resize(wrds.size());
+    levenshtein_batch_bounded(levenshtein_batch_width(q_wrd_len, len), q_wrd,
+                              q_wrd_len, wrds.data(), lens.data(),
+                              wrds.size(), max_dist, distances.data());
+    local.verified += wrds.size();
+    for (size_t k = 0; k < wrds.size(); k++) {
+      if (distances[k] <= max_dist) {
+        matches.push_back({index.ids[candidates[i + k]], distances[k]});
+        local.matches++;
+      }
+    }
+    i = j;
+  }
+}
+
+void levenshtein_qgram_search(const MyersQgramIndex &index, const char *q_wrd,
+                              int q_wrd_len, uint32_t max_dist,
+                              std::vector<MyersScanMatch> &matches,
+                              MyersQgramStats *stats) {
+  MyersQgramStats local = {};
+  if (index.n_strs == 0)
+    return;
+
+  // Length window as a range of sorted ids
+  int64_t lo_len = std::max<int64_t>(0, (int64_t)q_wrd_len - max_dist);
+  int64_t hi_len = std::min<int64_t>(index.max_len,
+                                     (int64_t)q_wrd_len + max_dist);
+  if (lo_len > hi_len)
+    return;
+  uint32_t lo = index.len_first[lo_len];
+  uint32_t hi = index.len_first[hi_len + 1];
+
+  std::vector<uint32_t> candidates;
+  int64_t threshold =
+      (int64_t)q_wrd_len - index.q + 1 - (int64_t)max_dist * index.q;
+  if (threshold <= 0) {
+    candidates.resize(hi - lo);
+    std::iota(candidates.begin(), candidates.end(), lo);
+  } else {
+    // Shared-gram counters, reused across calls on this thread. Only the
+    // touched entries are reset, so a query costs its posting lists
+    thread_local std::vector<uint32_t> counts;
+    thread_local std::vector<uint32_t> touched;
+    counts.resize(index.n_strs);
+    touched.clear();
+
+    std::vector<std::pair<uint32_t, uint32_t>> grams;
+    count_grams(q_wrd, q_wrd_len, index.q, grams);
+    for (const auto &g : grams) {
+      const uint8_t *p = index.postings.data() + index.gram_offsets[g.first];
+      const uint8_t *end =
+          index.postings.data() + index.gram_offsets[g.first + 1];
+      uint32_t id = 0;
+      while (p < end) {
+        id += get_varint(p);
+        uint32_t occurrences = get_varint(p);
+        local.postings++;
+        if (id < lo)
+          continue;
+        if (id >= hi)
+          break;
+        if (counts[id] == 0)
+          touched.push_back(id);
+        counts[id] += std::min(occurrences, g.second);
+      }
+    }
+
+    for (uint32_t id : touched) {
+      if (counts[id] >= threshold)
+        candidates.push_back(id);
+      counts[id] = 0;
+    }
+    std::sort(candidates.begin(), candidates.end());
+  }
+
+  verify(index, q_wrd, q_wrd_len, max_dist, candidates, matches, local);
+
+  if (stats) {
+    stats->postings += local.postings;
+    stats->verified += local.verified;
+    stats->matches += local.matches;
+  }
+}
@@ -0,0 +1,187 @@
+#include "levenshtein_ratio.hpp"
+#include "levenshtein_batch.hpp"
+#include "levenshtein_trim.hpp"
+#include <cmath>
+
+uint32_t levenshtein_ratio_max_dist(int len, double score_cutoff) {
+  if (score_cutoff <= 0)
+    return len;
+  // The epsilon keeps cutoffs such as 0.8 * 10 from flooring to one less
+  double slack = std::floor((1.0 - score_cutoff) * len + 1e-9);
+  return slack <= 0 ? 0 : std::min<uint32_t>(slack, len);
+}
+
+// Score of a distance `dist` over `len` characters, or 0 if it does not
+// reach the cutoff
+static double score(uint32_t dist, int len, double score_cutoff) {
+  if (dist > levenshtein_ratio_max_dist(len, score_cutoff))
+    return 0;
+  double s = len == 0 ? 1.0 : 1.0 - double(dist) / len;
+  return s >= score_cutoff ? s : 0;
+}
+
+double levenshtein_ratio(const char *a, int a_len, const char *b, int b_len,
+                         double score_cutoff) {
+  if (a_len > b_len) {
+    std::swap(a, b);
+    std::swap(a_len, b_len);
+  }
+  if (b_len == 0)
+    return score(0, 0, score_cutoff);
+  uint32_t max_dist = levenshtein_ratio_max_dist(b_len, score_cutoff);
+  uint32_t d =
+      levenshtein_myers_bounded_trimmed(a, a_len, b, b_len, max_dist, nullptr);
+  return score(d, b_len, score_cutoff);
+}
+
+// Multi-word semi-global recurrence: like anyx1, but the first row is all
+// zeros (no carry into the lowest bit), and the minimum of the last row is
+// kept. Returns early once it reaches 0.
+static uint32_t semi_global_anyx1(const char *p, int p_len, const char *t,
+                                  int t_len) {
+  thread_local MyersWorkspace ws;
+  levenshtein_workspace_reserve(ws, p_len);
+  size_t words = (p_len + 63) / 64;
+  size_t stride = ws.words;
+  uint64_t *peq = ws.peq.data();
+  uint64_t *vp = ws.vp.data();
+  uint64_t *vn = ws.vn.data();
+  std::fill(vp, vp + words, ~0ULL);
+  std::fill(vn, vn + words, 0);
+  for (int i = 0; i < p_len; i++)
+    peq[(uint8_t)p[i] * stride + i / 64] |= uint64_t(1) << (i % 64);
+
+  size_t hi_word = (p_len - 1) / 64;
+  uint64_t hi_bit = uint64_t(1) << ((p_len - 1) % 64);
+  uint32_t score = p_len, best = p_len;
+  for (int j = 0; j < t_len && best > 0; j++) {
+    const uint64_t *eq = &peq[(uint8_t)t[j] * stride];
+    uint64_t add_carry = 0, hp_carry = 0, hn_carry = 0;
+    for (size_t w = 0; w < words; w++) {
+      uint64_t x = eq[w] | vn[w];
+      uint64_t a = x & vp[w];
+      uint64_t sum = a + vp[w];
+      uint64_t carry = sum < a;
+      sum += add_carry;
+      add_carry = carry | (sum < add_carry);
+
+      uint64_t d = (sum ^ vp[w]) | x;
+      uint64_t hn = vp[w] & d;
+      uint64_t hp = vn[w] | ~(vp[w] | d);
+
+      uint64_t y = (hp << 1) | hp_carry;
+      hp_carry = hp >> 63;
+      vn[w] = y & d;
+      vp[w] = (hn << 1) | hn_carry | ~(y | d);
+      hn_carry = hn >> 63;
+
+      if (w == hi_word) {
+        if ((hp & hi_bit) != 0) {
+          score++;
+        } else if ((hn & hi_bit) != 0) {
+          score--;
+        }
+      }
+    }
+    best = std::min(best, score);
+  }
+
+  for (int i = 0; i < p_len; i++)
+    peq[(uint8_t)p[i] * stride + i / 64] = 0;
+  return best;
+}
+
+// Text fed to the search kernel per call
+#define RATIO_SEARCH_BLOCK 256
+
+// Smallest distance from the pattern to any substring of the text; values
+// above `max_dist` may be reported as any larger value. After each block
+// the kernel's bound drops to one below the best score so far, so only
+// improvements are reported and at most one block of hits is buffered.
+static uint32_t semi_global(const char *p, int p_len, const char *t,
+                            int t_len, uint32_t max_dist) {
+  if (p_len > 64)
+    return semi_global_anyx1(p, p_len, t, t_len);
+
+  thread_local MyersSearch64x1State state;
+  thread_local std::vector<MyersSearchHit> hits;
+  levenshtein_myers_search_64x1_init(state, p, p_len, max_dist);
+  uint32_t best = max_dist + 1;
+  for (int pos = 0; pos < t_len && best > 0; pos += RATIO_SEARCH_BLOCK) {
+    hits.clear();
+    levenshtein_myers_search_64x1(state, t + pos,
+                                  std::min(RATIO_SEARCH_BLOCK, t_len - pos),
+                                  hits);
+    for (const auto &hit : hits)
+      best = std::min(best, hit.distance);
+    state.max_dist = best - 1;
+  }
+  return best;
+}
+
+double levenshtein_partial_ratio(const char *a, int a_len, const char *b,
+                                 int b_len, double score_cutoff) {
+  if (a_len > b_len) {
+    std::swap(a, b);
+    std::swap(a_len, b_len);
+  }
+  if (a_len == 0)
+    return b_len == 0 ? score(0, 0, score_cutoff) : 0;
+  uint32_t max_dist = levenshtein_ratio_max_dist(a_len, score_cutoff);
+  return score(semi_global(a, a_len, b, b_len, max_dist), a_len,
+               score_cutoff);
+}
+
+// Batch ratio with the scores handed to store(i, score)
+template <typename F>
+static void ratio_batch(const char *q_wrd, int q_wrd_len,
+                        const char *const *d_wrds, const int *d_wrd_lens,
+                        size_t n, double score_cutoff, F store) {
+  if (q_wrd_len == 0) {
+    for (size_t i = 0; i < n; i++)
+      store(i, score(d_wrd_lens[i], d_wrd_lens[i], score_cutoff));
+    return;
+  }
+
+  int max_len = q_wrd_len;
+  for (size_t i = 0; i < n; i++)
+    max_len = std::max(max_len, d_wrd_lens[i]);
+  // One bound for the whole batch: the most any pair may be off by
+  uint32_t max_dist = levenshtein_ratio_max_dist(max_len, score_cutoff);
+  if (max_dist >= (uint32_t)max_len)
+    max_dist = UINT32_MAX;
+
+  thread_local std::vector<uint32_t> distances;
+  distances.resize(n);
+  levenshtein_batch_copied(levenshtein_batch_width(q_wrd_len, 0), q_wrd,
+                           q_wrd_len, d_wrds, d_wrd_lens, uint32_t(n),
+                           max_dist, distances.data());
+  for (size_t i = 0; i < n; i++)
+    store(i, score(distances[i], std::max(q_wrd_len, d_wrd_lens[i]),
+                   score_cutoff));
+}
+
+void levenshtein_ratio(const char *q_wrd, int q_wrd_len,
+                       const char *const *d_wrds, const int *d_wrd_lens,
+                       size_t n, double score_cutoff, float *scores) {
+  ratio_batch(q_wrd, q_wrd_len, d_wrds, d_wrd_lens, n, score_cutoff,
+              [&](size_t i, double s) { scores[i] = float(s); });
+}
+
+void levenshtein_ratio_u8(const char *q_wrd, int q_wrd_len,
+                          const char *const *d_wrds, const int *d_wrd_lens,
+                          size_t n, double score_cutoff, uint8_t *scores) {
+  ratio_batch(q_wrd, q_wrd_len, d_wrds, d_wrd_lens, n, score_cutoff,
+              [&](size_t i, double s) {
+                scores[i] = uint8_t(std::lround(s * UINT8_MAX));
+              });
+}
+
+void levenshtein_partial_ratio(const char *q_wrd, int q_wrd_len,
+                               const char *const *d_wrds,
+                               const int *d_wrd_lens, size_t n,
+                               double score_cutoff, float *scores) {
+  for (size_t i = 0; i < n; i++)
+    scores[i] = float(levenshtein_partial_ratio(
+        q_wrd, q_wrd_len, d_wrds[i], d_wrd_lens[i], score_cutoff));
+}
@@ -0,0 +1,190 @@
+#include "levenshtein_symspell.hpp"
+#include "levenshtein_batch.hpp"
+
+static bool fail(std::string *error, const char *msg) {
+  if (error)
+    *error = msg;
+  return false;
+}
+
+// FNV-1a followed by a splitmix64 finalizer, so the low bits used for the
+// slot index are well mixed
+static uint64_t variant_hash(const char *s, int len) {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (int i = 0; i < len; i++) {
+    h ^= (uint8_t)s[i];
+    h *= 0x100000001b3ULL;
+  }
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+  return h;
+}
+
+// Hashes of all strings reachable from `s` with at most `k` deletions,
+// including `s` itself, sorted and without duplicates
+static void deletion_variants(const char *s, int len, uint32_t k,
+                              std::vector<uint64_t> &hashes) {
+  hashes.clear();
+  char buf[MYERS_SYMSPELL_MAX_LEN + MYERS_SYMSPELL_MAX_DIST];
+  std::copy(s, s + len, buf);
+
+  // Depth-first over deletion positions in ascending order; deleting
+  // position p then a later one reaches every subset exactly once
+  auto recurse = [&](auto &self, int cur_len, int from, uint32_t left) -> void {
+    hashes.push_back(variant_hash(buf, cur_len));
+    if (left == 0)
+      return;
+    for (int p = from; p < cur_len; p++) {
+      char removed = buf[p];
+      std::copy(buf + p + 1, buf + cur_len, buf + p);
+      self(self, cur_len - 1, p, left - 1);
+      std::copy_backward(buf + p, buf + cur_len - 1, buf + cur_len);
+      buf[p] = removed;
+    }
+  };
+  recurse(recurse, len, 0, k);
+
+  std::sort(hashes.begin(), hashes.end());
+  hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+}
+
+bool levenshtein_symspell_build(const std::vector<std::string> &words,
+                                uint32_t max_dist, MyersSymSpellIndex &index,
+                                std::string *error) {
+  if (max_dist > MYERS_SYMSPELL_MAX_DIST)
+    return fail(error, "max_dist out of range");
+  for (const auto &w : words) {
+    if (w.size() > MYERS_SYMSPELL_MAX_LEN)
+      return fail(error, "word too long");
+    for (char c : w) {
+      if (c < 'a' || c > 'z')
+        return fail(error, "words must consist of a-z only");
+    }
+  }
+
+  index.max_dist = max_dist;
+  index.n_words = words.size();
+  index.words.assign(words.size() * MYERS_SYMSPELL_MAX_LEN, 'a');
+  index.lens.resize(words.size());
+  for (size_t i = 0; i < words.size(); i++) {
+    std::copy(words[i].begin(), words[i].end(),
+              index.words.begin() + i * MYERS_SYMSPELL_MAX_LEN);
+    index.lens[i] = words[i].size();
+  }
+
+  // (variant hash, word) pairs, grouped by hash
+  std::vector<std::pair<uint64_t, uint32_t>> pairs;
+  std::vector<uint64_t> hashes;
+  for (uint32_t i = 0; i < index.n_words; i++) {
+    deletion_variants(words[i].data(), words[i].size(), max_dist, hashes);
+    for (uint64_t h : hashes)
+      pairs.push_back({h, i});
+  }
+  std::sort(pairs.begin(), pairs.end());
+
+  size_t n_keys = 0;
+  for (size_t i = 0; i < pairs.size(); i++)
+    n_keys += i == 0 || pairs[i].first != pairs[i - 1].first;
+
+  // Keep the load factor at or below 1/2
+  size_t n_slots = 16;
+  while (n_slots < 2 * n_keys)
+    n_slots *= 2;
+  index.slots.assign(n_slots, {0, UINT32_MAX});
+  index.postings.clear();
+  index.postings.reserve(n_keys + pairs.size());
+
+  for (size_t i = 0; i < pairs.size();) {
+    uint64_t h = pairs[i].first;
+    size_t j = i;
+    while (j < pairs.size() && pairs[j].first == h)
+      j++;
+
+    size_t slot = h & (n_slots - 1);
+    while (index.slots[slot].start != UINT32_MAX)
+      slot = (slot + 1) & (n_slots - 1);
+    index.slots[slot] = {uint32_t(h >> 32), (uint32_t)index.postings.size()};
+
+    index.postings.push_back(j - i);
+    for (size_t k = i; k < j; k++)
+      index.postings.push_back(pairs[k].second);
+    i = j;
+  }
+  return true;
+}
+
+size_t levenshtein_symspell_memory(const MyersSymSpellIndex &index) {
+  return index.words.capacity() + index.lens.capacity() +
+         index.slots.capacity() * sizeof(MyersSymSpellSlot) +
+         index.postings.capacity() * sizeof(uint32_t);
+}
+
+void levenshtein_symspell_lookup(const MyersSymSpellIndex &index,
+                                 const char *q_wrd, int q_wrd_len,
+                                 uint32_t max_dist,
+                                 std::vector<MyersScanMatch> &matches,
+                                 MyersSymSpellStats *stats) {
+  MyersSymSpellStats local = {};
+  max_dist = std::min(max_dist, index.max_dist);
+  // Longer queries cannot reach any word
+  if (index.n_words == 0 ||
+      q_wrd_len > MYERS_SYMSPELL_MAX_LEN + (int)max_dist)
+    return;
+
+  // Scratch reused across lookups on this thread
+  thread_local std::vector<uint64_t> hashes;
+  thread_local std::vector<uint32_t> candidates;
+  thread_local std::vector<const char *> wrds;
+  thread_local std::vector<int> lens;
+  thread_local std::vector<uint32_t> distances;
+
+  deletion_variants(q_wrd, q_wrd_len, max_dist, hashes);
+  candidates.clear();
+  size_t mask = index.slots.size() - 1;
+  for (uint64_t h : hashes) {
+    local.probes++;
+    uint32_t fingerprint = h >> 32;
+    for (size_t slot = h & mask; index.slots[slot].start != UINT32_MAX;
+         slot = (slot + 1) & mask) {
+      if (index.slots[slot].fingerprint != fingerprint)
+        continue;
+      const uint32_t *list = &index.postings[index.slots[slot].start];
+      candidates.insert(candidates.end(), list + 1, list + 1 + list[0]);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                   candidates.end());
+  local.candidates += candidates.size();
+
+  if (!candidates.empty()) {
+    wrds.resize(candidates.size());
+    lens.resize(candidates.size());
+    distances.resize(candidates.size());
+    for (size_t i = 0; i < candidates.size(); i++) {
+      wrds[i] = &index.words[size_t(candidates[i]) * MYERS_SYMSPELL_MAX_LEN];
+      lens[i] = index.lens[candidates[i]];
+    }
+    // Every word fits in its 16-byte slot, so the kernels never read past
+    // the word table
+    levenshtein_batch_bounded(
+        levenshtein_batch_width(q_wrd_len, MYERS_SYMSPELL_MAX_LEN), q_wrd,
+        q_wrd_len, wrds.data(), lens.data(), candidates.size(), max_dist,
+        distances.data());
+    for (size_t i = 0; i < candidates.size(); i++) {
+      if (distances[i] <= max_dist) {
+        matches.push_back({candidates[i], distances[i]});
+        local.matches++;
+      }
+    }
+  }
+
+  if (stats) {
+    stats->probes += local.probes;
+    stats->candidates += local.candidates;
+    stats->matches += local.matches;
+  }
+}
@@ -0,0 +1,139 @@
+#include "levenshtein_trim.hpp"
+#include <algorithm>
+#include <arm_neon.h>
+
+size_t levenshtein_common_prefix(const char *a, size_t a_len, const char *b,
+                                 size_t b_len) {
+  size_t n = std::min(a_len, b_len);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    uint8x16_t eq = vceqq_u8(vld1q_u8((const uint8_t *)a + i),
+                             vld1q_u8((const uint8_t *)b + i));
+    if (vminvq_u8(eq) != 0xFF)
+      break;
+  }
+  while (i < n && a[i] == b[i])
+    i++;
+  return i;
+}
+
+size_t levenshtein_common_suffix(const char *a, size_t a_len, const char *b,
+                                 size_t b_len) {
+  size_t n = std::min(a_len, b_len);
+  const uint8_t *a_end = (const uint8_t *)a + a_len;
+  const uint8_t *b_end = (const uint8_t *)b + b_len;
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    uint8x16_t eq = vceqq_u8(vld1q_u8(a_end - i - 16), vld1q_u8(b_end - i - 16));
+    if (vminvq_u8(eq) != 0xFF)
+      break;
+  }
+  while (i < n && a_end[-1 - (ptrdiff_t)i] == b_end[-1 - (ptrdiff_t)i])
+    i++;
+  return i;
+}
+
+// Single-pair kernels by query length: 32x1, 64x1, anyx1. 128x1 is not
+// implemented yet and is skipped.
+static int kernel_class(int q_wrd_len) {
+  if (q_wrd_len <= 32)
+    return 0;
+  if (q_wrd_len <= 64)
+    return 1;
+  return 2;
+}
+
+static void count(MyersTrimStats *stats, uint64_t pairs, size_t trimmed,
+                  bool downgraded) {
+  if (!stats)
+    return;
+  stats->pairs += pairs;
+  if (trimmed > 0)
+    stats->trimmed += pairs;
+  stats->bytes_trimmed += trimmed * pairs;
+  if (downgraded)
+    stats->downgraded += pairs;
+}
+
+uint32_t levenshtein_myers_trimmed(const char *q_wrd, int q_wrd_len,
+                                   const char *d_wrd, int d_wrd_len,
+                                   MyersTrimStats *stats) {
+  size_t prefix = levenshtein_common_prefix(q_wrd, q_wrd_len, d_wrd, d_wrd_len);
+  size_t suffix = levenshtein_common_suffix(q_wrd + prefix, q_wrd_len - prefix,
+                                            d_wrd + prefix, d_wrd_len - prefix);
+  int q_len = q_wrd_len - prefix - suffix;
+  int d_len = d_wrd_len - prefix - suffix;
+  q_wrd += prefix;
+  d_wrd += prefix;
+
+  int cls = kernel_class(q_len);
+  count(stats, 1, prefix + suffix, cls != kernel_class(q_wrd_len));
+  switch (cls) {
+  case 0:
+    return levenshtein_myers_32x1(q_wrd, q_len, d_wrd, d_len);
+  case 1:
+    return levenshtein_myers_64x1(q_wrd, q_len, d_wrd, d_len);
+  default:
+    return levenshtein_myers_anyx1(q_wrd, q_len, d_wrd, d_len);
+  }
+}
+
+uint32_t levenshtein_myers_bounded_trimmed(const char *q_wrd, int q_wrd_len,
+                                           const char *d_wrd, int d_wrd_len,
+                                           uint32_t max_dist,
+                                           MyersTrimStats *stats) {
+  size_t prefix = levenshtein_common_prefix(q_wrd, q_wrd_len, d_wrd, d_wrd_len);
+  size_t suffix = levenshtein_common_suffix(q_wrd + prefix, q_wrd_len - prefix,
+                                            d_wrd + prefix, d_wrd_len - prefix);
+  count(stats, 1, prefix + suffix, false);
+  return levenshtein_myers_anyx1_bounded(
+      q_wrd + prefix, q_wrd_len - prefix - suffix, d_wrd + prefix,
+      d_wrd_len - prefix - suffix, max_dist);
+}
+
+// Strip the affix shared by the query and every lane. Each lane only has to
+// be compared up to the shortest affix found so far.
+template <typename Input>
+static Input trim_batch(const Input &input, int lanes, MyersTrimStats *stats) {
+  size_t prefix = input.q_wrd_len;
+  for (int k = 0; k < lanes && prefix > 0; k++)
+    prefix = levenshtein_common_prefix(input.q_wrd, prefix, input.d_wrds[k],
+                                       input.d_wrd_lens[k]);
+
+  size_t suffix = input.q_wrd_len - prefix;
+  for (int k = 0; k < lanes && suffix > 0; k++)
+    suffix = levenshtein_common_suffix(
+        input.q_wrd + input.q_wrd_len - suffix, suffix,
+        input.d_wrds[k] + prefix, input.d_wrd_lens[k] - prefix);
+
+  count(stats, lanes, prefix + suffix, false);
+
+  Input out = input;
+  out.q_wrd += prefix;
+  out.q_wrd_len -= prefix + suffix;
+  for (int k = 0; k < lanes; k++) {
+    out.d_wrds[k] += prefix;
+    out.d_wrd_lens[k] -= prefix + suffix;
+  }
+  return out;
+}
+
+std::array<uint8_t, 16> levenshtein_myers_8x16_trimmed(
+    const Myers8x16Input &input, MyersTrimStats *stats) {
+  return levenshtein_myers_8x16(trim_batch(input, 16, stats));
+}
+
+std::array<uint16_t, 8> levenshtein_myers_16x8_trimmed(
+    const Myers16x8Input &input, MyersTrimStats *stats) {
+  return levenshtein_myers_16x8(trim_batch(input, 8, stats));
+}
+
+std::array<uint32_t, 4> levenshtein_myers_32x4_trimmed(
+    const Myers32x4Input &input, MyersTrimStats *stats) {
+  return levenshtein_myers_32x4(trim_batch(input, 4, stats));
+}
+
+std::array<uint64_t, 2> levenshtein_myers_64x2_trimmed(
+    const Myers64x2Input &input, MyersTrimStats *stats) {
+  return levenshtein_myers_64x2(trim_batch(input, 2, stats));
+}
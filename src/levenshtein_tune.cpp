@@ -0,0 +1,266 @@
+#include "levenshtein_tune.hpp"
+#include "levenshtein_batch.hpp"
+#include "levenshtein_trim.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <sys/sysctl.h>
+#endif
+
+// Pattern length each class is timed at: its longest pattern, and 128 for
+// the open-ended class
+static const int TUNE_LEN[MYERS_PLAN_CLASSES] = {8, 16, 32, 64, 128};
+
+// Words per measurement; a multiple of every lane count
+#define TUNE_WORDS 64
+
+static bool fail(std::string *error, const char *msg) {
+  if (error)
+    *error = msg;
+  return false;
+}
+
+static std::string trim(const std::string &s) {
+  size_t b = s.find_first_not_of(" \t");
+  size_t e = s.find_last_not_of(" \t\r");
+  return b == std::string::npos ? "" : s.substr(b, e - b + 1);
+}
+
+std::string levenshtein_cpu_id() {
+#ifdef __APPLE__
+  char buf[256];
+  size_t len = sizeof(buf);
+  if (sysctlbyname("machdep.cpu.brand_string", buf, &len, nullptr, 0) == 0)
+    return std::string(buf);
+  return "unknown";
+#else
+  // First processor only; AArch64 kernels report implementer and part,
+  // x86 ones a model name
+  std::ifstream in("/proc/cpuinfo");
+  std::string line, implementer, part, model;
+  while (std::getline(in, line)) {
+    if (line.empty() && (!part.empty() || !model.empty()))
+      break;
+    size_t colon = line.find(':');
+    if (colon == std::string::npos)
+      continue;
+    std::string key = trim(line.substr(0, colon));
+    std::string value = trim(line.substr(colon + 1));
+    if (key == "CPU implementer")
+      implementer = value;
+    else if (key == "CPU part")
+      part = value;
+    else if (key == "model name")
+      model = value;
+  }
+  if (!part.empty())
+    return implementer + " " + part;
+  return model.empty() ? "unknown" : model;
+#endif
+}
+
+static bool fits(int kernel, int cls) {
+  return levenshtein_plan_class(levenshtein_kernel_max_len(kernel)) >= cls;
+}
+
+// Nanoseconds per word of `run`, which handles TUNE_WORDS words per call
+template <typename F> static double ns_per_word(F run, int budget_us) {
+  run(); // Warm up caches and branch predictors
+  auto start = std::chrono::steady_clock::now();
+  auto budget = std::chrono::microseconds(budget_us);
+  uint64_t reps = 0;
+  std::chrono::steady_clock::duration elapsed;
+  do {
+    run();
+    reps++;
+    elapsed = std::chrono::steady_clock::now() - start;
+  } while (elapsed < budget);
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+         (reps * TUNE_WORDS);
+}
+
+void levenshtein_tune(MyersPlan &plan, int budget_us) {
+  std::mt19937 rng(12345);
+  std::uniform_int_distribution<int> char_dist('a', 'z');
+  volatile uint32_t sink = 0;
+
+  for (int c = 0; c < MYERS_PLAN_CLASSES; c++) {
+    int len = TUNE_LEN[c];
+    std::string q(len, 'a');
+    std::vector<char> data(size_t(TUNE_WORDS + 1) * len);
+    for (auto &ch : q)
+      ch = char_dist(rng);
+    for (auto &ch : data)
+      ch = char_dist(rng);
+    const char *wrds[TUNE_WORDS];
+    int lens[TUNE_WORDS];
+    for (int i = 0; i < TUNE_WORDS; i++) {
+      wrds[i] = data.data() + size_t(i) * len;
+      lens[i] = len;
+    }
+    uint32_t out[TUNE_WORDS];
+
+    double times[MYERS_KERNEL_COUNT];
+    for (int k = 0; k < MYERS_KERNEL_COUNT; k++) {
+      times[k] = 1e300;
+      if (!fits(k, c))
+        continue;
+      int width = k == MYERS_KERNEL_8X16   ? 8
+                  : k == MYERS_KERNEL_16X8 ? 16
+                  : k == MYERS_KERNEL_32X4 ? 32
+                  : k == MYERS_KERNEL_64X2 ? 64
+                                           : 0;
+      times[k] = ns_per_word(
+          [&] {
+            if (width != 0) {
+              levenshtein_batch(width, q.data(), len, wrds, lens, TUNE_WORDS,
+                                out);
+              sink = sink + out[0];
+              return;
+            }
+            // Single pairs are timed with the affix scan the dispatcher
+            // runs before the kernel
+            for (int i = 0; i < TUNE_WORDS; i++) {
+              sink = sink + levenshtein_common_prefix(q.data(), len, wrds[i],
+                                                      len) +
+                     levenshtein_common_suffix(q.data(), len, wrds[i], len);
+              switch (k) {
+              case MYERS_KERNEL_32X1:
+                sink = sink + levenshtein_myers_32x1(q.data(), len, wrds[i],
+                                                     len);
+                break;
+              case MYERS_KERNEL_64X1:
+                sink = sink + levenshtein_myers_64x1(q.data(), len, wrds[i],
+                                                     len);
+                break;
+              default:
+                sink = sink + levenshtein_myers_anyx1_bounded(
+                                  q.data(), len, wrds[i], len, len);
+                break;
+              }
+            }
+          },
+          budget_us);
+    }
+
+    MyersPlanEntry &e = plan.classes[c];
+    e.single = MYERS_KERNEL_ANYX1;
+    for (int k = MYERS_KERNEL_32X1; k <= MYERS_KERNEL_ANYX1; k++) {
+      if (times[k] < times[e.single])
+        e.single = k;
+    }
+    e.batch = e.single;
+    for (int k = MYERS_KERNEL_8X16; k < MYERS_KERNEL_COUNT; k++) {
+      if (times[k] < times[e.batch])
+        e.batch = k;
+    }
+
+    // A batch kernel call costs the same however many lanes are filled; it
+    // pays off once it is cheaper than running that many words singly
+    e.min_batch = 0;
+    if (e.batch != e.single) {
+      int lanes = 128 / levenshtein_kernel_max_len(e.batch);
+      double call = times[e.batch] * lanes;
+      int n = 1;
+      while (n < lanes && n * times[e.single] < call)
+        n++;
+      e.min_batch = n;
+    }
+  }
+}
+
+bool levenshtein_plan_save(const MyersPlan &plan, const char *path,
+                           std::string *error) {
+  // Write a temporary file and rename it, so concurrent processes never
+  // read a partial plan. The name is unique to this writer (process id and
+  // a per-process counter), so concurrent savers never share a temporary.
+  static std::atomic<uint32_t> serial{0};
+  std::string tmp = std::string(path) + ".tmp." + std::to_string(getpid()) +
+                    "." + std::to_string(serial++);
+  {
+    std::ofstream out(tmp);
+    if (!out)
+      return fail(error, "cannot create plan file");
+    out << "levenshtein-plan " << MYERS_PLAN_VERSION << "\n";
+    out << "cpu " << levenshtein_cpu_id() << "\n";
+    for (int c = 0; c < MYERS_PLAN_CLASSES; c++) {
+      const MyersPlanEntry &e = plan.classes[c];
+      out << c << " " << levenshtein_kernel_name(e.single) << " "
+          << levenshtein_kernel_name(e.batch) << " " << e.min_batch << "\n";
+    }
+    if (!out.flush()) {
+      out.close();
+      std::remove(tmp.c_str());
+      return fail(error, "cannot write plan file");
+    }
+  }
+  if (std::rename(tmp.c_str(), path) != 0) {
+    std::remove(tmp.c_str());
+    return fail(error, "cannot rename plan file");
+  }
+  return true;
+}
+
+static int kernel_by_name(const std::string &name) {
+  for (int k = 0; k < MYERS_KERNEL_COUNT; k++) {
+    if (name == levenshtein_kernel_name(k))
+      return k;
+  }
+  return -1;
+}
+
+bool levenshtein_plan_load(MyersPlan &plan, const char *path,
+                           std::string *error) {
+  std::ifstream in(path);
+  if (!in)
+    return fail(error, "cannot open plan file");
+
+  std::string line, magic;
+  int version = 0;
+  if (!std::getline(in, line) ||
+      !(std::istringstream(line) >> magic >> version) ||
+      magic != "levenshtein-plan")
+    return fail(error, "not a plan file");
+  if (version != MYERS_PLAN_VERSION)
+    return fail(error, "unsupported plan version");
+
+  if (!std::getline(in, line) || line.compare(0, 4, "cpu ") != 0)
+    return fail(error, "missing cpu line");
+  if (line.substr(4) != levenshtein_cpu_id())
+    return fail(error, "plan was tuned on a different cpu");
+
+  MyersPlan loaded;
+  for (int c = 0; c < MYERS_PLAN_CLASSES; c++) {
+    int cls, min_batch;
+    std::string single, batch;
+    if (!std::getline(in, line) ||
+        !(std::istringstream(line) >> cls >> single >> batch >> min_batch) ||
+        cls != c || min_batch < 0 || min_batch > UINT16_MAX)
+      return fail(error, "malformed plan entry");
+    int s = kernel_by_name(single), b = kernel_by_name(batch);
+    if (s < 0 || b < 0)
+      return fail(error, "unknown kernel in plan");
+    loaded.classes[c] = {(uint8_t)s, (uint8_t)b, (uint16_t)min_batch};
+  }
+  if (!levenshtein_plan_valid(loaded))
+    return fail(error, "plan uses a kernel that does not fit its class");
+
+  plan = loaded;
+  return true;
+}
+
+bool levenshtein_plan_init(const char *path, std::string *error) {
+  MyersPlan plan;
+  if (levenshtein_plan_load(plan, path, nullptr)) {
+    levenshtein_plan_set(plan);
+    return true;
+  }
+  levenshtein_tune(plan);
+  levenshtein_plan_set(plan);
+  return levenshtein_plan_save(plan, path, error);
+}
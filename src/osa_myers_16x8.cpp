@@ -0,0 +1,76 @@
+#include "levenshtein_myers.hpp"
+#include <algorithm>
+#include <arm_neon.h>
+
+static const uint16x8_t NULL_V_16 = vdupq_n_u16(0);
+static const uint16x8_t ONE_V_16 = vdupq_n_u16(1);
+
+std::array<uint16_t, 8> osa_myers_16x8(const Myers16x8Input &input) {
+  if (input.q_wrd_len == 0)
+    return std::to_array(input.d_wrd_lens);
+
+  uint16_t bm[ALPHABET_LEN] = {0}; // Bitmap for each letter in the alphabet
+
+  const char *q_wrd = input.q_wrd;
+  uint16_t q_wrd_len = input.q_wrd_len;
+  uint16x8_t scores = vdupq_n_u16(q_wrd_len);
+
+  uint16x8_t vp = vdupq_n_u16(0xFFFF);
+  uint16x8_t vn = vdupq_n_u16(0);
+  uint16x8_t d0 = vdupq_n_u16(0);
+  uint16x8_t pm_prev = vdupq_n_u16(0);
+  uint16x8_t x, y, hn, hp, tr;
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= 1 << i;
+  }
+
+  uint16x8_t d_wrd_lens = vld1q_u16(input.d_wrd_lens);
+
+  uint16x8_t q_wrd_len_ls = vshlq_u16(ONE_V_16, vdupq_n_u16(q_wrd_len - 1));
+
+  int max_d_wrd_len = std::ranges::max(input.d_wrd_lens);
+
+  for (int i = 0; i < max_d_wrd_len; i++) {
+    uint16_t c_bm_0 = bm[input.d_wrds[0][i] - 'a'];
+    uint16_t c_bm_1 = bm[input.d_wrds[1][i] - 'a'];
+    uint16_t c_bm_2 = bm[input.d_wrds[2][i] - 'a'];
+    uint16_t c_bm_3 = bm[input.d_wrds[3][i] - 'a'];
+    uint16_t c_bm_4 = bm[input.d_wrds[4][i] - 'a'];
+    uint16_t c_bm_5 = bm[input.d_wrds[5][i] - 'a'];
+    uint16_t c_bm_6 = bm[input.d_wrds[6][i] - 'a'];
+    uint16_t c_bm_7 = bm[input.d_wrds[7][i] - 'a'];
+    uint16x8_t c_bm = {c_bm_0, c_bm_1, c_bm_2, c_bm_3,
+                       c_bm_4, c_bm_5, c_bm_6, c_bm_7};
+
+    tr = vandq_u16(vshlq_n_u16(vbicq_u16(c_bm, d0), 1), pm_prev);
+    x = vorrq_u16(c_bm, vn);
+    d0 = vorrq_u16(
+        vorrq_u16(veorq_u16(vaddq_u16(vandq_u16(vp, x), vp), vp), x), tr);
+    hn = vandq_u16(vp, d0);
+    hp = vorrq_u16(vn, vmvnq_u16(vorrq_u16(vp, d0)));
+    y = vorrq_u16(vshlq_n_u16(hp, 1), ONE_V_16);
+    vn = vandq_u16(y, d0);
+    vp = vorrq_u16(vshlq_n_u16(hn, 1), vmvnq_u16(vorrq_u16(y, d0)));
+    pm_prev = c_bm;
+
+    uint16x8_t add_score = vandq_u16(hp, q_wrd_len_ls);
+    uint16x8_t sub_score = vandq_u16(hn, q_wrd_len_ls);
+
+    uint16x8_t continue_eval = vcltq_u16(vdupq_n_u16(i), d_wrd_lens);
+    uint16x8_t should_add =
+        vandq_u16(continue_eval, vmvnq_u16(vceqq_u16(add_score, NULL_V_16)));
+    uint16x8_t should_not_add = vmvnq_u16(should_add);
+    uint16x8_t should_sub =
+        vandq_u16(continue_eval, vmvnq_u16(vceqq_u16(sub_score, NULL_V_16)));
+
+    scores = vaddq_u16(scores, vandq_u16(should_add, ONE_V_16));
+    scores = vsubq_u16(
+        scores, vandq_u16(vandq_u16(should_not_add, should_sub), ONE_V_16));
+  }
+
+  std::array<uint16_t, 8> out;
+  vst1q_u16(out.data(), scores);
+  return out;
+}
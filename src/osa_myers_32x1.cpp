@@ -0,0 +1,44 @@
+#include "levenshtein_myers.hpp"
+
+uint32_t osa_myers_32x1(const char *q_wrd, int q_wrd_len, const char *d_wrd,
+                        int d_wrd_len) {
+  if (q_wrd_len == 0)
+    return d_wrd_len;
+
+  uint32_t bm[ALPHABET_LEN] = {0}; // Bitmap for each letter in the alphabet
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[q_wrd[i] - 'a'] |= (uint32_t(1) << i);
+  }
+
+  uint32_t vp = 0xFFFFFFFF;
+  uint32_t vn = 0;
+  uint32_t d0 = 0;
+  uint32_t pm_prev = 0;
+  uint32_t score = q_wrd_len;
+
+  for (int i = 0; i < d_wrd_len; i++) {
+    uint32_t c_bm = bm[d_wrd[i] - 'a'];
+
+    // Transpositions: a match on the diagonal two steps back that the
+    // previous column did not already reach with a zero delta
+    uint32_t tr = (((~d0) & c_bm) << 1) & pm_prev;
+    uint32_t x = c_bm | vn;
+    d0 = ((vp + (x & vp)) ^ vp) | x | tr;
+    uint32_t hn = vp & d0;
+    uint32_t hp = vn | ~(vp | d0);
+    uint32_t y = (hp << 1) | 1;
+    vn = y & d0;
+    vp = (hn << 1) | ~(y | d0);
+    pm_prev = c_bm;
+
+    if ((hp & (uint32_t(1) << (q_wrd_len - 1))) != 0) {
+      score++;
+    } else if ((hn & (uint32_t(1) << (q_wrd_len - 1))) != 0) {
+      score--;
+    }
+  }
+
+  return score;
+}
@@ -0,0 +1,68 @@
+#include "levenshtein_myers.hpp"
+
+// Multi-word OSA recurrence. Words are processed from least to most
+// significant in one pass, carrying the add and shift-left bits between
+// them, so each column costs O(m / 64) word operations.
+uint32_t osa_myers_anyx1(const char *q_wrd, int q_wrd_len, const char *d_wrd,
+                         int d_wrd_len) {
+  if (q_wrd_len == 0)
+    return d_wrd_len;
+
+  size_t words = (q_wrd_len + 63) / 64;
+
+  // One extra all-zero row serves as the pattern mask before column 0
+  std::vector<uint64_t> bm((ALPHABET_LEN + 1) * words, 0);
+  std::vector<uint64_t> vp(words, ~0ULL), vn(words, 0), d0(words, 0);
+
+  // Initialize the bitmap
+  for (int i = 0; i < q_wrd_len; i++) {
+    bm[(q_wrd[i] - 'a') * words + i / 64] |= uint64_t(1) << (i % 64);
+  }
+
+  size_t hi_word = (q_wrd_len - 1) / 64;
+  uint64_t hi_bit = uint64_t(1) << ((q_wrd_len - 1) % 64);
+  const uint64_t *pm_prev = &bm[ALPHABET_LEN * words];
+
+  uint32_t score = q_wrd_len;
+  for (int i = 0; i < d_wrd_len; i++) {
+    const uint64_t *c_bm = &bm[(d_wrd[i] - 'a') * words];
+
+    uint64_t tr_carry = 0, add_carry = 0, hp_carry = 1, hn_carry = 0;
+    for (size_t w = 0; w < words; w++) {
+      uint64_t pm = c_bm[w];
+
+      uint64_t t = ~d0[w] & pm;
+      uint64_t tr = ((t << 1) | tr_carry) & pm_prev[w];
+      tr_carry = t >> 63;
+
+      uint64_t x = pm | vn[w];
+      uint64_t a = x & vp[w];
+      uint64_t sum = a + vp[w];
+      uint64_t carry = sum < a;
+      sum += add_carry;
+      add_carry = carry | (sum < add_carry);
+
+      uint64_t d = (sum ^ vp[w]) | x | tr;
+      uint64_t hn = vp[w] & d;
+      uint64_t hp = vn[w] | ~(vp[w] | d);
+
+      uint64_t y = (hp << 1) | hp_carry;
+      hp_carry = hp >> 63;
+      vn[w] = y & d;
+      vp[w] = (hn << 1) | hn_carry | ~(y | d);
+      hn_carry = hn >> 63;
+      d0[w] = d;
+
+      if (w == hi_word) {
+        if ((hp & hi_bit) != 0) {
+          score++;
+        } else if ((hn & hi_bit) != 0) {
+          score--;
+        }
+      }
+    }
+    pm_prev = c_bm;
+  }
+
+  return score;
+}
@@ -25,6 +25,72 @@ static uint32_t levenshtein_reference(const char *a, int len_a, const char *b,
   return prev[len_b];
 }
 
+static uint32_t osa_reference(const char *a, int len_a, const char *b,
+                              int len_b) {
+  std::vector<std::vector<uint32_t>> d(len_a + 1,
+                                       std::vector<uint32_t>(len_b + 1));
+  for (int i = 0; i <= len_a; i++)
+    d[i][0] = i;
+  for (int j = 0; j <= len_b; j++)
+    d[0][j] = j;
+
+  for (int i = 1; i <= len_a; i++) {
+    for (int j = 1; j <= len_b; j++) {
+      uint32_t cost = (a[i - 1] == b[j - 1]) ? 0 : 1;
+      d[i][j] = std::min({d[i - 1][j] + 1, d[i][j - 1] + 1,
+                          d[i - 1][j - 1] + cost});
+      if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1])
+        d[i][j] = std::min(d[i][j], d[i - 2][j - 2] + 1);
+    }
+  }
+  return d[len_a][len_b];
+}
+
+static uint32_t indel_reference(const char *a, int len_a, const char *b,
+                                int len_b) {
+  std::vector<uint32_t> prev(len_b + 1, 0), curr(len_b + 1, 0);
+  for (int i = 0; i < len_a; i++) {
+    for (int j = 0; j < len_b; j++) {
+      curr[j + 1] = a[i] == b[j] ? prev[j] + 1
+                                 : std::max(prev[j + 1], curr[j]);
+    }
+    std::swap(prev, curr);
+  }
+  return len_a + len_b - 2 * prev[len_b];
+}
+
+// Prefix reference: the minimum of the last row, capped at max_dist + 1
+static uint32_t prefix_reference(const std::string &q, const std::string &d,
+                                 uint32_t max_dist) {
+  uint32_t best = q.size();
+  for (size_t j = 1; j <= d.size(); j++)
+    best = std::min(best, levenshtein_reference(q.c_str(), q.size(),
+                                                d.c_str(), j));
+  return std::min(best, max_dist + 1);
+}
+
+// Semi-global reference: the minimum distance of any text substring ending at
+// each position.
+static std::vector<uint32_t> search_reference(const std::string &p,
+                                              const std::string &t) {
+  std::vector<uint32_t> col(p.size() + 1), out;
+  for (size_t i = 0; i <= p.size(); i++)
+    col[i] = i;
+
+  for (size_t j = 0; j < t.size(); j++) {
+    uint32_t diag = col[0];
+    col[0] = 0;
+    for (size_t i = 0; i < p.size(); i++) {
+      uint32_t cost = (p[i] == t[j]) ? 0 : 1;
+      uint32_t next = std::min({col[i + 1] + 1, col[i] + 1, diag + cost});
+      diag = col[i + 1];
+      col[i + 1] = next;
+    }
+    out.push_back(col[p.size()]);
+  }
+  return out;
+}
+
 static std::string rand_string(std::mt19937 &rng, int max_len = 16) {
   std::uniform_int_distribution<int> len_dist(0, max_len);
   std::uniform_int_distribution<int> char_dist('a', 'z');
@@ -278,3 +344,776 @@ TEST(LevenshteinMyers8x16Fuzz, RandomizedCompareAgainstReference) {
     }
   }
 }
+
+TEST(LevenshteinMyersSearch64x1Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+  std::uniform_int_distribution<int> k_dist(0, 4);
+
+  for (int iter = 0; iter < 20000; ++iter) {
+    auto p = rand_string(rng, 64);
+    auto t = rand_string(rng, 256);
+    uint32_t k = k_dist(rng);
+    if (p.empty())
+      continue;
+
+    MyersSearch64x1State state;
+    levenshtein_myers_search_64x1_init(state, p.c_str(), p.size(), k);
+    std::vector<MyersSearchHit> hits;
+    // Split the text in two to exercise state carry-over
+    size_t split = t.size() / 3;
+    levenshtein_myers_search_64x1(state, t.c_str(), split, hits);
+    levenshtein_myers_search_64x1(state, t.c_str() + split, t.size() - split,
+                                  hits);
+
+    auto ref = search_reference(p, t);
+    size_t h = 0;
+    for (size_t j = 0; j < ref.size(); j++) {
+      if (ref[j] > k)
+        continue;
+      ASSERT_LT(h, hits.size()) << "Missing hit p=" << p << " t=" << t;
+      EXPECT_EQ(hits[h].end_pos, j) << "p=" << p << " t=" << t;
+      EXPECT_EQ(hits[h].distance, ref[j]) << "p=" << p << " t=" << t;
+      h++;
+    }
+    EXPECT_EQ(h, hits.size()) << "Extra hits p=" << p << " t=" << t;
+  }
+}
+
+TEST(LevenshteinMyersSearch16x8Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+  std::uniform_int_distribution<int> k_dist(0, 4);
+
+  for (int iter = 0; iter < 20000; ++iter) {
+    std::string p[8];
+    Myers16x8SearchInput input;
+    for (int k = 0; k < 8; k++) {
+      p[k] = rand_string(rng, 16);
+      input.q_wrds[k] = p[k].c_str();
+      input.q_wrd_lens[k] = p[k].size();
+      input.max_dists[k] = k_dist(rng);
+    }
+    auto t = rand_string(rng, 128);
+
+    MyersSearch16x8State state;
+    levenshtein_myers_search_16x8_init(state, input);
+    std::vector<MyersSearchHit> hits;
+    levenshtein_myers_search_16x8(state, t.c_str(), t.size(), hits);
+
+    for (int k = 0; k < 8; k++) {
+      std::vector<std::pair<uint64_t, uint32_t>> got, want;
+      for (const auto &h : hits)
+        if (h.pattern == (uint32_t)k)
+          got.push_back({h.end_pos, h.distance});
+      if (!p[k].empty()) {
+        auto ref = search_reference(p[k], t);
+        for (size_t j = 0; j < ref.size(); j++)
+          if (ref[j] <= input.max_dists[k])
+            want.push_back({j, ref[j]});
+      }
+      EXPECT_EQ(got, want) << "Mismatch (idx " << k << ") p=" << p[k]
+                           << " t=" << t;
+    }
+  }
+}
+
+TEST(LevenshteinMyersSearch8x16Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+  std::uniform_int_distribution<int> k_dist(0, 4);
+
+  for (int iter = 0; iter < 20000; ++iter) {
+    std::string p[16];
+    Myers8x16SearchInput input;
+    for (int k = 0; k < 16; k++) {
+      p[k] = rand_string(rng, 8);
+      input.q_wrds[k] = p[k].c_str();
+      input.q_wrd_lens[k] = p[k].size();
+      input.max_dists[k] = k_dist(rng);
+    }
+    auto t = rand_string(rng, 128);
+
+    MyersSearch8x16State state;
+    levenshtein_myers_search_8x16_init(state, input);
+    std::vector<MyersSearchHit> hits;
+    levenshtein_myers_search_8x16(state, t.c_str(), t.size(), hits);
+
+    for (int k = 0; k < 16; k++) {
+      std::vector<std::pair<uint64_t, uint32_t>> got, want;
+      for (const auto &h : hits)
+        if (h.pattern == (uint32_t)k)
+          got.push_back({h.end_pos, h.distance});
+      if (!p[k].empty()) {
+        auto ref = search_reference(p[k], t);
+        for (size_t j = 0; j < ref.size(); j++)
+          if (ref[j] <= input.max_dists[k])
+            want.push_back({j, ref[j]});
+      }
+      EXPECT_EQ(got, want) << "Mismatch (idx " << k << ") p=" << p[k]
+                           << " t=" << t;
+    }
+  }
+}
+
+TEST(LevenshteinMyersSearch32x4Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+  std::uniform_int_distribution<int> k_dist(0, 4);
+
+  for (int iter = 0; iter < 20000; ++iter) {
+    std::string p[4];
+    Myers32x4SearchInput input;
+    for (int k = 0; k < 4; k++) {
+      p[k] = rand_string(rng, 32);
+      input.q_wrds[k] = p[k].c_str();
+      input.q_wrd_lens[k] = p[k].size();
+      input.max_dists[k] = k_dist(rng);
+    }
+    auto t = rand_string(rng, 128);
+
+    MyersSearch32x4State state;
+    levenshtein_myers_search_32x4_init(state, input);
+    std::vector<MyersSearchHit> hits;
+    levenshtein_myers_search_32x4(state, t.c_str(), t.size(), hits);
+
+    for (int k = 0; k < 4; k++) {
+      std::vector<std::pair<uint64_t, uint32_t>> got, want;
+      for (const auto &h : hits)
+        if (h.pattern == (uint32_t)k)
+          got.push_back({h.end_pos, h.distance});
+      if (!p[k].empty()) {
+        auto ref = search_reference(p[k], t);
+        for (size_t j = 0; j < ref.size(); j++)
+          if (ref[j] <= input.max_dists[k])
+            want.push_back({j, ref[j]});
+      }
+      EXPECT_EQ(got, want) << "Mismatch (idx " << k << ") p=" << p[k]
+                           << " t=" << t;
+    }
+  }
+}
+
+TEST(LevenshteinMyersSearch64x2Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+  std::uniform_int_distribution<int> k_dist(0, 4);
+
+  for (int iter = 0; iter < 20000; ++iter) {
+    std::string p[2];
+    Myers64x2SearchInput input;
+    for (int k = 0; k < 2; k++) {
+      p[k] = rand_string(rng, 64);
+      input.q_wrds[k] = p[k].c_str();
+      input.q_wrd_lens[k] = p[k].size();
+      input.max_dists[k] = k_dist(rng);
+    }
+    auto t = rand_string(rng, 128);
+
+    MyersSearch64x2State state;
+    levenshtein_myers_search_64x2_init(state, input);
+    std::vector<MyersSearchHit> hits;
+    levenshtein_myers_search_64x2(state, t.c_str(), t.size(), hits);
+
+    for (int k = 0; k < 2; k++) {
+      std::vector<std::pair<uint64_t, uint32_t>> got, want;
+      for (const auto &h : hits)
+        if (h.pattern == (uint32_t)k)
+          got.push_back({h.end_pos, h.distance});
+      if (!p[k].empty()) {
+        auto ref = search_reference(p[k], t);
+        for (size_t j = 0; j < ref.size(); j++)
+          if (ref[j] <= input.max_dists[k])
+            want.push_back({j, ref[j]});
+      }
+      EXPECT_EQ(got, want) << "Mismatch (idx " << k << ") p=" << p[k]
+                           << " t=" << t;
+    }
+  }
+}
+
+// The op string must transform q into d at exactly the optimal cost
+static uint32_t ops_cost(const std::string &q, const std::string &d,
+                         const std::string &ops) {
+  size_t i = 0, j = 0;
+  uint32_t cost = 0;
+  for (char op : ops) {
+    if (op == '=' && i < q.size() && j < d.size() && q[i] == d[j]) {
+      i++, j++;
+    } else if (op == 'X' && i < q.size() && j < d.size() && q[i] != d[j]) {
+      i++, j++, cost++;
+    } else if (op == 'I' && i < q.size()) {
+      i++, cost++;
+    } else if (op == 'D' && j < d.size()) {
+      j++, cost++;
+    } else {
+      return UINT32_MAX;
+    }
+  }
+  return (i == q.size() && j == d.size()) ? cost : UINT32_MAX;
+}
+
+TEST(LevenshteinMyers64x1AlignFuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 200000; ++iter) {
+    auto q = rand_string(rng, 64);
+    auto d = rand_string(rng, 64);
+
+    std::string ops;
+    auto myers = levenshtein_myers_64x1_align(q.c_str(), q.size(), d.c_str(),
+                                              d.size(), ops);
+    uint32_t ref =
+        levenshtein_reference(q.c_str(), q.size(), d.c_str(), d.size());
+
+    EXPECT_EQ(myers, ref) << "Mismatch q=" << q << " d=" << d;
+    EXPECT_EQ(ops_cost(q, d, ops), ref) << "Bad ops q=" << q << " d=" << d;
+  }
+}
+
+TEST(LevenshteinMyersAnyx1AlignFuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 2000; ++iter) {
+    auto q = rand_string(rng, 600);
+    auto d = rand_string(rng, 600);
+
+    std::string ops;
+    auto myers = levenshtein_myers_anyx1_align(q.c_str(), q.size(), d.c_str(),
+                                               d.size(), ops);
+    uint32_t ref =
+        levenshtein_reference(q.c_str(), q.size(), d.c_str(), d.size());
+
+    EXPECT_EQ(myers, ref) << "Mismatch q=" << q << " d=" << d;
+    EXPECT_EQ(ops_cost(q, d, ops), ref) << "Bad ops q=" << q << " d=" << d;
+  }
+}
+
+// Small alphabet so that transpositions actually occur
+static std::string rand_string_small(std::mt19937 &rng, int max_len) {
+  std::uniform_int_distribution<int> len_dist(0, max_len);
+  std::uniform_int_distribution<int> char_dist('a', 'd');
+  int len = len_dist(rng);
+  std::string s;
+  for (int i = 0; i < len; i++)
+    s.push_back(char_dist(rng));
+  return s;
+}
+
+TEST(OsaMyers32x1Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 200000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 32) : rand_string_small(rng, 32);
+    auto d = iter % 2 ? rand_string(rng, 32) : rand_string_small(rng, 32);
+
+    auto myers = osa_myers_32x1(q.c_str(), q.size(), d.c_str(), d.size());
+    uint32_t ref = osa_reference(q.c_str(), q.size(), d.c_str(), d.size());
+
+    EXPECT_EQ(myers, ref) << "Mismatch q=" << q << " d=" << d;
+  }
+}
+
+TEST(OsaMyers64x1Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 200000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 64) : rand_string_small(rng, 64);
+    auto d = iter % 2 ? rand_string(rng, 64) : rand_string_small(rng, 64);
+
+    auto myers = osa_myers_64x1(q.c_str(), q.size(), d.c_str(), d.size());
+    uint32_t ref = osa_reference(q.c_str(), q.size(), d.c_str(), d.size());
+
+    EXPECT_EQ(myers, ref) << "Mismatch q=" << q << " d=" << d;
+  }
+}
+
+TEST(OsaMyersAnyx1Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 2000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 400) : rand_string_small(rng, 400);
+    auto d = iter % 2 ? rand_string(rng, 400) : rand_string_small(rng, 400);
+
+    auto myers = osa_myers_anyx1(q.c_str(), q.size(), d.c_str(), d.size());
+    uint32_t ref = osa_reference(q.c_str(), q.size(), d.c_str(), d.size());
+
+    EXPECT_EQ(myers, ref) << "Mismatch q=" << q << " d=" << d;
+  }
+}
+
+TEST(OsaMyers8x16Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 200000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 8) : rand_string_small(rng, 8);
+    std::string d[16];
+    Myers8x16Input input{.q_wrd = q.c_str(), .q_wrd_len = (int)q.size()};
+    for (int i = 0; i < 16; i++) {
+      d[i] = iter % 2 ? rand_string(rng, 8) : rand_string_small(rng, 8);
+      input.d_wrds[i] = d[i].c_str();
+      input.d_wrd_lens[i] = d[i].size();
+    }
+
+    auto simd = osa_myers_8x16(input);
+
+    for (int i = 0; i < 16; i++) {
+      uint32_t ref = osa_reference(q.c_str(), q.size(), d[i].c_str(), d[i].size());
+      EXPECT_EQ(simd[i], ref)
+          << "Mismatch (idx " << i << ") q=" << q << " d=" << d[i];
+    }
+  }
+}
+
+TEST(OsaMyers16x8Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 200000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 16) : rand_string_small(rng, 16);
+    std::string d[8];
+    Myers16x8Input input{.q_wrd = q.c_str(), .q_wrd_len = (int)q.size()};
+    for (int i = 0; i < 8; i++) {
+      d[i] = iter % 2 ? rand_string(rng, 16) : rand_string_small(rng, 16);
+      input.d_wrds[i] = d[i].c_str();
+      input.d_wrd_lens[i] = d[i].size();
+    }
+
+    auto simd = osa_myers_16x8(input);
+
+    for (int i = 0; i < 8; i++) {
+      uint32_t ref = osa_reference(q.c_str(), q.size(), d[i].c_str(), d[i].size());
+      EXPECT_EQ(simd[i], ref)
+          << "Mismatch (idx " << i << ") q=" << q << " d=" << d[i];
+    }
+  }
+}
+
+TEST(OsaMyers32x4Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 200000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 32) : rand_string_small(rng, 32);
+    std::string d[4];
+    Myers32x4Input input{.q_wrd = q.c_str(), .q_wrd_len = (int)q.size()};
+    for (int i = 0; i < 4; i++) {
+      d[i] = iter % 2 ? rand_string(rng, 32) : rand_string_small(rng, 32);
+      input.d_wrds[i] = d[i].c_str();
+      input.d_wrd_lens[i] = d[i].size();
+    }
+
+    auto simd = osa_myers_32x4(input);
+
+    for (int i = 0; i < 4; i++) {
+      uint32_t ref = osa_reference(q.c_str(), q.size(), d[i].c_str(), d[i].size());
+      EXPECT_EQ(simd[i], ref)
+          << "Mismatch (idx " << i << ") q=" << q << " d=" << d[i];
+    }
+  }
+}
+
+TEST(OsaMyers64x2Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 200000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 64) : rand_string_small(rng, 64);
+    std::string d[2];
+    Myers64x2Input input{.q_wrd = q.c_str(), .q_wrd_len = (int)q.size()};
+    for (int i = 0; i < 2; i++) {
+      d[i] = iter % 2 ? rand_string(rng, 64) : rand_string_small(rng, 64);
+      input.d_wrds[i] = d[i].c_str();
+      input.d_wrd_lens[i] = d[i].size();
+    }
+
+    auto simd = osa_myers_64x2(input);
+
+    for (int i = 0; i < 2; i++) {
+      uint32_t ref = osa_reference(q.c_str(), q.size(), d[i].c_str(), d[i].size());
+      EXPECT_EQ(simd[i], ref)
+          << "Mismatch (idx " << i << ") q=" << q << " d=" << d[i];
+    }
+  }
+}
+
+TEST(IndelLcs32x1Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 200000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 32) : rand_string_small(rng, 32);
+    auto d = iter % 2 ? rand_string(rng, 32) : rand_string_small(rng, 32);
+
+    auto myers = indel_lcs_32x1(q.c_str(), q.size(), d.c_str(), d.size());
+    uint32_t ref = indel_reference(q.c_str(), q.size(), d.c_str(), d.size());
+
+    EXPECT_EQ(myers, ref) << "Mismatch q=" << q << " d=" << d;
+  }
+}
+
+TEST(IndelLcs64x1Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 200000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 64) : rand_string_small(rng, 64);
+    auto d = iter % 2 ? rand_string(rng, 64) : rand_string_small(rng, 64);
+
+    auto myers = indel_lcs_64x1(q.c_str(), q.size(), d.c_str(), d.size());
+    uint32_t ref = indel_reference(q.c_str(), q.size(), d.c_str(), d.size());
+
+    EXPECT_EQ(myers, ref) << "Mismatch q=" << q << " d=" << d;
+  }
+}
+
+TEST(IndelLcsAnyx1Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 2000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 400) : rand_string_small(rng, 400);
+    auto d = iter % 2 ? rand_string(rng, 400) : rand_string_small(rng, 400);
+
+    auto myers = indel_lcs_anyx1(q.c_str(), q.size(), d.c_str(), d.size());
+    uint32_t ref = indel_reference(q.c_str(), q.size(), d.c_str(), d.size());
+
+    EXPECT_EQ(myers, ref) << "Mismatch q=" << q << " d=" << d;
+  }
+}
+
+TEST(IndelLcs8x16Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 200000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 8) : rand_string_small(rng, 8);
+    std::string d[16];
+    Myers8x16Input input{.q_wrd = q.c_str(), .q_wrd_len = (int)q.size()};
+    for (int i = 0; i < 16; i++) {
+      d[i] = iter % 2 ? rand_string(rng, 8) : rand_string_small(rng, 8);
+      input.d_wrds[i] = d[i].c_str();
+      input.d_wrd_lens[i] = d[i].size();
+    }
+
+    auto simd = indel_lcs_8x16(input);
+
+    for (int i = 0; i < 16; i++) {
+      uint32_t ref = indel_reference(q.c_str(), q.size(), d[i].c_str(), d[i].size());
+      EXPECT_EQ(simd[i], ref)
+          << "Mismatch (idx " << i << ") q=" << q << " d=" << d[i];
+    }
+  }
+}
+
+TEST(IndelLcs16x8Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 200000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 16) : rand_string_small(rng, 16);
+    std::string d[8];
+    Myers16x8Input input{.q_wrd = q.c_str(), .q_wrd_len = (int)q.size()};
+    for (int i = 0; i < 8; i++) {
+      d[i] = iter % 2 ? rand_string(rng, 16) : rand_string_small(rng, 16);
+      input.d_wrds[i] = d[i].c_str();
+      input.d_wrd_lens[i] = d[i].size();
+    }
+
+    auto simd = indel_lcs_16x8(input);
+
+    for (int i = 0; i < 8; i++) {
+      uint32_t ref = indel_reference(q.c_str(), q.size(), d[i].c_str(), d[i].size());
+      EXPECT_EQ(simd[i], ref)
+          << "Mismatch (idx " << i << ") q=" << q << " d=" << d[i];
+    }
+  }
+}
+
+TEST(IndelLcs32x4Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 200000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 32) : rand_string_small(rng, 32);
+    std::string d[4];
+    Myers32x4Input input{.q_wrd = q.c_str(), .q_wrd_len = (int)q.size()};
+    for (int i = 0; i < 4; i++) {
+      d[i] = iter % 2 ? rand_string(rng, 32) : rand_string_small(rng, 32);
+      input.d_wrds[i] = d[i].c_str();
+      input.d_wrd_lens[i] = d[i].size();
+    }
+
+    auto simd = indel_lcs_32x4(input);
+
+    for (int i = 0; i < 4; i++) {
+      uint32_t ref = indel_reference(q.c_str(), q.size(), d[i].c_str(), d[i].size());
+      EXPECT_EQ(simd[i], ref)
+          << "Mismatch (idx " << i << ") q=" << q << " d=" << d[i];
+    }
+  }
+}
+
+TEST(IndelLcs64x2Fuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 200000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 64) : rand_string_small(rng, 64);
+    std::string d[2];
+    Myers64x2Input input{.q_wrd = q.c_str(), .q_wrd_len = (int)q.size()};
+    for (int i = 0; i < 2; i++) {
+      d[i] = iter % 2 ? rand_string(rng, 64) : rand_string_small(rng, 64);
+      input.d_wrds[i] = d[i].c_str();
+      input.d_wrd_lens[i] = d[i].size();
+    }
+
+    auto simd = indel_lcs_64x2(input);
+
+    for (int i = 0; i < 2; i++) {
+      uint32_t ref = indel_reference(q.c_str(), q.size(), d[i].c_str(), d[i].size());
+      EXPECT_EQ(simd[i], ref)
+          << "Mismatch (idx " << i << ") q=" << q << " d=" << d[i];
+    }
+  }
+}
+
+TEST(LevenshteinMyers64x1PrefixFuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 20000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 64) : rand_string_small(rng, 64);
+    auto d = iter % 2 ? rand_string(rng, 64) : rand_string_small(rng, 64);
+    uint32_t k = rng() % 8;
+
+    auto myers = levenshtein_myers_64x1_prefix(q.c_str(), q.size(), d.c_str(),
+                                               d.size(), k);
+    EXPECT_EQ(myers, prefix_reference(q, d, k))
+        << "Mismatch q=" << q << " d=" << d << " k=" << k;
+
+    auto myers32 = levenshtein_myers_32x1_prefix(
+        q.c_str(), std::min<int>(q.size(), 32), d.c_str(), d.size(), k);
+    EXPECT_EQ(myers32, prefix_reference(q.substr(0, 32), d, k))
+        << "Mismatch q=" << q << " d=" << d << " k=" << k;
+  }
+}
+
+TEST(LevenshteinMyers8x16PrefixFuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 20000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 8) : rand_string_small(rng, 8);
+    std::string d[16];
+    Myers8x16Input input{.q_wrd = q.c_str(), .q_wrd_len = (int)q.size()};
+    for (int i = 0; i < 16; i++) {
+      d[i] = iter % 2 ? rand_string(rng, 8) : rand_string_small(rng, 8);
+      input.d_wrds[i] = d[i].c_str();
+      input.d_wrd_lens[i] = d[i].size();
+    }
+    uint32_t k = iter % 3 ? rng() % 8 : 8;
+
+    auto simd = levenshtein_myers_8x16_prefix(input, k);
+
+    for (int i = 0; i < 16; i++) {
+      EXPECT_EQ(simd[i], prefix_reference(q, d[i], k))
+          << "Mismatch (idx " << i << ") q=" << q << " d=" << d[i]
+          << " k=" << k;
+    }
+  }
+}
+
+TEST(LevenshteinMyers16x8PrefixFuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 20000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 16) : rand_string_small(rng, 16);
+    std::string d[8];
+    Myers16x8Input input{.q_wrd = q.c_str(), .q_wrd_len = (int)q.size()};
+    for (int i = 0; i < 8; i++) {
+      d[i] = iter % 2 ? rand_string(rng, 16) : rand_string_small(rng, 16);
+      input.d_wrds[i] = d[i].c_str();
+      input.d_wrd_lens[i] = d[i].size();
+    }
+    uint32_t k = iter % 3 ? rng() % 8 : 16;
+
+    auto simd = levenshtein_myers_16x8_prefix(input, k);
+
+    for (int i = 0; i < 8; i++) {
+      EXPECT_EQ(simd[i], prefix_reference(q, d[i], k))
+          << "Mismatch (idx " << i << ") q=" << q << " d=" << d[i]
+          << " k=" << k;
+    }
+  }
+}
+
+TEST(LevenshteinMyers32x4PrefixFuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 20000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 32) : rand_string_small(rng, 32);
+    std::string d[4];
+    Myers32x4Input input{.q_wrd = q.c_str(), .q_wrd_len = (int)q.size()};
+    for (int i = 0; i < 4; i++) {
+      d[i] = iter % 2 ? rand_string(rng, 32) : rand_string_small(rng, 32);
+      input.d_wrds[i] = d[i].c_str();
+      input.d_wrd_lens[i] = d[i].size();
+    }
+    uint32_t k = iter % 3 ? rng() % 8 : 32;
+
+    auto simd = levenshtein_myers_32x4_prefix(input, k);
+
+    for (int i = 0; i < 4; i++) {
+      EXPECT_EQ(simd[i], prefix_reference(q, d[i], k))
+          << "Mismatch (idx " << i << ") q=" << q << " d=" << d[i]
+          << " k=" << k;
+    }
+  }
+}
+
+TEST(LevenshteinMyers64x2PrefixFuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 20000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 64) : rand_string_small(rng, 64);
+    std::string d[2];
+    Myers64x2Input input{.q_wrd = q.c_str(), .q_wrd_len = (int)q.size()};
+    for (int i = 0; i < 2; i++) {
+      d[i] = iter % 2 ? rand_string(rng, 64) : rand_string_small(rng, 64);
+      input.d_wrds[i] = d[i].c_str();
+      input.d_wrd_lens[i] = d[i].size();
+    }
+    uint32_t k = iter % 3 ? rng() % 8 : 64;
+
+    auto simd = levenshtein_myers_64x2_prefix(input, k);
+
+    for (int i = 0; i < 2; i++) {
+      EXPECT_EQ(simd[i], prefix_reference(q, d[i], k))
+          << "Mismatch (idx " << i << ") q=" << q << " d=" << d[i]
+          << " k=" << k;
+    }
+  }
+}
+
+TEST(LevenshteinMyers8x16BoundedFuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 20000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 8) : rand_string_small(rng, 8);
+    std::string d[16];
+    Myers8x16Input input{.q_wrd = q.c_str(), .q_wrd_len = (int)q.size()};
+    for (int i = 0; i < 16; i++) {
+      d[i] = iter % 2 ? rand_string(rng, 8) : rand_string_small(rng, 8);
+      input.d_wrds[i] = d[i].c_str();
+      input.d_wrd_lens[i] = d[i].size();
+    }
+    uint32_t k = iter % 3 ? rng() % 8 : 8;
+
+    auto simd = levenshtein_myers_8x16_bounded(input, k);
+
+    for (int i = 0; i < 16; i++) {
+      uint32_t ref = levenshtein_reference(q.c_str(), q.size(), d[i].c_str(),
+                                           d[i].size());
+      EXPECT_EQ(simd[i], std::min(ref, k + 1))
+          << "Mismatch (idx " << i << ") q=" << q << " d=" << d[i]
+          << " k=" << k;
+    }
+  }
+}
+
+TEST(LevenshteinMyers16x8BoundedFuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 20000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 16) : rand_string_small(rng, 16);
+    std::string d[8];
+    Myers16x8Input input{.q_wrd = q.c_str(), .q_wrd_len = (int)q.size()};
+    for (int i = 0; i < 8; i++) {
+      d[i] = iter % 2 ? rand_string(rng, 16) : rand_string_small(rng, 16);
+      input.d_wrds[i] = d[i].c_str();
+      input.d_wrd_lens[i] = d[i].size();
+    }
+    uint32_t k = iter % 3 ? rng() % 8 : 16;
+
+    auto simd = levenshtein_myers_16x8_bounded(input, k);
+
+    for (int i = 0; i < 8; i++) {
+      uint32_t ref = levenshtein_reference(q.c_str(), q.size(), d[i].c_str(),
+                                           d[i].size());
+      EXPECT_EQ(simd[i], std::min(ref, k + 1))
+          << "Mismatch (idx " << i << ") q=" << q << " d=" << d[i]
+          << " k=" << k;
+    }
+  }
+}
+
+TEST(LevenshteinMyers32x4BoundedFuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 20000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 32) : rand_string_small(rng, 32);
+    std::string d[4];
+    Myers32x4Input input{.q_wrd = q.c_str(), .q_wrd_len = (int)q.size()};
+    for (int i = 0; i < 4; i++) {
+      d[i] = iter % 2 ? rand_string(rng, 32) : rand_string_small(rng, 32);
+      input.d_wrds[i] = d[i].c_str();
+      input.d_wrd_lens[i] = d[i].size();
+    }
+    uint32_t k = iter % 3 ? rng() % 8 : 32;
+
+    auto simd = levenshtein_myers_32x4_bounded(input, k);
+
+    for (int i = 0; i < 4; i++) {
+      uint32_t ref = levenshtein_reference(q.c_str(), q.size(), d[i].c_str(),
+                                           d[i].size());
+      EXPECT_EQ(simd[i], std::min(ref, k + 1))
+          << "Mismatch (idx " << i << ") q=" << q << " d=" << d[i]
+          << " k=" << k;
+    }
+  }
+}
+
+TEST(LevenshteinMyers64x2BoundedFuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 20000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 64) : rand_string_small(rng, 64);
+    std::string d[2];
+    Myers64x2Input input{.q_wrd = q.c_str(), .q_wrd_len = (int)q.size()};
+    for (int i = 0; i < 2; i++) {
+      d[i] = iter % 2 ? rand_string(rng, 64) : rand_string_small(rng, 64);
+      input.d_wrds[i] = d[i].c_str();
+      input.d_wrd_lens[i] = d[i].size();
+    }
+    uint32_t k = iter % 3 ? rng() % 8 : 64;
+
+    auto simd = levenshtein_myers_64x2_bounded(input, k);
+
+    for (int i = 0; i < 2; i++) {
+      uint32_t ref = levenshtein_reference(q.c_str(), q.size(), d[i].c_str(),
+                                           d[i].size());
+      EXPECT_EQ(simd[i], std::min(ref, k + 1))
+          << "Mismatch (idx " << i << ") q=" << q << " d=" << d[i]
+          << " k=" << k;
+    }
+  }
+}
+
+// `s` with up to `edits` random substitutions, insertions and deletions,
+// drawing new bytes from the full 0x01-0xff range
+static std::string mutate(std::mt19937 &rng, std::string s, int edits) {
+  for (int e = 0; e < edits; e++) {
+    int op = rng() % 3;
+    char c = 1 + rng() % 255;
+    if (op == 0 && !s.empty())
+      s[rng() % s.size()] = c;
+    else if (op == 1)
+      s.insert(s.begin() + rng() % (s.size() + 1), c);
+    else if (!s.empty())
+      s.erase(s.begin() + rng() % s.size());
+  }
+  return s;
+}
+
+TEST(LevenshteinMyersAnyx1BoundedFuzz, RandomizedCompareAgainstReference) {
+  std::mt19937 rng(1337);
+
+  for (int iter = 0; iter < 5000; ++iter) {
+    auto q = iter % 2 ? rand_string(rng, 400) : rand_string_small(rng, 400);
+    auto d = iter % 4 < 2 ? mutate(rng, q, rng() % 40)
+                          : rand_string(rng, 400);
+    uint32_t k = iter % 5 ? rng() % 48 : 400;
+
+    auto myers = levenshtein_myers_anyx1_bounded(q.c_str(), q.size(),
+                                                 d.c_str(), d.size(), k);
+    uint32_t ref = levenshtein_reference(q.c_str(), q.size(), d.c_str(),
+                                         d.size());
+
+    EXPECT_EQ(myers, std::min(ref, k + 1))
+        << "Mismatch q=" << q << " d=" << d << " k=" << k;
+  }
+}
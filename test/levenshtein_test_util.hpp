@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// Generators and the DP reference shared by the test files
+
+// `min_len` to `max_len` characters, each drawn uniformly from `alphabet`
+inline std::string random_string(std::mt19937 &rng, int min_len, int max_len,
+                                 const std::string &alphabet) {
+  std::uniform_int_distribution<int> len_dist(min_len, max_len);
+  std::uniform_int_distribution<int> char_dist(0, alphabet.size() - 1);
+  std::string s(len_dist(rng), ' ');
+  for (auto &c : s)
+    c = alphabet[char_dist(rng)];
+  return s;
+}
+
+// Any byte but NUL
+inline std::string random_bytes(std::mt19937 &rng, int max_len) {
+  static const std::string bytes = [] {
+    std::string s;
+    for (int c = 1; c <= 255; c++)
+      s.push_back(c);
+    return s;
+  }();
+  return random_string(rng, 0, max_len, bytes);
+}
+
+// The letters 'a' to `last`
+inline std::string letters(char last = 'z') {
+  std::string s;
+  for (char c = 'a'; c <= last; c++)
+    s.push_back(c);
+  return s;
+}
+
+// Up to `max_len` characters from 'a' to `last`
+inline std::string random_string(std::mt19937 &rng, int max_len,
+                                 char last = 'z') {
+  return random_string(rng, 0, max_len, letters(last));
+}
+
+inline std::vector<std::string> random_strings(std::mt19937 &rng, int n,
+                                               int min_len, int max_len,
+                                               char last = 'z') {
+  std::string alphabet = letters(last);
+  std::vector<std::string> strs(n);
+  for (auto &s : strs)
+    s = random_string(rng, min_len, max_len, alphabet);
+  return strs;
+}
+
+// Plain Levenshtein distance by the two-row DP; compares raw bytes, so it
+// holds for any alphabet
+inline uint32_t levenshtein_reference(const char *a, int len_a,
+                                      const char *b, int len_b) {
+  std::vector<uint32_t> prev(len_b + 1), curr(len_b + 1);
+
+  for (int j = 0; j <= len_b; j++)
+    prev[j] = j;
+
+  for (int i = 0; i < len_a; i++) {
+    curr[0] = i + 1;
+    for (int j = 0; j < len_b; j++) {
+      uint32_t cost = (a[i] == b[j]) ? 0 : 1;
+      curr[j + 1] = std::min({
+          prev[j + 1] + 1, // deletion
+          curr[j] + 1,     // insertion
+          prev[j] + cost   // substitution
+      });
+    }
+    std::swap(prev, curr);
+  }
+  return prev[len_b];
+}
+
+inline uint32_t levenshtein_reference(const std::string &a,
+                                      const std::string &b) {
+  return levenshtein_reference(a.data(), a.size(), b.data(), b.size());
+}
+
+// Semi-global reference: the minimum distance of any text substring ending at
+// each position.
+inline std::vector<uint32_t> search_reference(const std::string &p,
+                                              const std::string &t) {
+  std::vector<uint32_t> col(p.size() + 1), out;
+  for (size_t i = 0; i <= p.size(); i++)
+    col[i] = i;
+
+  for (size_t j = 0; j < t.size(); j++) {
+    uint32_t diag = col[0];
+    col[0] = 0;
+    for (size_t i = 0; i < p.size(); i++) {
+      uint32_t cost = (p[i] == t[j]) ? 0 : 1;
+      uint32_t next = std::min({col[i + 1] + 1, col[i] + 1, diag + cost});
+      diag = col[i + 1];
+      col[i + 1] = next;
+    }
+    out.push_back(col[p.size()]);
+  }
+  return out;
+}
+
+// Distance from `p` to its closest substring of `t`, the empty one included
+inline uint32_t substring_reference(const std::string &p,
+                                    const std::string &t) {
+  uint32_t best = p.size();
+  for (uint32_t d : search_reference(p, t))
+    best = std::min(best, d);
+  return best;
+}
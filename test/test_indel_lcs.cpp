@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include <levenshtein_myers.hpp>
+
+TEST(IndelLcs16x8Test, NoSubstitutions) {
+  auto input = Myers16x8Input{
+      .q_wrd = "kitten",
+      .q_wrd_len = 6,
+      // Every lane is read up to the longest word, so shorter ones are
+      // padded with 'a' past their length
+      .d_wrds = {"sitting", "kittena", "aaaaaaa", "kitteaa", "nettika",
+                 "mittena", "kaaaaaa", "xyzaaaa"},
+      .d_wrd_lens = {7, 6, 0, 5, 6, 6, 1, 3}};
+  std::array<uint16_t, 8> result = indel_lcs_16x8(input);
+  std::array<uint16_t, 8> expected = {5, 0, 6, 1, 8, 2, 5, 9};
+  EXPECT_EQ(result, expected);
+
+  // A substitution costs a deletion plus an insertion
+  std::array<uint16_t, 8> lev = levenshtein_myers_16x8(input);
+  EXPECT_EQ(lev[5], 1);
+}
+
+TEST(IndelLcs16x8Test, FullWidthQuery) {
+  auto input = Myers16x8Input{
+      .q_wrd = "abcdefghijklmnop",
+      .q_wrd_len = 16,
+      .d_wrds = {"abcdefghijklmnop", "ponmlkjihgfedcba", "acegikmoaaaaaaaa",
+                 "aaaaaaaaaaaaaaaa", "aaaaaaaaaaaaaaaa", "aaaaaaaaaaaaaaaa",
+                 "aaaaaaaaaaaaaaaa", "aaaaaaaaaaaaaaaa"},
+      .d_wrd_lens = {16, 16, 8, 0, 0, 0, 0, 0}};
+  std::array<uint16_t, 8> expected = {0, 30, 8, 16, 16, 16, 16, 16};
+  EXPECT_EQ(indel_lcs_16x8(input), expected);
+}
+
+TEST(IndelLcs16x8Test, Scalar) {
+  EXPECT_EQ(indel_lcs_32x1("kitten", 6, "sitting", 7), 5u);
+  EXPECT_EQ(indel_lcs_64x1("kitten", 6, "sitting", 7), 5u);
+  EXPECT_EQ(indel_lcs_anyx1("kitten", 6, "sitting", 7), 5u);
+  EXPECT_EQ(indel_lcs_64x1("", 0, "abc", 3), 3u);
+  EXPECT_EQ(indel_lcs_anyx1("abc", 3, "", 0), 3u);
+}
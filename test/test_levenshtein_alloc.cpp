@@ -0,0 +1,68 @@
+#include <atomic>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <levenshtein_myers.hpp>
+#include <new>
+#include <random>
+#include <string>
+#include "levenshtein_test_util.hpp"
+
+// Built as its own executable: the replacement operator new below counts
+// every allocation in the binary, and must not reach the other suites.
+
+static std::atomic<size_t> allocations{0};
+
+void *operator new(size_t size) {
+  allocations++;
+  if (void *p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+// Kept out of line so the compiler never pairs a new-expression with free
+__attribute__((noinline)) void operator delete(void *p) noexcept {
+  std::free(p);
+}
+__attribute__((noinline)) void operator delete(void *p, size_t) noexcept {
+  std::free(p);
+}
+
+// Once the workspace has seen the longest query, no call allocates
+TEST(LevenshteinWorkspaceTest, WarmCallsDoNotAllocate) {
+  std::mt19937 rng(43);
+  std::vector<std::string> strs(64);
+  for (auto &s : strs)
+    s = random_bytes(rng, 700);
+  strs[0] = std::string(700, 'x');
+
+  MyersWorkspace ws;
+  levenshtein_workspace_reserve(ws, 700);
+  // Warm the per-thread workspaces as well
+  levenshtein_myers_anyx1(strs[0].data(), 700, strs[1].data(), 10);
+  levenshtein_myers_anyx1_bounded(strs[0].data(), 700, strs[1].data(), 700,
+                                  5);
+
+  std::vector<uint32_t> got(strs.size() * 4);
+  size_t before = allocations.load();
+  for (size_t i = 0; i < strs.size(); i++) {
+    const auto &a = strs[i], &b = strs[(i * 7 + 3) % strs.size()];
+    got[4 * i] = levenshtein_myers_anyx1(a.data(), a.size(), b.data(),
+                                         b.size(), ws);
+    got[4 * i + 1] =
+        levenshtein_myers_anyx1(a.data(), a.size(), b.data(), b.size());
+    got[4 * i + 2] = levenshtein_myers_anyx1_bounded(
+        a.data(), a.size(), b.data(), b.size(), 50, ws);
+    got[4 * i + 3] = levenshtein_myers_anyx1_bounded(a.data(), a.size(),
+                                                     b.data(), b.size(), 50);
+  }
+  EXPECT_EQ(allocations.load(), before);
+
+  for (size_t i = 0; i < strs.size(); i++) {
+    const auto &a = strs[i], &b = strs[(i * 7 + 3) % strs.size()];
+    uint32_t ref = levenshtein_reference(a, b);
+    EXPECT_EQ(got[4 * i], ref);
+    EXPECT_EQ(got[4 * i + 1], ref);
+    EXPECT_EQ(got[4 * i + 2], std::min(ref, 51u));
+    EXPECT_EQ(got[4 * i + 3], std::min(ref, 51u));
+  }
+}
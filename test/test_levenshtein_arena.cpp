@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <levenshtein_arena.hpp>
+#include <levenshtein_distance.hpp>
+#include <random>
+#include <string>
+#include "levenshtein_test_util.hpp"
+
+TEST(LevenshteinArenaTest, AlignedStableAndPadded) {
+  std::mt19937 rng(42);
+  MyersArena arena;
+  levenshtein_arena_init(arena, 300);
+  std::vector<std::string> words(2000);
+  for (auto &w : words) {
+    w = random_string(rng, 300);
+    ASSERT_NE(levenshtein_arena_add(arena, w.data(), w.size()), nullptr);
+  }
+  EXPECT_GT(arena.chunks.size(), 1u);
+  EXPECT_EQ(levenshtein_arena_add(arena, std::string(301, 'a').data(), 301),
+            nullptr);
+  ASSERT_EQ(arena.wrds.size(), words.size());
+
+  for (size_t i = 0; i < words.size(); i++) {
+    const char *w = arena.wrds[i];
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(w) % MYERS_ARENA_ALIGN, 0u);
+    ASSERT_EQ(std::string(w, arena.lens[i]), words[i]);
+    // Reading on to max_len stays within a-z
+    for (int j = arena.lens[i]; j < arena.max_len; j++)
+      ASSERT_TRUE(w[j] >= 'a' && w[j] <= 'z') << i << " " << j;
+  }
+}
+
+TEST(LevenshteinArenaTest, ClearKeepsChunksForReuse) {
+  MyersArena arena;
+  levenshtein_arena_init(arena, 64);
+  std::string w(64, '\x01');
+  for (int i = 0; i < 5000; i++)
+    levenshtein_arena_add(arena, w.data(), w.size());
+  size_t chunks = arena.chunks.size();
+  ASSERT_GT(chunks, 1u);
+
+  // Refilling to the same volume reuses every chunk; each one is padded
+  // with 'a' again, not just the first
+  for (int round = 0; round < 2; round++) {
+    levenshtein_arena_clear(arena);
+    EXPECT_EQ(arena.chunks.size(), chunks);
+    EXPECT_TRUE(arena.wrds.empty());
+    for (int i = 0; i < 5000; i++) {
+      const char *p = levenshtein_arena_add(arena, "ab", 2);
+      for (int j = 2; j < 64; j++)
+        ASSERT_EQ(p[j], 'a') << i;
+      levenshtein_arena_add(arena, w.data(), 48);
+    }
+    EXPECT_EQ(arena.chunks.size(), chunks);
+  }
+}
+
+// Inputs built once from the arena, reused for every query
+TEST(LevenshteinArenaTest, InputsMatchAnyx1) {
+  std::mt19937 rng(43);
+  MyersArena arena;
+  levenshtein_arena_init(arena, 40);
+  std::vector<std::string> words(45);
+  for (auto &w : words) {
+    w = random_string(rng, 40, 'd');
+    levenshtein_arena_add(arena, w.data(), w.size());
+  }
+
+  std::vector<Myers16x8Input> inputs16;
+  std::vector<Myers32x4Input> inputs32;
+  ASSERT_TRUE(levenshtein_arena_inputs(arena, inputs16, nullptr));
+  ASSERT_TRUE(levenshtein_arena_inputs(arena, inputs32, nullptr));
+  ASSERT_EQ(inputs16.size(), 6u);
+  ASSERT_EQ(inputs32.size(), 12u);
+
+  for (int iter = 0; iter < 20; iter++) {
+    auto q16 = random_string(rng, 16, 'd');
+    auto q32 = random_string(rng, 32, 'd');
+    for (size_t g = 0; g < inputs16.size(); g++) {
+      inputs16[g].q_wrd = q16.data();
+      inputs16[g].q_wrd_len = q16.size();
+      auto r = levenshtein_myers_16x8(inputs16[g]);
+      for (size_t k = 0; k < 8 && g * 8 + k < words.size(); k++) {
+        const auto &w = words[g * 8 + k];
+        ASSERT_EQ(r[k], levenshtein_myers_anyx1(q16.data(), q16.size(),
+                                                w.data(), w.size()));
+      }
+    }
+    for (size_t g = 0; g < inputs32.size(); g++) {
+      inputs32[g].q_wrd = q32.data();
+      inputs32[g].q_wrd_len = q32.size();
+      auto r = levenshtein_myers_32x4(inputs32[g]);
+      for (size_t k = 0; k < 4 && g * 4 + k < words.size(); k++) {
+        const auto &w = words[g * 4 + k];
+        ASSERT_EQ(r[k], levenshtein_myers_anyx1(q32.data(), q32.size(),
+                                                w.data(), w.size()));
+      }
+    }
+  }
+}
+
+TEST(LevenshteinArenaTest, InputsRejectLongWordsForNarrowLanes) {
+  MyersArena arena;
+  levenshtein_arena_init(arena, 1000);
+  std::string w(300, 'b');
+  levenshtein_arena_add(arena, w.data(), w.size());
+  std::vector<Myers8x16Input> inputs8;
+  std::vector<Myers16x8Input> inputs16;
+  std::string error;
+  EXPECT_FALSE(levenshtein_arena_inputs(arena, inputs8, &error));
+  EXPECT_EQ(error, "word too long for the lane type");
+  EXPECT_TRUE(levenshtein_arena_inputs(arena, inputs16, &error));
+}
+
+TEST(LevenshteinArenaTest, DistanceMatchesAnyx1) {
+  std::mt19937 rng(44);
+  for (int iter = 0; iter < 100; iter++) {
+    MyersArena arena;
+    int max_len = iter % 4 == 0 ? 300 : 70;
+    levenshtein_arena_init(arena, max_len);
+    std::vector<std::string> words(rng() % 50);
+    for (auto &w : words) {
+      w = random_string(rng, max_len, 'd');
+      levenshtein_arena_add(arena, w.data(), w.size());
+    }
+    static const int q_lens[] = {8, 16, 32, 64, 200};
+    auto q = random_string(rng, q_lens[iter % 5], 'd');
+    std::vector<uint32_t> distances(words.size());
+    levenshtein_distance(q.data(), q.size(), arena, distances.data());
+    for (size_t i = 0; i < words.size(); i++)
+      ASSERT_EQ(distances[i],
+                levenshtein_myers_anyx1(q.data(), q.size(), words[i].data(),
+                                        words[i].size()))
+          << "q=" << q << " d=" << words[i];
+  }
+}
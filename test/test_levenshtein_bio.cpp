@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <levenshtein_bio.hpp>
+#include <random>
+#include <string>
+#include "levenshtein_test_util.hpp"
+
+static std::string reverse_complement(const std::string &s) {
+  std::string rc(s.rbegin(), s.rend());
+  for (auto &c : rc)
+    c = c == 'A' ? 'T' : c == 'C' ? 'G' : c == 'G' ? 'C' : 'A';
+  return rc;
+}
+
+// Packed into a buffer of exactly MYERS_DNA_BYTES(len) bytes, so reads past
+// the end show up under sanitizers
+static std::vector<uint8_t> pack(const std::string &s) {
+  std::vector<uint8_t> packed(MYERS_DNA_BYTES(s.size()));
+  EXPECT_TRUE(levenshtein_dna_pack(s.data(), s.size(), packed.data()));
+  return packed;
+}
+
+TEST(LevenshteinBioTest, PackRoundTrip) {
+  std::string seq = "ACGTtgcaAACCGGTTa";
+  auto packed = pack(seq);
+  ASSERT_EQ(packed.size(), 5u);
+  for (size_t i = 0; i < seq.size(); i++)
+    EXPECT_EQ(levenshtein_dna_base(packed.data(), i), toupper(seq[i]));
+  uint8_t buf[2];
+  EXPECT_FALSE(levenshtein_dna_pack("ACGN", 4, buf));
+  // An empty sequence needs no buffer
+  EXPECT_TRUE(levenshtein_dna_pack("", 0, nullptr));
+
+  uint8_t codes[4];
+  ASSERT_TRUE(levenshtein_protein_encode("AcWy", 4, codes));
+  EXPECT_EQ(codes[0], 0);
+  EXPECT_EQ(codes[1], 1);
+  EXPECT_EQ(codes[2], 18);
+  EXPECT_EQ(codes[3], 19);
+  EXPECT_FALSE(levenshtein_protein_encode("ABC", 3, codes));
+}
+
+TEST(LevenshteinBioTest, DnaMatchesReference) {
+  std::mt19937 rng(46);
+  for (int iter = 0; iter < 2000; iter++) {
+    int q_max = iter % 2 == 0 ? 64 : 32;
+    std::string q = random_string(rng, 0, q_max, "ACGT");
+    std::string d[4];
+    for (auto &s : d)
+      s = random_string(rng, 0, iter % 5 == 0 ? 200 : 80, "ACGT");
+    auto q_packed = pack(q);
+    std::vector<uint8_t> d_packed[4];
+    for (int l = 0; l < 4; l++)
+      d_packed[l] = pack(d[l]);
+
+    for (int strand : {MYERS_DNA_FORWARD, MYERS_DNA_REVCOMP}) {
+      uint32_t expected[4];
+      for (int l = 0; l < 4; l++)
+        expected[l] = levenshtein_reference(
+            q, strand == MYERS_DNA_REVCOMP ? reverse_complement(d[l]) : d[l]);
+
+      ASSERT_EQ(levenshtein_dna_64x1(q_packed.data(), q.size(),
+                                     d_packed[0].data(), d[0].size(), strand),
+                expected[0])
+          << "q=" << q << " d=" << d[0] << " strand=" << strand;
+
+      MyersDna64x2Input in2{q_packed.data(), int(q.size()),
+                            {d_packed[0].data(), d_packed[1].data()},
+                            {d[0].size(), d[1].size()}};
+      auto r2 = levenshtein_dna_64x2(in2, strand);
+      for (int l = 0; l < 2; l++)
+        ASSERT_EQ(r2[l], expected[l]) << "q=" << q << " d=" << d[l];
+
+      if (q.size() > 32)
+        continue;
+      MyersDna32x4Input in4{q_packed.data(), int(q.size()), {}, {}};
+      for (int l = 0; l < 4; l++) {
+        in4.d_seqs[l] = d_packed[l].data();
+        in4.d_lens[l] = d[l].size();
+      }
+      auto r4 = levenshtein_dna_32x4(in4, strand);
+      for (int l = 0; l < 4; l++)
+        ASSERT_EQ(r4[l], expected[l]) << "q=" << q << " d=" << d[l];
+    }
+  }
+}
+
+TEST(LevenshteinBioTest, ProteinMatchesReference) {
+  std::mt19937 rng(47);
+  for (int iter = 0; iter < 2000; iter++) {
+    std::string q = random_string(rng, 0, 64, MYERS_PROTEIN_ALPHABET);
+    std::string d[2];
+    for (auto &s : d)
+      s = random_string(rng, 0, 100, MYERS_PROTEIN_ALPHABET);
+    std::vector<uint8_t> q_codes(q.size()), d_codes[2];
+    ASSERT_TRUE(levenshtein_protein_encode(q.data(), q.size(), q_codes.data()));
+    for (int l = 0; l < 2; l++) {
+      d_codes[l].resize(d[l].size());
+      ASSERT_TRUE(levenshtein_protein_encode(d[l].data(), d[l].size(),
+                                             d_codes[l].data()));
+    }
+
+    ASSERT_EQ(levenshtein_protein_64x1(q_codes.data(), q.size(),
+                                       d_codes[0].data(), d[0].size()),
+              levenshtein_reference(q, d[0]))
+        << "q=" << q << " d=" << d[0];
+    MyersProtein64x2Input in{q_codes.data(), int(q.size()),
+                             {d_codes[0].data(), d_codes[1].data()},
+                             {d[0].size(), d[1].size()}};
+    auto r = levenshtein_protein_64x2(in);
+    for (int l = 0; l < 2; l++)
+      ASSERT_EQ(r[l], levenshtein_reference(q, d[l]))
+          << "q=" << q << " d=" << d[l];
+  }
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <levenshtein_column.hpp>
+#include <levenshtein_distance.hpp>
+#include <random>
+#include <string>
+#include "levenshtein_test_util.hpp"
+
+// The buffers of an Arrow string array. The value buffer is sized exactly,
+// so a read past the last row leaves the allocation.
+struct Column {
+  std::vector<std::string> rows;
+  std::vector<bool> valid;
+  std::unique_ptr<char[]> data;
+  std::vector<int32_t> offsets32;
+  std::vector<int64_t> offsets64;
+  std::vector<uint8_t> validity;
+
+  // Rows are stored after `slice` leading slots, as in a sliced array
+  MyersStringColumn view(int slice, bool large, bool nulls) {
+    size_t total = 0;
+    for (auto &r : rows)
+      total += r.size();
+    data.reset(new char[total + slice]);
+    std::fill(data.get(), data.get() + slice, 'a');
+    offsets32.assign(slice, 0);
+    for (int i = 0; i < slice; i++)
+      offsets32[i] = i;
+    validity.assign((slice + rows.size()) / 8 + 1, 0);
+    size_t off = slice;
+    for (size_t i = 0; i < rows.size(); i++) {
+      offsets32.push_back(off);
+      // Null slots are empty, as Arrow writers leave them
+      if (valid[i] || !nulls) {
+        std::copy(rows[i].begin(), rows[i].end(), data.get() + off);
+        off += rows[i].size();
+        validity[(slice + i) / 8] |= 1 << ((slice + i) % 8);
+      }
+    }
+    offsets32.push_back(off);
+    offsets64.assign(offsets32.begin(), offsets32.end());
+
+    MyersStringColumn col;
+    col.data = data.get();
+    if (large)
+      col.offsets64 = offsets64.data();
+    else
+      col.offsets32 = offsets32.data();
+    col.validity = nulls ? validity.data() : nullptr;
+    col.offset = slice;
+    col.length = rows.size();
+    return col;
+  }
+};
+
+static Column random_column(std::mt19937 &rng, size_t n, int max_len) {
+  Column c;
+  for (size_t i = 0; i < n; i++) {
+    c.rows.push_back(random_string(rng, max_len, 'e'));
+    c.valid.push_back(rng() % 5 != 0);
+  }
+  return c;
+}
+
+TEST(LevenshteinColumnTest, ScanMatchesDistance) {
+  std::mt19937 rng(47);
+  for (int iter = 0; iter < 200; iter++) {
+    static const int max_lens[] = {8, 16, 40, 64, 100};
+    int max_len = max_lens[iter % 5];
+    bool nulls = iter % 2 == 0;
+    Column c = random_column(rng, rng() % 60, max_len);
+    MyersStringColumn col = c.view(iter % 11, iter % 3 == 0, nulls);
+    std::string q = random_string(rng, max_len, 'e');
+
+    std::vector<uint32_t> distances(c.rows.size());
+    levenshtein_column_scan(q.data(), q.size(), col, UINT32_MAX,
+                            distances.data());
+    std::vector<uint32_t> bounded(c.rows.size());
+    uint32_t max_dist = iter % 4;
+    levenshtein_column_scan(q.data(), q.size(), col, max_dist,
+                            bounded.data());
+    for (size_t i = 0; i < c.rows.size(); i++) {
+      if (nulls && !c.valid[i]) {
+        ASSERT_EQ(distances[i], MYERS_COLUMN_NULL);
+        ASSERT_EQ(bounded[i], MYERS_COLUMN_NULL);
+        continue;
+      }
+      uint32_t d = levenshtein_distance(q.data(), q.size(), c.rows[i].data(),
+                                        c.rows[i].size());
+      ASSERT_EQ(distances[i], d) << "q=" << q << " row=" << c.rows[i];
+      if (d <= max_dist)
+        ASSERT_EQ(bounded[i], d);
+      else
+        ASSERT_GT(bounded[i], max_dist);
+    }
+  }
+}
+
+TEST(LevenshteinColumnTest, TopKMatchesSortedScan) {
+  std::mt19937 rng(48);
+  for (int iter = 0; iter < 200; iter++) {
+    Column c = random_column(rng, rng() % 100, iter % 2 ? 12 : 50);
+    MyersStringColumn col = c.view(iter % 5, iter % 2 == 0, true);
+    std::string q = random_string(rng, iter % 2 ? 12 : 50, 'e');
+    size_t k = rng() % 20;
+
+    std::vector<MyersColumnHit> expected;
+    for (size_t i = 0; i < c.rows.size(); i++)
+      if (c.valid[i])
+        expected.push_back(
+            {i, levenshtein_distance(q.data(), q.size(), c.rows[i].data(),
+                                     c.rows[i].size())});
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](auto &a, auto &b) { return a.distance < b.distance; });
+    expected.resize(std::min(k, expected.size()));
+
+    std::vector<MyersColumnHit> hits(k);
+    size_t n = levenshtein_column_top_k(q.data(), q.size(), col, k,
+                                        hits.data());
+    ASSERT_EQ(n, expected.size());
+    for (size_t i = 0; i < n; i++) {
+      EXPECT_EQ(hits[i].row, expected[i].row);
+      EXPECT_EQ(hits[i].distance, expected[i].distance);
+    }
+  }
+}
+
+TEST(LevenshteinColumnTest, PairwiseMasksNulls) {
+  std::mt19937 rng(49);
+  Column a = random_column(rng, 300, 80);
+  Column b = random_column(rng, 300, 80);
+  MyersStringColumn a_col = a.view(3, false, true);
+  MyersStringColumn b_col = b.view(0, true, true);
+
+  std::vector<uint32_t> distances(300);
+  levenshtein_column_pairwise(a_col, b_col, distances.data());
+  for (size_t i = 0; i < 300; i++) {
+    if (!a.valid[i] || !b.valid[i])
+      EXPECT_EQ(distances[i], MYERS_COLUMN_NULL);
+    else
+      EXPECT_EQ(distances[i],
+                levenshtein_distance(a.rows[i].data(), a.rows[i].size(),
+                                     b.rows[i].data(), b.rows[i].size()));
+  }
+}
@@ -0,0 +1,239 @@
+#include <gtest/gtest.h>
+#include <levenshtein_dictionary.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include "levenshtein_test_util.hpp"
+
+static std::string temp_path(const char *name) {
+  return ::testing::TempDir() + name;
+}
+
+TEST(LevenshteinDictionaryTest, RoundTrip) {
+  std::vector<std::string> words = {"hello", "help", "a", "", "world",
+                                    "word", "hello"};
+  std::string path = temp_path("roundtrip.dict");
+  std::string error;
+  ASSERT_TRUE(levenshtein_dictionary_build(words, path.c_str(), &error))
+      << error;
+
+  MyersDictionary dict;
+  ASSERT_TRUE(levenshtein_dictionary_open(dict, path.c_str(), &error))
+      << error;
+  EXPECT_EQ(dict.header->n_words, words.size());
+  EXPECT_EQ(dict.header->n_buckets, 4u);
+
+  for (uint32_t i = 0; i < dict.header->n_words; i++) {
+    int len;
+    const char *w = levenshtein_dictionary_word(dict, i, &len);
+    EXPECT_EQ(std::string(w, len), words[dict.ids[i]]);
+  }
+  levenshtein_dictionary_close(dict);
+  std::remove(path.c_str());
+}
+
+TEST(LevenshteinDictionaryTest, RejectsInvalidWords) {
+  std::string error;
+  EXPECT_FALSE(levenshtein_dictionary_build({"ok", "Not ok"},
+                                            temp_path("bad.dict").c_str(),
+                                            &error));
+  EXPECT_FALSE(error.empty());
+}
+
+TEST(LevenshteinDictionaryTest, RejectsCorruptImages) {
+  std::vector<std::string> words = {"alpha", "beta", "gamma"};
+  std::string path = temp_path("corrupt.dict");
+  ASSERT_TRUE(levenshtein_dictionary_build(words, path.c_str(), nullptr));
+
+  std::ifstream in(path, std::ios::binary);
+  std::string bytes((std::istreambuf_iterator<char>(in)),
+                    std::istreambuf_iterator<char>());
+  std::remove(path.c_str());
+
+  alignas(64) static uint8_t image[1 << 12];
+  ASSERT_LE(bytes.size(), sizeof(image));
+
+  MyersDictionary dict;
+  std::memcpy(image, bytes.data(), bytes.size());
+  EXPECT_TRUE(levenshtein_dictionary_from_memory(dict, image, bytes.size(),
+                                                 nullptr));
+
+  // Truncated
+  EXPECT_FALSE(levenshtein_dictionary_from_memory(dict, image,
+                                                  bytes.size() - 64, nullptr));
+
+  // Bad magic
+  image[0] ^= 1;
+  EXPECT_FALSE(levenshtein_dictionary_from_memory(dict, image, bytes.size(),
+                                                  nullptr));
+  image[0] ^= 1;
+
+  // Tampered bucket table
+  auto *header = (MyersDictHeader *)image;
+  image[header->buckets_off] ^= 1;
+  std::string error;
+  EXPECT_FALSE(levenshtein_dictionary_from_memory(dict, image, bytes.size(),
+                                                  &error));
+  EXPECT_EQ(error, "checksum mismatch");
+}
+
+TEST(LevenshteinDictionaryTest, ScanMatchesPairwise) {
+  std::mt19937 rng(1337);
+  auto words = random_strings(rng, 500, 0, 80);
+  std::string path = temp_path("scan.dict");
+  ASSERT_TRUE(levenshtein_dictionary_build(words, path.c_str(), nullptr));
+
+  MyersDictionary dict;
+  ASSERT_TRUE(levenshtein_dictionary_open(dict, path.c_str(), nullptr));
+
+  auto queries = random_strings(rng, 40, 0, 80);
+  std::vector<uint32_t> distances(words.size());
+  for (const auto &q : queries) {
+    levenshtein_dictionary_scan(dict, q.c_str(), q.size(), distances.data());
+    for (size_t i = 0; i < words.size(); i++) {
+      uint32_t ref = levenshtein_myers_anyx1(q.c_str(), q.size(),
+                                             words[i].c_str(), words[i].size());
+      ASSERT_EQ(distances[i], ref) << "q=" << q << " d=" << words[i];
+    }
+  }
+  levenshtein_dictionary_close(dict);
+  std::remove(path.c_str());
+}
+
+TEST(LevenshteinDictionaryTest, ScanWithinMatchesPairwise) {
+  std::mt19937 rng(42);
+  auto words = random_strings(rng, 2000, 0, 20);
+  // Near-duplicates so that every threshold has matches
+  for (int i = 0; i < 200; i++) {
+    std::string w = words[i];
+    if (!w.empty())
+      w[rng() % w.size()] = 'a' + rng() % 26;
+    words.push_back(w + "x");
+  }
+  std::string path = temp_path("within.dict");
+  ASSERT_TRUE(levenshtein_dictionary_build(words, path.c_str(), nullptr));
+
+  MyersDictionary dict;
+  ASSERT_TRUE(levenshtein_dictionary_open(dict, path.c_str(), nullptr));
+
+  for (int qi = 0; qi < 50; qi++) {
+    const std::string &q = words[qi];
+    for (uint32_t k = 0; k <= 4; k++) {
+      std::vector<MyersScanMatch> matches;
+      MyersScanStats stats = {};
+      levenshtein_dictionary_scan_within(dict, q.c_str(), q.size(), k, matches,
+                                         &stats);
+
+      std::vector<std::pair<uint32_t, uint32_t>> got, want;
+      for (const auto &m : matches)
+        got.push_back({m.id, m.distance});
+      for (uint32_t i = 0; i < words.size(); i++) {
+        uint32_t d = levenshtein_myers_anyx1(q.c_str(), q.size(),
+                                             words[i].c_str(), words[i].size());
+        if (d <= k)
+          want.push_back({i, d});
+      }
+      std::sort(got.begin(), got.end());
+      EXPECT_EQ(got, want) << "q=" << q << " k=" << k;
+
+      EXPECT_EQ(stats.candidates, words.size());
+      EXPECT_EQ(stats.rejected_length + stats.rejected_histogram +
+                    stats.verified,
+                stats.candidates);
+      EXPECT_EQ(stats.matches, want.size());
+      EXPECT_GT(stats.rejected_length, 0u);
+    }
+  }
+  levenshtein_dictionary_close(dict);
+  std::remove(path.c_str());
+}
+
+TEST(LevenshteinDictionaryTest, HistogramBoundIsTight) {
+  // "abc" is 2 edits from "aa" with a histogram L1 of 3: past 2 * max_dist
+  // for max_dist 1, so the histogram filter rejects it before the kernel
+  std::string path = temp_path("tight.dict");
+  ASSERT_TRUE(
+      levenshtein_dictionary_build({"abc", "ab"}, path.c_str(), nullptr));
+  MyersDictionary dict;
+  ASSERT_TRUE(levenshtein_dictionary_open(dict, path.c_str(), nullptr));
+
+  std::vector<MyersScanMatch> matches;
+  MyersScanStats stats = {};
+  levenshtein_dictionary_scan_within(dict, "aa", 2, 1, matches, &stats);
+  ASSERT_EQ(matches.size(), 1u);
+  EXPECT_EQ(matches[0].id, 1u);
+  EXPECT_EQ(stats.rejected_histogram, 1u);
+  EXPECT_EQ(stats.verified, 1u);
+  levenshtein_dictionary_close(dict);
+  std::remove(path.c_str());
+}
+
+TEST(LevenshteinDictionaryTest, CompactAndHistogramModes) {
+  std::mt19937 rng(7);
+  auto words = random_strings(rng, 700, 0, 80);
+  for (int i = 0; i < 100; i++)
+    words.push_back(words[i] + "q");
+  std::string path = temp_path("modes.dict");
+  ASSERT_TRUE(levenshtein_dictionary_build(words, path.c_str(), nullptr));
+
+  MyersDictionary dict;
+  ASSERT_TRUE(levenshtein_dictionary_open(dict, path.c_str(), nullptr));
+
+  std::vector<uint32_t> ids(words.size());
+  for (int qi = 0; qi < 60; qi++) {
+    const std::string &q = words[qi];
+    std::vector<uint32_t> ref(words.size());
+    for (size_t i = 0; i < words.size(); i++)
+      ref[i] = levenshtein_myers_anyx1(q.c_str(), q.size(), words[i].c_str(),
+                                       words[i].size());
+
+    for (uint32_t k : {0u, 1u, 3u, 20u, 300u}) {
+      std::vector<uint32_t> want;
+      for (uint32_t i = 0; i < words.size(); i++) {
+        if (ref[i] <= k)
+          want.push_back(i);
+      }
+      size_t n = levenshtein_dictionary_scan_ids(dict, q.c_str(), q.size(), k,
+                                                 ids.data());
+      std::vector<uint32_t> got(ids.begin(), ids.begin() + n);
+      std::sort(got.begin(), got.end());
+      EXPECT_EQ(got, want) << "q=" << q << " k=" << k;
+      EXPECT_EQ(levenshtein_dictionary_count_within(dict, q.c_str(), q.size(),
+                                                    k),
+                want.size());
+    }
+
+    for (int n_bins : {1, 8, 100}) {
+      std::vector<uint64_t> want(n_bins), got(n_bins);
+      for (uint32_t d : ref)
+        want[std::min<uint32_t>(d, n_bins - 1)]++;
+      levenshtein_dictionary_scan_histogram(dict, q.c_str(), q.size(),
+                                            got.data(), n_bins);
+      EXPECT_EQ(got, want) << "q=" << q << " bins=" << n_bins;
+    }
+  }
+  levenshtein_dictionary_close(dict);
+  std::remove(path.c_str());
+}
+
+TEST(LevenshteinDictionaryTest, BuildInMemoryMatchesFile) {
+  std::vector<std::string> words = {"hello", "help", "", "world"};
+  std::string path = temp_path("in_memory.dict");
+  ASSERT_TRUE(levenshtein_dictionary_build(words, path.c_str(), nullptr));
+  std::ifstream in(path, std::ios::binary);
+  std::string bytes((std::istreambuf_iterator<char>(in)),
+                    std::istreambuf_iterator<char>());
+  std::remove(path.c_str());
+
+  std::vector<uint8_t> image;
+  ASSERT_TRUE(levenshtein_dictionary_build(words, image, nullptr));
+  EXPECT_EQ(std::string(image.begin(), image.end()), bytes);
+  MyersDictionary dict;
+  ASSERT_TRUE(levenshtein_dictionary_from_memory(dict, image.data(),
+                                                 image.size(), nullptr));
+  EXPECT_EQ(dict.header->n_words, 4u);
+  levenshtein_dictionary_close(dict);
+}
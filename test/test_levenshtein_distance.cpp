@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <levenshtein_distance.hpp>
+#include <random>
+#include <string>
+#include "levenshtein_test_util.hpp"
+
+TEST(LevenshteinDistanceTest, PlanClasses) {
+  EXPECT_EQ(levenshtein_plan_class(0), 0);
+  EXPECT_EQ(levenshtein_plan_class(8), 0);
+  EXPECT_EQ(levenshtein_plan_class(9), 1);
+  EXPECT_EQ(levenshtein_plan_class(17), 2);
+  EXPECT_EQ(levenshtein_plan_class(64), 3);
+  EXPECT_EQ(levenshtein_plan_class(65), 4);
+  EXPECT_EQ(levenshtein_plan_class(1000), 4);
+  EXPECT_STREQ(levenshtein_kernel_name(MYERS_KERNEL_16X8), "16x8");
+
+  MyersPlan plan = levenshtein_plan_default();
+  EXPECT_TRUE(levenshtein_plan_valid(plan));
+  // 16x8 cannot take a 17-32 character pattern
+  plan.classes[2].batch = MYERS_KERNEL_16X8;
+  EXPECT_FALSE(levenshtein_plan_valid(plan));
+  plan = levenshtein_plan_default();
+  plan.classes[0].single = MYERS_KERNEL_8X16;
+  EXPECT_FALSE(levenshtein_plan_valid(plan));
+}
+
+TEST(LevenshteinDistanceTest, SinglePairMatchesAnyx1) {
+  std::mt19937 rng(21);
+  for (int iter = 0; iter < 20000; iter++) {
+    int max_len = iter % 4 == 0 ? 300 : 70;
+    auto a = random_string(rng, max_len, iter % 2 ? 'z' : 'c');
+    auto b = random_string(rng, max_len, iter % 2 ? 'z' : 'c');
+    ASSERT_EQ(levenshtein_distance(a.c_str(), a.size(), b.c_str(), b.size()),
+              levenshtein_myers_anyx1(a.c_str(), a.size(), b.c_str(),
+                                      b.size()))
+        << "a=" << a << " b=" << b;
+  }
+}
+
+// Words of any length and without padding, across every length class and
+// batch sizes on both sides of min_batch
+TEST(LevenshteinDistanceTest, BatchMatchesSinglePair) {
+  std::mt19937 rng(22);
+  for (int iter = 0; iter < 600; iter++) {
+    static const int q_lens[] = {8, 16, 32, 64, 200};
+    auto q = random_string(rng, q_lens[iter % 5], 'd');
+    size_t n = rng() % 40;
+    std::vector<std::string> words(n);
+    std::vector<const char *> wrds(n);
+    std::vector<int> lens(n);
+    for (size_t i = 0; i < n; i++) {
+      words[i] = random_string(rng, iter % 5 == 0 ? 400 : 80, 'd');
+      wrds[i] = words[i].data();
+      lens[i] = words[i].size();
+    }
+
+    std::vector<uint32_t> distances(n);
+    levenshtein_distance(q.c_str(), q.size(), wrds.data(), lens.data(), n,
+                         distances.data());
+    for (size_t i = 0; i < n; i++)
+      ASSERT_EQ(distances[i],
+                levenshtein_myers_anyx1(q.c_str(), q.size(), wrds[i], lens[i]))
+          << "q=" << q << " d=" << words[i];
+  }
+}
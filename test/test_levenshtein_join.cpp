@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <levenshtein_join.hpp>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <tuple>
+#include "levenshtein_test_util.hpp"
+
+// Copies of `strs` with up to `edits` random edits each
+static std::vector<std::string> mutate(std::mt19937 &rng,
+                                       const std::vector<std::string> &strs,
+                                       int edits) {
+  std::vector<std::string> out;
+  for (auto s : strs) {
+    int n = rng() % (edits + 1);
+    for (int e = 0; e < n; e++) {
+      int op = rng() % 3;
+      if (s.empty() || op == 0)
+        s.insert(s.begin() + rng() % (s.size() + 1), 'a' + rng() % 5);
+      else if (op == 1)
+        s.erase(s.begin() + rng() % s.size());
+      else
+        s[rng() % s.size()] = 'a' + rng() % 5;
+    }
+    out.push_back(s);
+  }
+  return out;
+}
+
+using Triple = std::tuple<uint32_t, uint32_t, uint32_t>;
+
+static std::vector<Triple> nested_loop(const std::vector<std::string> &left,
+                                       const std::vector<std::string> &right,
+                                       uint32_t k) {
+  std::vector<Triple> want;
+  for (uint32_t a = 0; a < left.size(); a++) {
+    for (uint32_t b = 0; b < right.size(); b++) {
+      uint32_t d = levenshtein_myers_anyx1(left[a].c_str(), left[a].size(),
+                                           right[b].c_str(), right[b].size());
+      if (d <= k)
+        want.push_back({a, b, d});
+    }
+  }
+  return want;
+}
+
+TEST(LevenshteinJoinTest, MatchesNestedLoop) {
+  std::mt19937 rng(99);
+  auto right = random_strings(rng, 400, 0, 90, 'e');
+  auto left = mutate(rng, right, 4);
+  auto extra = random_strings(rng, 200, 0, 20, 'e');
+  left.insert(left.end(), extra.begin(), extra.end());
+
+  for (uint32_t k = 0; k <= 4; k++) {
+    std::vector<Triple> got;
+    MyersJoinStats stats = {};
+    levenshtein_join(
+        left, right, k,
+        [&](const MyersJoinPair *pairs, size_t n) {
+          for (size_t i = 0; i < n; i++)
+            got.push_back({pairs[i].left, pairs[i].right, pairs[i].distance});
+        },
+        3, &stats);
+    std::sort(got.begin(), got.end());
+
+    auto want = nested_loop(left, right, k);
+    EXPECT_EQ(got, want) << "k=" << k;
+    EXPECT_EQ(stats.pairs, want.size());
+    EXPECT_GE(stats.candidates, stats.pairs);
+    // The index prunes most of the cross product
+    EXPECT_LT(stats.candidates, left.size() * right.size() / 4);
+  }
+}
+
+TEST(LevenshteinJoinTest, PreallocatedBuffer) {
+  std::vector<std::string> left = {"kitten", "sitting", "abc"};
+  std::vector<std::string> right = {"sitten", "kitchen", "xyz", "abd"};
+
+  std::vector<MyersJoinPair> out(2);
+  size_t total = levenshtein_join(left, right, 2, out.data(), out.size(), 1);
+  EXPECT_EQ(total, 4u); // kitten-sitten, kitten-kitchen, sitting-sitten, abc-abd
+
+  out.resize(total);
+  EXPECT_EQ(levenshtein_join(left, right, 2, out.data(), out.size(), 1),
+            total);
+  std::vector<Triple> got;
+  for (const auto &p : out)
+    got.push_back({p.left, p.right, p.distance});
+  std::sort(got.begin(), got.end());
+  std::vector<Triple> want = {{0, 0, 1}, {0, 1, 2}, {1, 0, 2}, {2, 3, 1}};
+  EXPECT_EQ(got, want);
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <levenshtein_dictionary.hpp>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <sys/wait.h>
+#include "levenshtein_test_util.hpp"
+
+// Runs the levenshtein_match binary (LEVENSHTEIN_MATCH_PATH, set by the
+// build) on a dictionary written here, once as a word list and once as a
+// binary image, and checks its output against the DP reference.
+
+static std::string temp_path(const char *name) {
+  return ::testing::TempDir() + name;
+}
+
+static void write_file(const std::string &path, const std::string &text) {
+  std::ofstream out(path, std::ios::binary);
+  out << text;
+}
+
+// Standard output of `levenshtein_match <args>`, and its exit status
+static std::string match(const std::string &args, int *status) {
+  std::string cmd = std::string(LEVENSHTEIN_MATCH_PATH) + " " + args +
+                    " 2>/dev/null";
+  FILE *p = popen(cmd.c_str(), "r");
+  std::string out;
+  char buf[4096];
+  for (size_t n; (n = std::fread(buf, 1, sizeof(buf), p)) > 0;)
+    out.append(buf, n);
+  int rc = pclose(p);
+  *status = WIFEXITED(rc) ? WEXITSTATUS(rc) : -1;
+  return out;
+}
+
+// The reply line for one input line: every word within k, nearest first
+static std::string expected(const std::vector<std::string> &words,
+                            const std::string &line, uint32_t k) {
+  for (char c : line)
+    if (c < 'a' || c > 'z')
+      return "-\n";
+  std::vector<std::pair<uint32_t, uint32_t>> hits; // (distance, id)
+  for (uint32_t id = 0; id < words.size(); id++) {
+    uint32_t d = levenshtein_reference(line, words[id]);
+    if (d <= k)
+      hits.push_back({d, id});
+  }
+  std::sort(hits.begin(), hits.end());
+  std::string out = std::to_string(hits.size());
+  for (const auto &[d, id] : hits)
+    out += " " + std::to_string(id) + ":" + std::to_string(d);
+  return out + "\n";
+}
+
+// Both dictionary formats, one and several workers and small batches: the
+// output is the reference's, in input order, with the same ids
+TEST(LevenshteinMatchTest, MatchesReferenceForBothFormats) {
+  std::mt19937 rng(50);
+  std::vector<std::string> words = random_strings(rng, 300, 1, 12, 'e');
+  // A line outside a-z is skipped by both loaders and takes no id
+  std::string word_list;
+  for (size_t i = 0; i < words.size(); i++)
+    word_list += (i == 100 ? "Skipped-line\n" : "") + words[i] + "\n";
+
+  std::string text_path = temp_path("match_words.txt");
+  std::string dict_path = temp_path("match_words.dict");
+  std::string input_path = temp_path("match_input.txt");
+  write_file(text_path, word_list);
+  std::string error;
+  ASSERT_TRUE(levenshtein_dictionary_build(words, dict_path.c_str(), &error))
+      << error;
+
+  std::string input;
+  std::vector<std::string> lines;
+  for (int i = 0; i < 200; i++) {
+    std::string line = random_string(rng, 0, i % 20 ? 14 : 80, letters('e'));
+    if (i % 37 == 5)
+      line += "X";
+    lines.push_back(line);
+    input += line + "\n";
+  }
+  write_file(input_path, input);
+
+  for (uint32_t k : {0u, 1u, 3u}) {
+    std::string want;
+    for (const auto &line : lines)
+      want += expected(words, line, k);
+    for (const char *j : {"1", "4"}) {
+      std::string args = std::string("-j ") + j + " --batch 7 -k " +
+                         std::to_string(k) + " ";
+      int status;
+      std::string text = match(args + "--format text --dict " + text_path +
+                                   " " + input_path,
+                               &status);
+      EXPECT_EQ(status, 0);
+      std::string binary = match(args + "--format binary --dict " +
+                                     dict_path + " " + input_path,
+                                 &status);
+      EXPECT_EQ(status, 0);
+      ASSERT_EQ(text, want) << args;
+      ASSERT_EQ(binary, text) << args;
+    }
+  }
+  std::remove(text_path.c_str());
+  std::remove(dict_path.c_str());
+  std::remove(input_path.c_str());
+}
+
+// Numeric options must be whole numbers in range
+TEST(LevenshteinMatchTest, RejectsBadNumbers) {
+  std::string text_path = temp_path("match_numbers.txt");
+  write_file(text_path, "abc\n");
+  for (const char *args : {"-k -1", "-k abc", "-k 99999999999", "-j x",
+                           "--batch 0", "--batch 5q"}) {
+    int status;
+    EXPECT_EQ(match(std::string(args) + " --format text --dict " + text_path +
+                        " " + text_path,
+                    &status),
+              "")
+        << args;
+    EXPECT_EQ(status, 2) << args;
+  }
+  std::remove(text_path.c_str());
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <levenshtein_matrix.hpp>
+#include <random>
+#include <string>
+#include "levenshtein_test_util.hpp"
+
+TEST(LevenshteinMatrixTest, CondensedMatchesPairwise) {
+  std::mt19937 rng(7);
+  // More than one tile per side, and lengths that need every kernel width
+  auto strs = random_strings(rng, 600, 0, 90, 'd');
+  size_t n = strs.size();
+
+  std::vector<uint16_t> out(n * (n - 1) / 2, UINT16_MAX);
+  levenshtein_matrix_condensed(strs, out.data(), 4);
+
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = i + 1; j < n; j++) {
+      uint32_t ref = levenshtein_myers_anyx1(strs[i].c_str(), strs[i].size(),
+                                             strs[j].c_str(), strs[j].size());
+      ASSERT_EQ(out[levenshtein_condensed_index(n, i, j)], ref)
+          << "i=" << i << " j=" << j;
+    }
+  }
+}
+
+TEST(LevenshteinMatrixTest, RectangularMatchesPairwise) {
+  std::mt19937 rng(11);
+  auto queries = random_strings(rng, 300, 0, 40, 'd');
+  auto targets = random_strings(rng, 520, 0, 70, 'd');
+
+  std::vector<uint16_t> out(queries.size() * targets.size());
+  levenshtein_matrix(queries, targets, out.data(), 0);
+
+  for (size_t i = 0; i < queries.size(); i++) {
+    for (size_t j = 0; j < targets.size(); j++) {
+      uint32_t ref = levenshtein_myers_anyx1(
+          queries[i].c_str(), queries[i].size(), targets[j].c_str(),
+          targets[j].size());
+      ASSERT_EQ(out[i * targets.size() + j], ref) << "i=" << i << " j=" << j;
+    }
+  }
+}
+
+TEST(LevenshteinMatrixTest, Uint8Saturates) {
+  std::vector<std::string> strs = {"abc", std::string(300, 'a'),
+                                   std::string(300, 'b'), "abd"};
+  std::vector<uint8_t> out(6);
+  levenshtein_matrix_condensed(strs, out.data(), 1);
+
+  EXPECT_EQ(out[levenshtein_condensed_index(4, 0, 3)], 1);
+  EXPECT_EQ(out[levenshtein_condensed_index(4, 0, 1)], 255);
+  EXPECT_EQ(out[levenshtein_condensed_index(4, 1, 2)], 255);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <levenshtein_minhash.hpp>
+#include <algorithm>
+#include <random>
+#include <string>
+#include "levenshtein_test_util.hpp"
+
+static std::string random_text(std::mt19937 &rng, int min_len, int max_len) {
+  static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz  ,.0123456789";
+  std::uniform_int_distribution<int> len_dist(min_len, max_len);
+  std::string s(len_dist(rng), ' ');
+  for (auto &c : s)
+    c = alphabet[rng() % (sizeof(alphabet) - 1)];
+  return s;
+}
+
+static std::string mutate(std::mt19937 &rng, std::string s, int edits) {
+  for (int e = 0; e < edits; e++) {
+    int op = rng() % 3;
+    char c = 'a' + rng() % 26;
+    if (op == 0)
+      s[rng() % s.size()] = c;
+    else if (op == 1)
+      s.insert(s.begin() + rng() % (s.size() + 1), c);
+    else
+      s.erase(s.begin() + rng() % s.size());
+  }
+  return s;
+}
+
+TEST(LevenshteinMinHashTest, RejectsInvalidParams) {
+  MyersMinHashIndex index;
+  std::string error;
+  EXPECT_FALSE(levenshtein_minhash_build({"abc"}, {0, 8, 4, 1}, index, &error));
+  EXPECT_FALSE(levenshtein_minhash_build({"abc"}, {17, 8, 4, 1}, index,
+                                         &error));
+  EXPECT_FALSE(levenshtein_minhash_build({"abc"}, {5, 0, 4, 1}, index,
+                                         &error));
+  EXPECT_FALSE(levenshtein_minhash_build({"abc"}, {5, 64, 32, 1}, index,
+                                         &error));
+  EXPECT_FALSE(error.empty());
+}
+
+TEST(LevenshteinMinHashTest, Probability) {
+  EXPECT_DOUBLE_EQ(levenshtein_minhash_probability(1.0, 16, 4), 1.0);
+  EXPECT_DOUBLE_EQ(levenshtein_minhash_probability(0.0, 16, 4), 0.0);
+  EXPECT_NEAR(levenshtein_minhash_probability(0.5, 1, 1), 0.5, 1e-12);
+  EXPECT_GT(levenshtein_minhash_probability(0.8, 32, 4),
+            levenshtein_minhash_probability(0.8, 8, 4));
+}
+
+// Matches are always exact, and near-duplicates are found with the recall
+// the parameters promise
+TEST(LevenshteinMinHashTest, FindsNearDuplicates) {
+  std::mt19937 rng(7);
+  std::vector<std::string> strs;
+  for (int i = 0; i < 300; i++)
+    strs.push_back(random_text(rng, 200, 800));
+  for (int i = 0; i < 100; i++)
+    strs.push_back(mutate(rng, strs[i], rng() % 8));
+  strs.push_back("");
+  strs.push_back("abc");
+
+  MyersMinHashIndex index;
+  std::string error;
+  ASSERT_TRUE(levenshtein_minhash_build(strs, {5, 32, 4, 42}, index, &error))
+      << error;
+  EXPECT_GT(levenshtein_minhash_memory(index), 0u);
+
+  const uint32_t k = 10;
+  uint64_t expected = 0, found = 0;
+  for (int qi = 0; qi < 120; qi++) {
+    std::string q = mutate(rng, strs[qi], rng() % 4);
+    std::vector<MyersScanMatch> matches;
+    MyersMinHashStats stats = {};
+    levenshtein_minhash_search(index, q.c_str(), q.size(), k, matches, &stats);
+
+    EXPECT_TRUE(std::is_sorted(
+        matches.begin(), matches.end(),
+        [](const MyersScanMatch &a, const MyersScanMatch &b) {
+          return a.id < b.id;
+        }));
+    EXPECT_EQ(stats.matches, matches.size());
+    EXPECT_LE(stats.verified, stats.candidates);
+    for (const auto &m : matches) {
+      const auto &d = strs[m.id];
+      EXPECT_EQ(m.distance, levenshtein_reference(q, d));
+      EXPECT_LE(m.distance, k);
+    }
+
+    for (const auto &d : strs) {
+      size_t len_diff = std::max(q.size(), d.size()) -
+                        std::min(q.size(), d.size());
+      if (len_diff <= k && levenshtein_reference(q, d) <= k)
+        expected++;
+    }
+    found += matches.size();
+  }
+  // Every query has at least its source string within k
+  EXPECT_GE(expected, 120u);
+  EXPECT_GE(found * 100, expected * 95);
+
+  // Identical signatures always collide
+  std::vector<MyersScanMatch> matches;
+  levenshtein_minhash_search(index, "abc", 3, 0, matches, nullptr);
+  ASSERT_EQ(matches.size(), 1u);
+  EXPECT_EQ(matches[0].id, strs.size() - 1);
+}
@@ -171,3 +171,17 @@ TEST(LevenshteinMyers16x8Test, LengthLimited) {
   std::array<uint16_t, 8> expected = {4, 4, 4, 8, 16, 4, 4, 4};
   EXPECT_EQ(result, expected);
 }
+
+TEST(LevenshteinMyers16x8Test, PrefixDistance) {
+  auto input = Myers16x8Input{.q_wrd = "auto",
+                              .q_wrd_len = 4,
+                              .d_wrds = {"automobile", "autumn", "car", "atuo",
+                                         "", "aut", "xautomaton", "auto"},
+                              .d_wrd_lens = {10, 6, 3, 4, 0, 3, 10, 4}};
+  std::array<uint16_t, 8> result = levenshtein_myers_16x8_prefix(input, 2);
+  std::array<uint16_t, 8> expected = {0, 1, 3, 2, 3, 1, 1, 0};
+  EXPECT_EQ(result, expected);
+
+  EXPECT_EQ(levenshtein_myers_64x1_prefix("auto", 4, "automobile", 10, 2), 0u);
+  EXPECT_EQ(levenshtein_myers_32x1_prefix("auto", 4, "car", 3, 2), 3u);
+}
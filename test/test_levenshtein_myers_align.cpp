@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <levenshtein_myers.hpp>
+#include <cstring>
+
+// Replay the ops over q and check they produce d; returns the edit cost.
+static uint32_t apply_ops(const std::string &q, const std::string &d,
+                          const std::string &ops) {
+  size_t i = 0, j = 0;
+  uint32_t cost = 0;
+  for (char op : ops) {
+    switch (op) {
+    case '=':
+      EXPECT_EQ(q[i], d[j]);
+      i++, j++;
+      break;
+    case 'X':
+      EXPECT_NE(q[i], d[j]);
+      i++, j++, cost++;
+      break;
+    case 'I':
+      i++, cost++;
+      break;
+    case 'D':
+      j++, cost++;
+      break;
+    default:
+      ADD_FAILURE() << "bad op " << op;
+    }
+  }
+  EXPECT_EQ(i, q.size());
+  EXPECT_EQ(j, d.size());
+  return cost;
+}
+
+TEST(LevenshteinMyersAlignTest, Substitution) {
+  std::string ops;
+  EXPECT_EQ(levenshtein_myers_64x1_align("kitten", 6, "sitten", 6, ops), 1u);
+  EXPECT_EQ(ops, "X=====");
+  EXPECT_EQ(levenshtein_cigar(ops), "1X5=");
+}
+
+TEST(LevenshteinMyersAlignTest, InsertionAndDeletion) {
+  std::string ops;
+  EXPECT_EQ(levenshtein_myers_64x1_align("hello", 5, "helo", 4, ops), 1u);
+  EXPECT_EQ(apply_ops("hello", "helo", ops), 1u);
+  EXPECT_NE(ops.find('I'), std::string::npos);
+
+  EXPECT_EQ(levenshtein_myers_64x1_align("cat", 3, "cart", 4, ops), 1u);
+  EXPECT_EQ(ops, "==D=");
+}
+
+TEST(LevenshteinMyersAlignTest, EmptyStrings) {
+  std::string ops;
+  EXPECT_EQ(levenshtein_myers_64x1_align("", 0, "abc", 3, ops), 3u);
+  EXPECT_EQ(ops, "DDD");
+  EXPECT_EQ(levenshtein_myers_anyx1_align("abc", 3, "", 0, ops), 3u);
+  EXPECT_EQ(ops, "III");
+  EXPECT_EQ(levenshtein_myers_anyx1_align("", 0, "", 0, ops), 0u);
+  EXPECT_EQ(ops, "");
+}
+
+TEST(LevenshteinMyersAlignTest, LongStringsUseHirschberg) {
+  std::string q(300, 'a'), d(300, 'a');
+  for (int i = 0; i < 300; i += 7)
+    q[i] = 'b';
+  d.insert(150, "xyz");
+  d.erase(20, 5);
+
+  std::string ops;
+  uint32_t dist = levenshtein_myers_anyx1_align(q.c_str(), q.size(),
+                                                d.c_str(), d.size(), ops);
+  EXPECT_EQ(dist, levenshtein_myers_anyx1(q.c_str(), q.size(), d.c_str(),
+                                          d.size()));
+  EXPECT_EQ(apply_ops(q, d, ops), dist);
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <levenshtein_myers.hpp>
+#include <cstring>
+
+static std::vector<uint64_t> hit_positions(const std::vector<MyersSearchHit> &hits) {
+  std::vector<uint64_t> out;
+  for (const auto &h : hits)
+    out.push_back(h.end_pos);
+  return out;
+}
+
+TEST(LevenshteinMyersSearch64x1Test, ExactMatches) {
+  MyersSearch64x1State state;
+  levenshtein_myers_search_64x1_init(state, "error", 5, 0);
+
+  const char *text = "no error here, error again";
+  std::vector<MyersSearchHit> hits;
+  levenshtein_myers_search_64x1(state, text, std::strlen(text), hits);
+
+  EXPECT_THAT(hit_positions(hits), ::testing::ElementsAre(7, 19));
+  EXPECT_EQ(hits[0].distance, 0u);
+}
+
+TEST(LevenshteinMyersSearch64x1Test, ApproximateMatch) {
+  MyersSearch64x1State state;
+  levenshtein_myers_search_64x1_init(state, "timeout", 7, 1);
+
+  const char *text = "[warn] timout while reading";
+  std::vector<MyersSearchHit> hits;
+  levenshtein_myers_search_64x1(state, text, std::strlen(text), hits);
+
+  ASSERT_FALSE(hits.empty());
+  for (const auto &h : hits)
+    EXPECT_LE(h.distance, 1u);
+}
+
+TEST(LevenshteinMyersSearch64x1Test, ChunkedMatchesWhole) {
+  const char *pattern = "connection refused";
+  const char *text = "x: connection refused; y: connectoin refused; "
+                     "z: CONNECTION refused; w: connection refsed";
+  size_t text_len = std::strlen(text);
+
+  MyersSearch64x1State whole;
+  levenshtein_myers_search_64x1_init(whole, pattern, std::strlen(pattern), 2);
+  std::vector<MyersSearchHit> whole_hits;
+  levenshtein_myers_search_64x1(whole, text, text_len, whole_hits);
+
+  for (size_t chunk = 1; chunk < 9; chunk++) {
+    MyersSearch64x1State state;
+    levenshtein_myers_search_64x1_init(state, pattern, std::strlen(pattern), 2);
+    std::vector<MyersSearchHit> hits;
+    for (size_t off = 0; off < text_len; off += chunk)
+      levenshtein_myers_search_64x1(state, text + off,
+                                    std::min(chunk, text_len - off), hits);
+
+    ASSERT_EQ(hits.size(), whole_hits.size()) << "chunk=" << chunk;
+    for (size_t i = 0; i < hits.size(); i++) {
+      EXPECT_EQ(hits[i].end_pos, whole_hits[i].end_pos);
+      EXPECT_EQ(hits[i].distance, whole_hits[i].distance);
+    }
+  }
+}
+
+// After a reset, hits are those of a fresh search over the rest of the text,
+// shifted to its offset: "err" before the reset cannot complete "or" after it
+TEST(LevenshteinMyersSearch64x1Test, ResetMatchesFreshSearch) {
+  const char *text = "xxerr|or error";
+  MyersSearch32x1State s32;
+  MyersSearch64x1State s64;
+  levenshtein_myers_search_32x1_init(s32, "error", 5, 1);
+  levenshtein_myers_search_64x1_init(s64, "error", 5, 1);
+  std::vector<MyersSearchHit> hits32, hits64;
+  levenshtein_myers_search_32x1(s32, text, 5, hits32);
+  levenshtein_myers_search_64x1(s64, text, 5, hits64);
+  EXPECT_TRUE(hits32.empty());
+  levenshtein_myers_search_32x1_reset(s32, 5);
+  levenshtein_myers_search_64x1_reset(s64, 5);
+  levenshtein_myers_search_32x1(s32, text + 5, 9, hits32);
+  levenshtein_myers_search_64x1(s64, text + 5, 9, hits64);
+
+  MyersSearch64x1State fresh;
+  levenshtein_myers_search_64x1_init(fresh, "error", 5, 1);
+  std::vector<MyersSearchHit> want;
+  levenshtein_myers_search_64x1(fresh, text + 5, 9, want);
+  ASSERT_FALSE(want.empty());
+  for (auto &h : want)
+    h.end_pos += 5;
+  EXPECT_EQ(hit_positions(hits32), hit_positions(want));
+  EXPECT_EQ(hit_positions(hits64), hit_positions(want));
+}
+
+TEST(LevenshteinMyersSearch16x8Test, SeveralPatterns) {
+  Myers16x8SearchInput input{
+      .q_wrds = {"alpha", "beta", "gamma", "", "", "", "", ""},
+      .q_wrd_lens = {5, 4, 5, 0, 0, 0, 0, 0},
+      .max_dists = {0, 0, 0, 0, 0, 0, 0, 0}};
+  MyersSearch16x8State state;
+  levenshtein_myers_search_16x8_init(state, input);
+
+  const char *text = "gamma beta alpha";
+  std::vector<MyersSearchHit> hits;
+  levenshtein_myers_search_16x8(state, text, std::strlen(text), hits);
+
+  ASSERT_EQ(hits.size(), 3u);
+  EXPECT_EQ(hits[0].pattern, 2u);
+  EXPECT_EQ(hits[0].end_pos, 4u);
+  EXPECT_EQ(hits[1].pattern, 1u);
+  EXPECT_EQ(hits[1].end_pos, 9u);
+  EXPECT_EQ(hits[2].pattern, 0u);
+  EXPECT_EQ(hits[2].end_pos, 15u);
+}
+
+TEST(LevenshteinMyersSearch8x16Test, UnusedLanesNeverHit) {
+  Myers8x16SearchInput input{};
+  input.q_wrds[3] = "abc";
+  input.q_wrd_lens[3] = 3;
+  input.max_dists[3] = 1;
+  MyersSearch8x16State state;
+  levenshtein_myers_search_8x16_init(state, input);
+
+  const char *text = "xxabxxabcxx";
+  std::vector<MyersSearchHit> hits;
+  levenshtein_myers_search_8x16(state, text, std::strlen(text), hits);
+
+  ASSERT_FALSE(hits.empty());
+  for (const auto &h : hits)
+    EXPECT_EQ(h.pattern, 3u);
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <levenshtein_patterns.hpp>
+#include <algorithm>
+#include <random>
+#include <string>
+#include "levenshtein_test_util.hpp"
+
+TEST(LevenshteinPatternsTest, RejectsInvalidPatterns) {
+  MyersPatternSet set;
+  std::string error;
+  EXPECT_FALSE(levenshtein_patterns_build({"ok", std::string(65, 'a')}, set,
+                                          &error));
+  EXPECT_FALSE(levenshtein_patterns_build({"Not ok"}, set, &error));
+  EXPECT_FALSE(error.empty());
+}
+
+TEST(LevenshteinPatternsTest, GroupsByLaneWidth) {
+  MyersPatternSet set;
+  std::vector<std::string> patterns = {std::string(40, 'a'), "abc",
+                                       std::string(12, 'b'), "",
+                                       std::string(20, 'c')};
+  ASSERT_TRUE(levenshtein_patterns_build(patterns, set, nullptr));
+  ASSERT_EQ(set.groups.size(), 4u);
+  EXPECT_EQ(set.groups[0].width, 8);
+  EXPECT_EQ(set.groups[0].n_lanes, 2);
+  EXPECT_EQ(set.groups[1].width, 16);
+  EXPECT_EQ(set.groups[2].width, 32);
+  EXPECT_EQ(set.groups[3].width, 64);
+  EXPECT_EQ(set.ids, (std::vector<uint32_t>{3, 1, 2, 4, 0}));
+}
+
+// Texts longer than the 8-bit lane range, and bytes outside a-z, still
+// give exact distances
+TEST(LevenshteinPatternsTest, ScanMatchesPairwise) {
+  std::mt19937 rng(11);
+  std::vector<std::string> patterns;
+  for (int i = 0; i < 300; i++)
+    patterns.push_back(random_string(rng, i % 2 ? 64 : 12, 'f'));
+
+  MyersPatternSet set;
+  ASSERT_TRUE(levenshtein_patterns_build(patterns, set, nullptr));
+  EXPECT_GT(levenshtein_patterns_memory(set), 0u);
+
+  std::vector<uint32_t> distances(patterns.size());
+  for (int ti = 0; ti < 60; ti++) {
+    std::string text = random_string(rng, ti % 3 ? 40 : 700, 'f');
+    if (ti % 4 == 0 && !text.empty())
+      text[rng() % text.size()] = ' ';
+    levenshtein_patterns_scan(set, text.c_str(), text.size(),
+                              distances.data());
+    for (size_t i = 0; i < patterns.size(); i++)
+      ASSERT_EQ(distances[i], levenshtein_reference(patterns[i], text))
+          << "p=" << patterns[i] << " t=" << text;
+  }
+}
+
+TEST(LevenshteinPatternsTest, ScanWithinMatchesPairwise) {
+  std::mt19937 rng(12);
+  std::vector<std::string> patterns;
+  for (int i = 0; i < 500; i++)
+    patterns.push_back(random_string(rng, 24, 'd'));
+
+  MyersPatternSet set;
+  ASSERT_TRUE(levenshtein_patterns_build(patterns, set, nullptr));
+
+  for (int ti = 0; ti < 40; ti++) {
+    std::string text = patterns[rng() % patterns.size()];
+    if (!text.empty())
+      text[rng() % text.size()] = 'a' + rng() % 4;
+    for (uint32_t k = 0; k <= 3; k++) {
+      std::vector<MyersScanMatch> matches;
+      MyersPatternStats stats = {};
+      levenshtein_patterns_scan_within(set, text.c_str(), text.size(), k,
+                                       matches, &stats);
+
+      std::vector<std::pair<uint32_t, uint32_t>> got, want;
+      for (const auto &m : matches)
+        got.push_back({m.id, m.distance});
+      for (uint32_t i = 0; i < patterns.size(); i++) {
+        uint32_t d = levenshtein_reference(patterns[i], text);
+        if (d <= k)
+          want.push_back({i, d});
+      }
+      std::sort(got.begin(), got.end());
+      EXPECT_EQ(got, want) << "t=" << text << " k=" << k;
+      EXPECT_EQ(stats.groups_run + stats.groups_skipped, set.groups.size());
+      EXPECT_GT(stats.groups_skipped, 0u);
+      EXPECT_EQ(stats.matches, want.size());
+    }
+  }
+}
+
+TEST(LevenshteinPatternsTest, ScanDictionaryMatchesPairwise) {
+  std::mt19937 rng(13);
+  std::vector<std::string> words, patterns;
+  for (int i = 0; i < 2000; i++)
+    words.push_back(random_string(rng, 20, 'd'));
+  for (int i = 0; i < 40; i++)
+    patterns.push_back(random_string(rng, i % 2 ? 64 : 10, 'd'));
+  std::string path = ::testing::TempDir() + "patterns_scan.dict";
+  ASSERT_TRUE(levenshtein_dictionary_build(words, path.c_str(), nullptr));
+  MyersDictionary dict;
+  ASSERT_TRUE(levenshtein_dictionary_open(dict, path.c_str(), nullptr));
+
+  MyersPatternSet set;
+  ASSERT_TRUE(levenshtein_patterns_build(patterns, set, nullptr));
+  for (uint32_t k : {0u, 2u, 5u}) {
+    std::vector<MyersPatternDictMatch> matches;
+    MyersPatternStats stats = {};
+    levenshtein_patterns_scan_dictionary(set, dict, k, matches, &stats);
+
+    std::vector<std::array<uint32_t, 3>> got, want;
+    for (const auto &m : matches)
+      got.push_back({m.pattern, m.id, m.distance});
+    for (uint32_t p = 0; p < patterns.size(); p++) {
+      for (uint32_t w = 0; w < words.size(); w++) {
+        uint32_t d = levenshtein_reference(patterns[p], words[w]);
+        if (d <= k)
+          want.push_back({p, w, d});
+      }
+    }
+    std::sort(got.begin(), got.end());
+    EXPECT_EQ(got, want) << "k=" << k;
+    EXPECT_EQ(stats.groups_run + stats.groups_skipped,
+              set.groups.size() * words.size());
+    EXPECT_EQ(stats.matches, want.size());
+  }
+  levenshtein_dictionary_close(dict);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <levenshtein_qgram.hpp>
+#include <algorithm>
+#include <random>
+#include <string>
+#include "levenshtein_test_util.hpp"
+
+TEST(LevenshteinQgramTest, RejectsInvalidInput) {
+  MyersQgramIndex index;
+  std::string error;
+  EXPECT_FALSE(levenshtein_qgram_build({"ok"}, 1, index, &error));
+  EXPECT_FALSE(levenshtein_qgram_build({"ok", "Not ok"}, 3, index, &error));
+  EXPECT_FALSE(error.empty());
+}
+
+TEST(LevenshteinQgramTest, SearchMatchesLinearScan) {
+  std::mt19937 rng(5);
+  auto strs = random_strings(rng, 3000, 0, 70);
+  // Near-duplicates so that every threshold has matches
+  for (int i = 0; i < 300; i++) {
+    std::string s = strs[i];
+    for (int e = 0; e < 3 && !s.empty(); e++)
+      s[rng() % s.size()] = 'a' + rng() % 26;
+    strs.push_back(s + "q");
+  }
+
+  MyersQgramIndex indexes[MYERS_QGRAM_MAX_Q + 1];
+  for (int q = MYERS_QGRAM_MIN_Q; q <= MYERS_QGRAM_MAX_Q; q++)
+    ASSERT_TRUE(levenshtein_qgram_build(strs, q, indexes[q], nullptr));
+
+  for (int qi = 0; qi < 40; qi++) {
+    const std::string &query = strs[qi * 7];
+    std::vector<uint32_t> ref(strs.size());
+    for (uint32_t i = 0; i < strs.size(); i++)
+      ref[i] = levenshtein_myers_anyx1(query.c_str(), query.size(),
+                                       strs[i].c_str(), strs[i].size());
+
+    for (int q = MYERS_QGRAM_MIN_Q; q <= MYERS_QGRAM_MAX_Q; q++) {
+      for (uint32_t k = 0; k <= 5; k++) {
+        std::vector<MyersScanMatch> matches;
+        MyersQgramStats stats = {};
+        levenshtein_qgram_search(indexes[q], query.c_str(), query.size(), k,
+                                 matches, &stats);
+
+        std::vector<std::pair<uint32_t, uint32_t>> got, want;
+        for (const auto &m : matches)
+          got.push_back({m.id, m.distance});
+        for (uint32_t i = 0; i < strs.size(); i++) {
+          if (ref[i] <= k)
+            want.push_back({i, ref[i]});
+        }
+        std::sort(got.begin(), got.end());
+        ASSERT_EQ(got, want) << "query=" << query << " q=" << q << " k=" << k;
+        EXPECT_EQ(stats.matches, want.size());
+      }
+    }
+  }
+}
+
+TEST(LevenshteinQgramTest, CountFilterPrunes) {
+  std::mt19937 rng(6);
+  auto strs = random_strings(rng, 5000, 30, 40);
+  MyersQgramIndex index;
+  ASSERT_TRUE(levenshtein_qgram_build(strs, 3, index, nullptr));
+
+  MyersQgramStats stats = {};
+  std::vector<MyersScanMatch> matches;
+  levenshtein_qgram_search(index, strs[0].c_str(), strs[0].size(), 2, matches,
+                           &stats);
+  ASSERT_FALSE(matches.empty());
+  EXPECT_EQ(matches[0].id, 0u);
+  EXPECT_LT(stats.verified, 50u);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <levenshtein_ratio.hpp>
+#include <cmath>
+#include <random>
+#include <string>
+#include "levenshtein_test_util.hpp"
+
+static double ref_ratio(const std::string &a, const std::string &b,
+                        double cutoff) {
+  size_t len = std::max(a.size(), b.size());
+  double s = len == 0 ? 1.0 : 1.0 - double(levenshtein_reference(a, b)) / len;
+  return s >= cutoff - 1e-12 ? s : 0;
+}
+
+static double ref_partial_ratio(const std::string &a, const std::string &b,
+                                double cutoff) {
+  const std::string &p = a.size() <= b.size() ? a : b;
+  const std::string &t = a.size() <= b.size() ? b : a;
+  if (p.empty())
+    return t.empty() ? 1.0 : 0;
+  double s = 1.0 - double(substring_reference(p, t)) / p.size();
+  return s >= cutoff - 1e-12 ? s : 0;
+}
+
+TEST(LevenshteinRatioTest, MaxDist) {
+  EXPECT_EQ(levenshtein_ratio_max_dist(10, 0.8), 2u);
+  EXPECT_EQ(levenshtein_ratio_max_dist(10, 0.81), 1u);
+  EXPECT_EQ(levenshtein_ratio_max_dist(10, 0), 10u);
+  EXPECT_EQ(levenshtein_ratio_max_dist(10, 1), 0u);
+  EXPECT_EQ(levenshtein_ratio_max_dist(7, 2), 0u);
+  EXPECT_DOUBLE_EQ(levenshtein_ratio("kitten", 6, "sitting", 7), 1 - 3.0 / 7);
+  EXPECT_DOUBLE_EQ(levenshtein_ratio("", 0, "", 0), 1.0);
+  EXPECT_DOUBLE_EQ(levenshtein_partial_ratio("world", 5, "hello wrld!", 11),
+                   0.8);
+  EXPECT_DOUBLE_EQ(levenshtein_partial_ratio("", 0, "abc", 3), 0);
+}
+
+TEST(LevenshteinRatioTest, SinglePairMatchesReference) {
+  std::mt19937 rng(45);
+  static const double cutoffs[] = {0, 0.3, 0.6, 0.8, 0.95, 1.0};
+  for (int iter = 0; iter < 3000; iter++) {
+    int max_len = iter % 10 == 0 ? 200 : 40;
+    auto a = random_string(rng, max_len, 'e');
+    auto b = random_string(rng, iter % 3 == 0 ? 3 * max_len : max_len, 'e');
+    double cutoff = cutoffs[iter % 6];
+    ASSERT_NEAR(levenshtein_ratio(a.data(), a.size(), b.data(), b.size(),
+                                  cutoff),
+                ref_ratio(a, b, cutoff), 1e-12)
+        << "a=" << a << " b=" << b << " cutoff=" << cutoff;
+    ASSERT_NEAR(levenshtein_partial_ratio(a.data(), a.size(), b.data(),
+                                          b.size(), cutoff),
+                ref_partial_ratio(a, b, cutoff), 1e-12)
+        << "a=" << a << " b=" << b << " cutoff=" << cutoff;
+  }
+}
+
+// Texts spanning many search blocks, with a near copy of the pattern
+// planted at a random spot, including across a block boundary
+TEST(LevenshteinRatioTest, PartialRatioOnLongTexts) {
+  std::mt19937 rng(47);
+  for (int iter = 0; iter < 200; iter++) {
+    auto p = random_string(rng, 1, 64, letters('e'));
+    auto t = random_string(rng, 2000, 'e');
+    std::string near = p;
+    for (int e = 0; e < iter % 4 && !near.empty(); e++)
+      near[rng() % near.size()] = 'a' + rng() % 5;
+    t.insert(rng() % (t.size() + 1), near);
+    double cutoff = (iter % 5) / 5.0;
+    ASSERT_NEAR(levenshtein_partial_ratio(p.data(), p.size(), t.data(),
+                                          t.size(), cutoff),
+                ref_partial_ratio(p, t, cutoff), 1e-12)
+        << "p=" << p << " cutoff=" << cutoff;
+  }
+}
+
+TEST(LevenshteinRatioTest, BatchMatchesSinglePair) {
+  std::mt19937 rng(46);
+  for (int iter = 0; iter < 300; iter++) {
+    static const int q_lens[] = {8, 16, 32, 64, 150};
+    auto q = random_string(rng, q_lens[iter % 5], 'd');
+    double cutoff = (iter % 7) / 7.0;
+    size_t n = rng() % 40;
+    std::vector<std::string> words(n);
+    std::vector<const char *> wrds(n);
+    std::vector<int> lens(n);
+    for (size_t i = 0; i < n; i++) {
+      words[i] = random_string(rng, q_lens[iter % 5] + 10, 'd');
+      wrds[i] = words[i].data();
+      lens[i] = words[i].size();
+    }
+
+    std::vector<float> scores(n), partial(n);
+    std::vector<uint8_t> fixed(n);
+    levenshtein_ratio(q.data(), q.size(), wrds.data(), lens.data(), n, cutoff,
+                      scores.data());
+    levenshtein_ratio_u8(q.data(), q.size(), wrds.data(), lens.data(), n,
+                         cutoff, fixed.data());
+    levenshtein_partial_ratio(q.data(), q.size(), wrds.data(), lens.data(), n,
+                              cutoff, partial.data());
+    for (size_t i = 0; i < n; i++) {
+      double r = levenshtein_ratio(q.data(), q.size(), wrds[i], lens[i],
+                                   cutoff);
+      ASSERT_EQ(scores[i], float(r)) << "q=" << q << " d=" << words[i];
+      ASSERT_EQ(fixed[i], std::lround(r * 255)) << "q=" << q;
+      ASSERT_EQ(partial[i], float(levenshtein_partial_ratio(
+                                q.data(), q.size(), wrds[i], lens[i], cutoff)));
+    }
+  }
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <levenshtein_dictionary.hpp>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <fcntl.h>
+#include <random>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include "levenshtein_test_util.hpp"
+
+// Runs the levenshtein_server binary (LEVENSHTEIN_SERVER_PATH, set by the
+// build) on a Unix socket and checks its replies against the DP reference.
+
+static const char *ERROR_REPLY = "error expected \"<max_dist> <a-z query>\"\n";
+
+static std::string temp_path(const char *name) {
+  return ::testing::TempDir() + name;
+}
+
+static int connect_unix(const std::string &path) {
+  sockaddr_un addr = {};
+  addr.sun_family = AF_UNIX;
+  std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path.c_str());
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd >= 0 && connect(fd, (sockaddr *)&addr, sizeof(addr)) == 0)
+    return fd;
+  if (fd >= 0)
+    close(fd);
+  return -1;
+}
+
+// A server over `words`, stopped with SIGTERM when the test ends. A long
+// batching window makes requests written together land in one batch.
+class LevenshteinServerTest : public ::testing::Test {
+protected:
+  std::vector<std::string> words;
+  std::string dict_path, sock_path;
+  pid_t pid = -1;
+
+  void SetUp() override {
+    std::mt19937 rng(48);
+    words = random_strings(rng, 300, 1, 12, 'e');
+    dict_path = temp_path("server_words.dict");
+    sock_path = temp_path("server.sock");
+    ASSERT_TRUE(
+        levenshtein_dictionary_build(words, dict_path.c_str(), nullptr));
+
+    pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      int null = open("/dev/null", O_WRONLY);
+      dup2(null, STDERR_FILENO);
+      execl(LEVENSHTEIN_SERVER_PATH, LEVENSHTEIN_SERVER_PATH,
+            dict_path.c_str(), "--unix", sock_path.c_str(), "--window-us",
+            "50000", (char *)nullptr);
+      _exit(127);
+    }
+    // Wait for the socket to accept connections
+    for (int i = 0; i < 500; i++) {
+      int fd = connect_unix(sock_path);
+      if (fd >= 0) {
+        close(fd);
+        return;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    FAIL() << "server did not start";
+  }
+
+  void TearDown() override {
+    if (pid > 0) {
+      kill(pid, SIGTERM);
+      int status;
+      waitpid(pid, &status, 0);
+      EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+    std::remove(dict_path.c_str());
+    std::remove(sock_path.c_str());
+  }
+
+  // Send `requests` in one write, half-close, and read until the server
+  // closes the connection
+  std::string exchange(const std::string &requests) {
+    int fd = connect_unix(sock_path);
+    EXPECT_GE(fd, 0);
+    for (size_t off = 0; off < requests.size();) {
+      ssize_t n = write(fd, requests.data() + off, requests.size() - off);
+      if (n <= 0)
+        break;
+      off += n;
+    }
+    shutdown(fd, SHUT_WR);
+    std::string out;
+    char buf[4096];
+    for (ssize_t n; (n = read(fd, buf, sizeof(buf))) > 0;)
+      out.append(buf, n);
+    close(fd);
+    return out;
+  }
+
+  // The reply to "<max_dist> <query>": every word within the bound,
+  // nearest first
+  std::string expected(const std::string &query, uint64_t max_dist) {
+    std::vector<std::pair<uint32_t, uint32_t>> hits; // (distance, id)
+    for (uint32_t id = 0; id < words.size(); id++) {
+      uint32_t d = levenshtein_reference(query, words[id]);
+      if (d <= max_dist)
+        hits.push_back({d, id});
+    }
+    std::sort(hits.begin(), hits.end());
+    std::string out = std::to_string(hits.size());
+    for (const auto &[d, id] : hits)
+      out += " " + std::to_string(id) + ":" + std::to_string(d);
+    return out + "\n";
+  }
+};
+
+// Pipelined requests, then a half-close: every reply still arrives, in
+// order, including the one for a last line without a newline
+TEST_F(LevenshteinServerTest, AnswersPipelinedRequestsAfterHalfClose) {
+  std::string got = exchange("1 abc\n0 " + words[5] + "\n2 ab");
+  EXPECT_EQ(got, expected("abc", 1) + expected(words[5], 0) +
+                     expected("ab", 2));
+}
+
+// One batch with several bounds, including one past every possible
+// distance and a query too long for the pattern kernels
+TEST_F(LevenshteinServerTest, MixedBoundsMatchReference) {
+  std::mt19937 rng(49);
+  static const uint32_t bounds[] = {0, 1, 2, 3, 1000};
+  std::string requests, want;
+  for (int i = 0; i < 60; i++) {
+    std::string q = random_string(rng, 1, i == 7 ? 80 : 12, letters('e'));
+    uint32_t bound = bounds[i % 5];
+    requests += std::to_string(bound) + " " + q + "\n";
+    want += expected(q, bound);
+  }
+  EXPECT_EQ(exchange(requests), want);
+}
+
+// Malformed lines and bounds past UINT32_MAX get the error reply in their
+// place; UINT32_MAX itself is a valid, clamped bound
+TEST_F(LevenshteinServerTest, ErrorsKeepRequestOrder) {
+  std::string got = exchange("1 abc\n"
+                             "not a request\n"
+                             "99999999999 a\n"
+                             "4294967296 a\n"
+                             "-1 a\n"
+                             "2 ABC\n"
+                             "4294967295 a\n"
+                             "1 abd\n");
+  EXPECT_EQ(got, expected("abc", 1) + ERROR_REPLY + ERROR_REPLY +
+                     ERROR_REPLY + ERROR_REPLY + ERROR_REPLY +
+                     expected("a", UINT32_MAX) + expected("abd", 1));
+}
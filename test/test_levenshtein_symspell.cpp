@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <levenshtein_symspell.hpp>
+#include <algorithm>
+#include <random>
+#include <string>
+#include "levenshtein_test_util.hpp"
+
+TEST(LevenshteinSymSpellTest, RejectsInvalidInput) {
+  MyersSymSpellIndex index;
+  std::string error;
+  EXPECT_FALSE(levenshtein_symspell_build({"ok"}, 4, index, &error));
+  EXPECT_FALSE(levenshtein_symspell_build({"abcdefghijklmnopq"}, 2, index,
+                                          &error));
+  EXPECT_FALSE(levenshtein_symspell_build({"Not ok"}, 2, index, &error));
+  EXPECT_FALSE(error.empty());
+}
+
+TEST(LevenshteinSymSpellTest, SpellingSuggestions) {
+  MyersSymSpellIndex index;
+  ASSERT_TRUE(levenshtein_symspell_build(
+      {"receive", "believe", "recipe", "deceive", "relieve"}, 2, index,
+      nullptr));
+
+  std::vector<MyersScanMatch> matches;
+  levenshtein_symspell_lookup(index, "recieve", 7, 2, matches, nullptr);
+  std::vector<std::pair<uint32_t, uint32_t>> got;
+  for (const auto &m : matches)
+    got.push_back({m.id, m.distance});
+  std::sort(got.begin(), got.end());
+  // "deceive" needs three edits
+  std::vector<std::pair<uint32_t, uint32_t>> want = {
+      {0, 2}, {1, 2}, {2, 2}, {4, 1}};
+  EXPECT_EQ(got, want);
+
+  matches.clear();
+  levenshtein_symspell_lookup(index, "recieve", 7, 1, matches, nullptr);
+  ASSERT_EQ(matches.size(), 1u);
+  EXPECT_EQ(matches[0].id, 4u);
+}
+
+TEST(LevenshteinSymSpellTest, LookupMatchesLinearScan) {
+  std::mt19937 rng(21);
+  auto words = random_strings(rng, 3000, 0, 16, 'f');
+  auto queries = random_strings(rng, 200, 0, 18, 'f');
+
+  for (uint32_t build_k = 1; build_k <= 3; build_k++) {
+    MyersSymSpellIndex index;
+    ASSERT_TRUE(levenshtein_symspell_build(words, build_k, index, nullptr));
+
+    for (const auto &q : queries) {
+      for (uint32_t k = 0; k <= build_k; k++) {
+        std::vector<MyersScanMatch> matches;
+        MyersSymSpellStats stats = {};
+        levenshtein_symspell_lookup(index, q.c_str(), q.size(), k, matches,
+                                    &stats);
+
+        std::vector<std::pair<uint32_t, uint32_t>> got, want;
+        for (const auto &m : matches)
+          got.push_back({m.id, m.distance});
+        for (uint32_t i = 0; i < words.size(); i++) {
+          uint32_t d = levenshtein_myers_anyx1(q.c_str(), q.size(),
+                                               words[i].c_str(),
+                                               words[i].size());
+          if (d <= k)
+            want.push_back({i, d});
+        }
+        std::sort(got.begin(), got.end());
+        ASSERT_EQ(got, want) << "q=" << q << " k=" << k;
+        EXPECT_EQ(stats.matches, want.size());
+      }
+    }
+  }
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <levenshtein_trim.hpp>
+#include <random>
+#include <string>
+#include "levenshtein_test_util.hpp"
+
+TEST(LevenshteinTrimTest, CommonAffixes) {
+  std::mt19937 rng(3);
+  for (int iter = 0; iter < 20000; iter++) {
+    std::string core = random_string(rng, 70, 'c');
+    std::string a = core + random_string(rng, 20, 'c');
+    std::string b = core + random_string(rng, 20, 'c');
+    if (iter % 2) {
+      a = random_string(rng, 20, 'c') + core;
+      b = random_string(rng, 20, 'c') + core;
+    }
+
+    size_t prefix = 0;
+    while (prefix < std::min(a.size(), b.size()) && a[prefix] == b[prefix])
+      prefix++;
+    size_t suffix = 0;
+    while (suffix < std::min(a.size(), b.size()) &&
+           a[a.size() - 1 - suffix] == b[b.size() - 1 - suffix])
+      suffix++;
+
+    EXPECT_EQ(levenshtein_common_prefix(a.data(), a.size(), b.data(),
+                                        b.size()),
+              prefix);
+    EXPECT_EQ(levenshtein_common_suffix(a.data(), a.size(), b.data(),
+                                        b.size()),
+              suffix);
+  }
+}
+
+TEST(LevenshteinTrimTest, SinglePairMatchesAnyx1) {
+  std::mt19937 rng(4);
+  MyersTrimStats stats = {};
+  for (int iter = 0; iter < 3000; iter++) {
+    std::string head = random_string(rng, 150);
+    std::string tail = random_string(rng, 150);
+    std::string q = head + random_string(rng, 40, 'd') + tail;
+    std::string d = head + random_string(rng, 40, 'd') + tail;
+
+    uint32_t ref = levenshtein_myers_anyx1(q.c_str(), q.size(), d.c_str(),
+                                           d.size());
+    EXPECT_EQ(levenshtein_myers_trimmed(q.c_str(), q.size(), d.c_str(),
+                                        d.size(), &stats),
+              ref)
+        << "q=" << q << " d=" << d;
+
+    uint32_t k = rng() % 16;
+    EXPECT_EQ(levenshtein_myers_bounded_trimmed(q.c_str(), q.size(), d.c_str(),
+                                                d.size(), k, &stats),
+              std::min(ref, k + 1))
+        << "q=" << q << " d=" << d << " k=" << k;
+  }
+  EXPECT_EQ(stats.pairs, 6000u);
+  EXPECT_GT(stats.trimmed, 0u);
+  EXPECT_GT(stats.bytes_trimmed, stats.trimmed);
+  EXPECT_GT(stats.downgraded, 0u);
+  EXPECT_LE(stats.downgraded, stats.trimmed);
+}
+
+TEST(LevenshteinTrimTest, DowngradesLongPair) {
+  std::string q(300, 'a'), d(300, 'a');
+  q[150] = 'b';
+  d[151] = 'c';
+  MyersTrimStats stats = {};
+  EXPECT_EQ(levenshtein_myers_trimmed(q.c_str(), q.size(), d.c_str(),
+                                      d.size(), &stats),
+            2u);
+  EXPECT_EQ(stats.downgraded, 1u);
+  EXPECT_EQ(stats.bytes_trimmed, 298u);
+}
+
+TEST(LevenshteinTrimTest, BatchMatchesPlainKernels) {
+  std::mt19937 rng(5);
+  MyersTrimStats stats = {};
+  for (int iter = 0; iter < 5000; iter++) {
+    std::string head = random_string(rng, 5, 'b');
+    std::string tail = random_string(rng, 5, 'b');
+    std::string q = head + random_string(rng, 6, 'd') + tail;
+
+    // Lanes share the affix, padded so the kernels may read past them
+    std::string d[8];
+    Myers16x8Input input{q.c_str(), (int)q.size()};
+    for (int k = 0; k < 8; k++) {
+      d[k] = (iter % 3 ? head : "") + random_string(rng, 6, 'd') + tail;
+      input.d_wrd_lens[k] = d[k].size();
+      d[k].append(16, 'a');
+      input.d_wrds[k] = d[k].c_str();
+    }
+
+    auto plain = levenshtein_myers_16x8(input);
+    auto trimmed = levenshtein_myers_16x8_trimmed(input, &stats);
+    EXPECT_EQ(plain, trimmed) << "q=" << q;
+  }
+  EXPECT_EQ(stats.pairs, 5000u * 8);
+  EXPECT_GT(stats.trimmed, 0u);
+}
+
+// A remainder between 65 and 128 characters must not reach the 128x1 stub
+TEST(LevenshteinTrimTest, MiddleLongerThan64) {
+  std::string q = "xx" + std::string(100, 'a') + "yy";
+  std::string d = "xx" + std::string(100, 'b') + "yy";
+  EXPECT_EQ(levenshtein_myers_trimmed(q.c_str(), q.size(), d.c_str(),
+                                      d.size(), nullptr),
+            100u);
+}
@@ -0,0 +1,150 @@
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <levenshtein_tune.hpp>
+#include <random>
+#include <string>
+#include <thread>
+#include "levenshtein_test_util.hpp"
+
+static std::string temp_path(const char *name) {
+  return testing::TempDir() + name;
+}
+
+static void expect_same_plan(const MyersPlan &a, const MyersPlan &b) {
+  for (int c = 0; c < MYERS_PLAN_CLASSES; c++) {
+    EXPECT_EQ(a.classes[c].single, b.classes[c].single) << "class " << c;
+    EXPECT_EQ(a.classes[c].batch, b.classes[c].batch) << "class " << c;
+    EXPECT_EQ(a.classes[c].min_batch, b.classes[c].min_batch) << "class " << c;
+  }
+}
+
+TEST(LevenshteinTuneTest, TunedPlanIsValid) {
+  MyersPlan plan;
+  levenshtein_tune(plan, 200);
+  EXPECT_TRUE(levenshtein_plan_valid(plan));
+  EXPECT_EQ(plan.classes[MYERS_PLAN_CLASSES - 1].single, MYERS_KERNEL_ANYX1);
+  EXPECT_FALSE(levenshtein_cpu_id().empty());
+}
+
+TEST(LevenshteinTuneTest, SaveLoadRoundTrip) {
+  auto path = temp_path("plan_round_trip");
+  MyersPlan plan = levenshtein_plan_default();
+  plan.classes[0] = {MYERS_KERNEL_64X1, MYERS_KERNEL_64X2, 1};
+  plan.classes[2].min_batch = 3;
+
+  std::string error;
+  ASSERT_TRUE(levenshtein_plan_save(plan, path.c_str(), &error)) << error;
+  MyersPlan loaded;
+  ASSERT_TRUE(levenshtein_plan_load(loaded, path.c_str(), &error)) << error;
+  expect_same_plan(plan, loaded);
+  std::remove(path.c_str());
+}
+
+// Writers racing on one path each use their own temporary, so a reader only
+// ever sees a complete plan
+TEST(LevenshteinTuneTest, ConcurrentSavesNeverTearThePlan) {
+  auto path = temp_path("plan_concurrent");
+  MyersPlan plan = levenshtein_plan_default();
+  ASSERT_TRUE(levenshtein_plan_save(plan, path.c_str(), nullptr));
+
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 4; t++) {
+    writers.emplace_back([&] {
+      for (int i = 0; i < 50; i++)
+        EXPECT_TRUE(levenshtein_plan_save(plan, path.c_str(), nullptr));
+    });
+  }
+  for (int i = 0; i < 200; i++) {
+    MyersPlan loaded;
+    std::string error;
+    ASSERT_TRUE(levenshtein_plan_load(loaded, path.c_str(), &error)) << error;
+  }
+  for (auto &w : writers)
+    w.join();
+  std::remove(path.c_str());
+}
+
+TEST(LevenshteinTuneTest, LoadRejectsOtherCpuAndGarbage) {
+  auto path = temp_path("plan_rejects");
+  std::string error;
+  MyersPlan plan;
+
+  {
+    std::ofstream out(path);
+    out << "levenshtein-plan 1\ncpu some other core\n";
+    for (int c = 0; c < MYERS_PLAN_CLASSES; c++)
+      out << c << " anyx1 anyx1 0\n";
+  }
+  EXPECT_FALSE(levenshtein_plan_load(plan, path.c_str(), &error));
+  EXPECT_EQ(error, "plan was tuned on a different cpu");
+
+  {
+    std::ofstream out(path);
+    out << "levenshtein-plan 1\ncpu " << levenshtein_cpu_id() << "\n";
+    out << "0 32x1 16x8\n";
+  }
+  EXPECT_FALSE(levenshtein_plan_load(plan, path.c_str(), &error));
+  EXPECT_EQ(error, "malformed plan entry");
+
+  // Parses, but 32x1 cannot take the open-ended class
+  {
+    std::ofstream out(path);
+    out << "levenshtein-plan 1\ncpu " << levenshtein_cpu_id() << "\n";
+    for (int c = 0; c < MYERS_PLAN_CLASSES; c++)
+      out << c << " 32x1 32x1 0\n";
+  }
+  EXPECT_FALSE(levenshtein_plan_load(plan, path.c_str(), &error));
+
+  std::remove(path.c_str());
+  EXPECT_FALSE(levenshtein_plan_load(plan, path.c_str(), &error));
+}
+
+// A cached plan is used as is, and the dispatcher stays exact under it
+TEST(LevenshteinTuneTest, InitUsesCachedPlan) {
+  auto path = temp_path("plan_init");
+  MyersPlan plan = levenshtein_plan_default();
+  for (int c = 0; c < 4; c++)
+    plan.classes[c] = {MYERS_KERNEL_64X1, MYERS_KERNEL_64X2, 1};
+  ASSERT_TRUE(levenshtein_plan_save(plan, path.c_str(), nullptr));
+
+  std::string error;
+  ASSERT_TRUE(levenshtein_plan_init(path.c_str(), &error)) << error;
+  expect_same_plan(levenshtein_plan_current(), plan);
+
+  std::mt19937 rng(41);
+  for (int iter = 0; iter < 200; iter++) {
+    auto q = random_string(rng, 70, 'e');
+    std::vector<std::string> words(1 + rng() % 20);
+    std::vector<const char *> wrds;
+    std::vector<int> lens;
+    for (auto &w : words) {
+      w = random_string(rng, 70, 'e');
+      wrds.push_back(w.data());
+      lens.push_back(w.size());
+    }
+    std::vector<uint32_t> distances(words.size());
+    levenshtein_distance(q.c_str(), q.size(), wrds.data(), lens.data(),
+                         words.size(), distances.data());
+    for (size_t i = 0; i < words.size(); i++)
+      ASSERT_EQ(distances[i], levenshtein_myers_anyx1(q.c_str(), q.size(),
+                                                      wrds[i], lens[i]))
+          << "q=" << q << " d=" << words[i];
+  }
+
+  EXPECT_TRUE(levenshtein_plan_set(levenshtein_plan_default()));
+  std::remove(path.c_str());
+}
+
+TEST(LevenshteinTuneTest, InitTunesAndCachesWithoutFile) {
+  auto path = temp_path("plan_init_tune");
+  std::remove(path.c_str());
+  std::string error;
+  ASSERT_TRUE(levenshtein_plan_init(path.c_str(), &error)) << error;
+  MyersPlan loaded;
+  ASSERT_TRUE(levenshtein_plan_load(loaded, path.c_str(), &error)) << error;
+  expect_same_plan(levenshtein_plan_current(), loaded);
+
+  EXPECT_TRUE(levenshtein_plan_set(levenshtein_plan_default()));
+  std::remove(path.c_str());
+}
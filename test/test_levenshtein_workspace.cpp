@@ -0,0 +1,25 @@
+#include <gtest/gtest.h>
+#include <levenshtein_myers.hpp>
+#include <random>
+#include <string>
+#include "levenshtein_test_util.hpp"
+
+// A workspace grown by a long query still gives exact results for short
+// ones, and reserving less than it holds is a no-op
+TEST(LevenshteinWorkspaceTest, ReuseAcrossLengths) {
+  std::mt19937 rng(44);
+  MyersWorkspace ws;
+  for (int iter = 0; iter < 500; iter++) {
+    auto a = random_bytes(rng, iter % 3 == 0 ? 400 : 70);
+    auto b = random_bytes(rng, iter % 3 == 0 ? 400 : 70);
+    ASSERT_EQ(levenshtein_myers_anyx1(a.data(), a.size(), b.data(), b.size(),
+                                      ws),
+              levenshtein_reference(a, b))
+        << "iter " << iter;
+  }
+  size_t words = ws.words;
+  levenshtein_workspace_reserve(ws, 64);
+  EXPECT_EQ(ws.words, words);
+  for (uint64_t v : ws.peq)
+    ASSERT_EQ(v, 0u);
+}
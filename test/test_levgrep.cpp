@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <sys/wait.h>
+#include "levenshtein_test_util.hpp"
+
+// Runs the levgrep binary (LEVGREP_PATH, set by the build) on files written
+// here, and checks its output against the DP references.
+
+static std::string temp_path(const char *name) {
+  return ::testing::TempDir() + name;
+}
+
+static void write_file(const std::string &path, const std::string &text) {
+  std::ofstream out(path, std::ios::binary);
+  out << text;
+}
+
+// Standard output of `levgrep <args>`, and its exit status
+static std::string levgrep(const std::string &args, int *status) {
+  std::string cmd = std::string(LEVGREP_PATH) + " " + args;
+  FILE *p = popen(cmd.c_str(), "r");
+  std::string out;
+  char buf[4096];
+  for (size_t n; (n = std::fread(buf, 1, sizeof(buf), p)) > 0;)
+    out.append(buf, n);
+  int rc = pclose(p);
+  *status = WIFEXITED(rc) ? WEXITSTATUS(rc) : -1;
+  return out;
+}
+
+// Lines within k edits, and every "offset:distance" match end, as levgrep
+// prints them without and with -b
+static void expected(const std::string &text, const std::string &pattern,
+                     uint32_t k, std::string &lines, std::string &offsets) {
+  for (size_t start = 0; start < text.size();) {
+    size_t end = text.find('\n', start);
+    if (end == std::string::npos)
+      end = text.size();
+    std::string line = text.substr(start, end - start);
+    auto ends = search_reference(pattern, line);
+    bool matched = false;
+    if (line.empty() && pattern.size() <= k) {
+      offsets += std::to_string(start) + ":" + std::to_string(pattern.size()) +
+                 "\n";
+      matched = true;
+    }
+    for (size_t j = 0; j < ends.size(); j++) {
+      if (ends[j] <= k) {
+        offsets += std::to_string(start + j) + ":" + std::to_string(ends[j]) +
+                   "\n";
+        matched = true;
+      }
+    }
+    EXPECT_EQ(matched, substring_reference(pattern, line) <= k);
+    if (matched)
+      lines += line + "\n";
+    start = end + 1;
+  }
+}
+
+// A match may not run across a newline: "hel\nlo" does not hold "hello"
+TEST(LevgrepTest, MatchesStayWithinLines) {
+  std::string path = temp_path("levgrep_lines.txt");
+  write_file(path, "xxhel\nlozz\n");
+  int status;
+  EXPECT_EQ(levgrep("-k 1 hello " + path, &status), "");
+  EXPECT_EQ(status, 1);
+  EXPECT_EQ(levgrep("-k 2 hello " + path, &status), "xxhel\n");
+  EXPECT_EQ(status, 0);
+  std::remove(path.c_str());
+}
+
+// Tiny chunks put boundaries everywhere; the output must not change
+TEST(LevgrepTest, MatchesReferenceAtAnyChunkSize) {
+  std::mt19937 rng(49);
+  std::string path = temp_path("levgrep_random.txt");
+  for (int iter = 0; iter < 40; iter++) {
+    std::string text;
+    for (int i = 0, n = rng() % 200; i < n; i++)
+      text += random_string(rng, 30, 'e') + "\n";
+    if (iter % 2)
+      text += random_string(rng, 30, 'e'); // No final newline
+    write_file(path, text);
+    std::string pattern = random_string(rng, 1, iter % 4 ? 10 : 40, "abcde");
+    uint32_t k = iter % 4;
+
+    std::string lines, offsets;
+    expected(text, pattern, k, lines, offsets);
+    for (const char *chunk : {"1", "7", "100", "8388608"}) {
+      std::string args = std::string("--chunk ") + chunk + " -j 3 -k " +
+                         std::to_string(k) + " " + pattern + " " + path;
+      int status;
+      ASSERT_EQ(levgrep(args, &status), lines) << args;
+      EXPECT_EQ(status, lines.empty() ? 1 : 0);
+      ASSERT_EQ(levgrep("-b " + args, &status), offsets) << args;
+    }
+  }
+  std::remove(path.c_str());
+}
+
+// Numeric options must be whole numbers in range: a typo is a usage error,
+// not a silent 0 or a wrapped bound
+TEST(LevgrepTest, RejectsBadNumbers) {
+  std::string path = temp_path("levgrep_numbers.txt");
+  write_file(path, "abc\n");
+  for (const char *args : {"-k -1", "-k abc", "-k 2x", "-k 99999999999",
+                           "-j -3", "--chunk 0", "--chunk 1k"}) {
+    int status;
+    EXPECT_EQ(levgrep(std::string(args) + " abc " + path + " 2>/dev/null",
+                      &status),
+              "")
+        << args;
+    EXPECT_EQ(status, 2) << args;
+  }
+  int status;
+  EXPECT_EQ(levgrep("-k 0 -j 2 --chunk 64 abc " + path, &status), "abc\n");
+  EXPECT_EQ(status, 0);
+  std::remove(path.c_str());
+}
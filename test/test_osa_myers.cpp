@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+#include <levenshtein_myers.hpp>
+
+TEST(OsaMyers16x8Test, AdjacentTranspositions) {
+  auto input = Myers16x8Input{
+      .q_wrd = "the",
+      .q_wrd_len = 3,
+      .d_wrds = {"teh", "hte", "the", "eht", "ca", "ac", "abc", "tehh"},
+      .d_wrd_lens = {3, 3, 3, 3, 2, 2, 3, 4}};
+  std::array<uint16_t, 8> result = osa_myers_16x8(input);
+  std::array<uint16_t, 8> expected = {1, 1, 0, 2, 3, 3, 3, 2};
+  EXPECT_EQ(result, expected);
+
+  // Plain Levenshtein charges two edits for each transposition
+  std::array<uint16_t, 8> lev = levenshtein_myers_16x8(input);
+  EXPECT_EQ(lev[0], 2);
+  EXPECT_EQ(lev[1], 2);
+}
+
+TEST(OsaMyers16x8Test, NoEditAfterTransposition) {
+  // OSA may not edit a substring twice: "ca" -> "abc" is 3, not 2
+  EXPECT_EQ(osa_myers_32x1("ca", 2, "abc", 3), 3u);
+  EXPECT_EQ(osa_myers_64x1("ca", 2, "abc", 3), 3u);
+  EXPECT_EQ(osa_myers_anyx1("ca", 2, "abc", 3), 3u);
+}
+
+TEST(OsaMyers16x8Test, EmptyStrings) {
+  auto input = Myers16x8Input{.q_wrd = "",
+                              .q_wrd_len = 0,
+                              .d_wrds = {"", "a", "ab", "abc", "", "", "", ""},
+                              .d_wrd_lens = {0, 1, 2, 3, 0, 0, 0, 0}};
+  std::array<uint16_t, 8> expected = {0, 1, 2, 3, 0, 0, 0, 0};
+  EXPECT_EQ(osa_myers_16x8(input), expected);
+  EXPECT_EQ(osa_myers_64x1("abc", 3, "", 0), 3u);
+}
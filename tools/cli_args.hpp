@@ -0,0 +1,20 @@
+#pragma once
+#include <cerrno>
+#include <cstdlib>
+
+// Argument parsing shared by the command-line tools
+
+// A whole decimal argument in [min, max]. Empty or trailing text, and values
+// out of range, are rejected rather than read as 0 or wrapped, so the caller
+// can answer them with its usage message.
+template <typename T>
+inline bool parse_arg(const char *arg, long min, long max, T &out) {
+  char *end = nullptr;
+  errno = 0;
+  long value = std::strtol(arg, &end, 10);
+  if (end == arg || *end != '\0' || errno == ERANGE || value < min ||
+      value > max)
+    return false;
+  out = T(value);
+  return true;
+}
@@ -0,0 +1,51 @@
+#include <levenshtein_dictionary.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+// Convert a text word list (one word per line) into the binary dictionary
+// format. Lines with characters outside a-z are skipped.
+int main(int argc, char **argv) {
+  if (argc != 3) {
+    std::cerr << "usage: " << argv[0] << " <words.txt> <out.dict>\n";
+    return 2;
+  }
+
+  std::ifstream in(argv[1]);
+  if (!in) {
+    std::cerr << "cannot open " << argv[1] << "\n";
+    return 1;
+  }
+
+  std::vector<std::string> words;
+  size_t skipped = 0;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+    bool valid = true;
+    for (char c : line)
+      valid = valid && c >= 'a' && c <= 'z';
+    if (valid)
+      words.push_back(line);
+    else
+      skipped++;
+  }
+
+  std::string error;
+  if (!levenshtein_dictionary_build(words, argv[2], &error)) {
+    std::cerr << "build failed: " << error << "\n";
+    return 1;
+  }
+
+  MyersDictionary dict;
+  if (!levenshtein_dictionary_open(dict, argv[2], &error)) {
+    std::cerr << "validation failed: " << error << "\n";
+    return 1;
+  }
+  std::cout << "wrote " << dict.header->n_words << " words in "
+            << dict.header->n_buckets << " length buckets ("
+            << dict.size << " bytes), skipped " << skipped << " lines\n";
+  levenshtein_dictionary_close(dict);
+  return 0;
+}
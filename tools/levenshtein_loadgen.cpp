@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Closed-loop load generator for levenshtein_server. For each concurrency
+// level, that many connections each send one query, wait for the reply and
+// send the next, for a fixed time. Reports throughput and the p50 / p99
+// latency at each level, i.e. the latency-throughput curve.
+
+struct Target {
+  const char *unix_path = nullptr;
+  int tcp_port = 0;
+};
+
+static int connect_to(const Target &target) {
+  int fd;
+  if (target.unix_path) {
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, target.unix_path, sizeof(addr.sun_path) - 1);
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, (sockaddr *)&addr, sizeof(addr)) != 0) {
+      close(fd);
+      return -1;
+    }
+  } else {
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(target.tcp_port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, (sockaddr *)&addr, sizeof(addr)) != 0) {
+      close(fd);
+      return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  }
+  return fd;
+}
+
+// Send one request and read its reply line. Returns false on a broken
+// connection or an error reply.
+static bool round_trip(int fd, const std::string &request, std::string &buf) {
+  for (size_t sent = 0; sent < request.size();) {
+    ssize_t n = write(fd, request.data() + sent, request.size() - sent);
+    if (n <= 0)
+      return false;
+    sent += n;
+  }
+  char chunk[65536];
+  size_t eol;
+  while ((eol = buf.find('\n')) == std::string::npos) {
+    ssize_t n = read(fd, chunk, sizeof(chunk));
+    if (n <= 0)
+      return false;
+    buf.append(chunk, n);
+  }
+  bool ok = buf.compare(0, 5, "error") != 0;
+  buf.erase(0, eol + 1);
+  return ok;
+}
+
+static double percentile(std::vector<double> &v, double p) {
+  if (v.empty())
+    return 0;
+  size_t i = std::min(v.size() - 1, size_t(p * v.size()));
+  std::nth_element(v.begin(), v.begin() + i, v.end());
+  return v[i];
+}
+
+int main(int argc, char **argv) {
+  Target target;
+  const char *queries_path = nullptr;
+  double seconds = 2;
+  int max_dist = 2;
+  std::vector<int> levels = {1, 2, 4, 8, 16, 32, 64};
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (arg == "--unix" && value)
+      target.unix_path = argv[++i];
+    else if (arg == "--tcp" && value)
+      target.tcp_port = std::atoi(argv[++i]);
+    else if (arg == "--seconds" && value)
+      seconds = std::atof(argv[++i]);
+    else if (arg == "--max-dist" && value)
+      max_dist = std::atoi(argv[++i]);
+    else if (arg == "--clients" && value) {
+      levels.clear();
+      for (const char *p = argv[++i]; *p;) {
+        levels.push_back(std::atoi(p));
+        p = std::strchr(p, ',');
+        p = p ? p + 1 : "";
+      }
+    } else if (!queries_path && arg[0] != '-')
+      queries_path = argv[i];
+    else
+      queries_path = nullptr, i = argc;
+  }
+  if (!queries_path || (target.unix_path != nullptr) == (target.tcp_port > 0)) {
+    std::cerr << "usage: " << argv[0]
+              << " <queries.txt> (--unix PATH | --tcp PORT) [--seconds S]"
+                 " [--max-dist D] [--clients 1,2,4,...]\n";
+    return 2;
+  }
+
+  std::ifstream in(queries_path);
+  std::vector<std::string> requests;
+  for (std::string line; std::getline(in, line);) {
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+    if (!line.empty())
+      requests.push_back(std::to_string(max_dist) + " " + line + "\n");
+  }
+  if (requests.empty()) {
+    std::cerr << "no queries in " << queries_path << "\n";
+    return 1;
+  }
+
+  std::printf("%8s %12s %10s %10s %8s\n", "clients", "queries/s", "p50_us",
+              "p99_us", "errors");
+  for (int clients : levels) {
+    std::vector<std::vector<double>> latencies(clients);
+    std::vector<size_t> errors(clients);
+    auto stop_at = std::chrono::steady_clock::now() +
+                   std::chrono::duration<double>(seconds);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < clients; t++) {
+      threads.emplace_back([&, t] {
+        int fd = connect_to(target);
+        if (fd < 0) {
+          errors[t]++;
+          return;
+        }
+        std::string buf;
+        for (size_t i = t; std::chrono::steady_clock::now() < stop_at; i++) {
+          auto start = std::chrono::steady_clock::now();
+          if (!round_trip(fd, requests[i % requests.size()], buf)) {
+            errors[t]++;
+            break;
+          }
+          latencies[t].push_back(
+              std::chrono::duration<double, std::micro>(
+                  std::chrono::steady_clock::now() - start)
+                  .count());
+        }
+        close(fd);
+      });
+    }
+    for (auto &th : threads)
+      th.join();
+
+    std::vector<double> all;
+    size_t n_errors = 0;
+    for (int t = 0; t < clients; t++) {
+      all.insert(all.end(), latencies[t].begin(), latencies[t].end());
+      n_errors += errors[t];
+    }
+    std::printf("%8d %12.0f %10.1f %10.1f %8zu\n", clients,
+                all.size() / seconds, percentile(all, 0.5),
+                percentile(all, 0.99), n_errors);
+  }
+  return 0;
+}
@@ -0,0 +1,350 @@
+#include <levenshtein_patterns.hpp>
+#include "cli_args.hpp"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Match every line of an input against a dictionary.
+//
+// Three stages overlap: a reader thread cuts the input into batches of
+// lines, a pool of workers answers each batch, and the main thread writes
+// the answers in input order. A batch's lines go into the lanes of one
+// pattern set, which is run over the dictionary in a single pass
+// (levenshtein_patterns_scan_dictionary); lines longer than 64 characters
+// are scanned one by one. The queue between reader and workers is bounded,
+// so the reader never runs more than a few batches ahead of the workers.
+//
+// One output line per input line, as for levenshtein_server:
+// "<n>[ <id>:<distance>]..." nearest first, or "-" for a line with
+// characters outside a-z.
+#define MATCH_READ_BLOCK (4 << 20)
+
+struct Options {
+  const char *dict_path = nullptr;
+  bool text_dict = false;
+  const char *input = nullptr; // Null for stdin
+  uint32_t k = 2;
+  int threads = 0;
+  size_t batch = 1024;
+  bool stats = false;
+};
+
+struct Batch {
+  uint64_t seq;
+  std::string text;           // The batch's lines, back to back
+  std::vector<size_t> starts; // n + 1 offsets into text
+  std::string out;
+};
+
+// A bounded FIFO; pop returns false once it is closed and drained
+struct BatchQueue {
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<Batch> items;
+  size_t cap;
+  bool closed = false;
+
+  void push(Batch b) {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return items.size() < cap; });
+    items.push_back(std::move(b));
+    cv.notify_all();
+  }
+  bool pop(Batch &b) {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return closed || !items.empty(); });
+    if (items.empty())
+      return false;
+    b = std::move(items.front());
+    items.pop_front();
+    cv.notify_all();
+    return true;
+  }
+  void close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    closed = true;
+    cv.notify_all();
+  }
+};
+
+static void usage(const char *prog) {
+  std::cerr
+      << "usage: " << prog
+      << " --dict PATH [--format binary|text] [-k N] [-j THREADS]"
+         " [--batch LINES] [--stats] [INPUT]\n"
+         "  --format  binary: a levenshtein_dict_build image, mapped in "
+         "place (default)\n"
+         "            text: a word list, one word per line, built in memory\n"
+         "  INPUT     lines to match; standard input if omitted\n";
+}
+
+static bool parse_options(int argc, char **argv, Options &opt) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "--dict" && has_value)
+      opt.dict_path = argv[++i];
+    else if (arg == "--format" && has_value) {
+      std::string format = argv[++i];
+      if (format != "binary" && format != "text")
+        return false;
+      opt.text_dict = format == "text";
+    } else if (arg == "-k" && has_value) {
+      if (!parse_arg(argv[++i], 0, UINT32_MAX, opt.k))
+        return false;
+    } else if (arg == "-j" && has_value) {
+      if (!parse_arg(argv[++i], 0, INT_MAX, opt.threads))
+        return false;
+    } else if (arg == "--batch" && has_value) {
+      if (!parse_arg(argv[++i], 1, INT_MAX, opt.batch))
+        return false;
+    } else if (arg == "--stats")
+      opt.stats = true;
+    else if (arg[0] == '-' && arg.size() > 1)
+      return false;
+    else if (!opt.input)
+      opt.input = argv[i];
+    else
+      return false;
+  }
+  return opt.dict_path != nullptr;
+}
+
+// Word list to an in-memory image. Lines with characters outside a-z are
+// skipped, as levenshtein_dict_build does, so ids agree between formats.
+static bool load_text_dict(const char *path, std::vector<uint8_t> &image,
+                           MyersDictionary &dict, std::string *error) {
+  std::ifstream in(path);
+  if (!in) {
+    *error = "cannot open file";
+    return false;
+  }
+  std::vector<std::string> words;
+  for (std::string line; std::getline(in, line);) {
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+    if (std::all_of(line.begin(), line.end(),
+                    [](char c) { return c >= 'a' && c <= 'z'; }))
+      words.push_back(line);
+  }
+  return levenshtein_dictionary_build(words, image, error) &&
+         levenshtein_dictionary_from_memory(dict, image.data(), image.size(),
+                                            error);
+}
+
+static void reader(FILE *in, size_t batch_lines, BatchQueue &queue,
+                   uint64_t &bytes) {
+  std::vector<char> block(MATCH_READ_BLOCK);
+  std::string partial; // Unfinished last line of the previous block
+  Batch batch{0, {}, {0}, {}};
+  auto flush = [&]() {
+    uint64_t seq = batch.seq;
+    queue.push(std::move(batch));
+    batch = Batch{seq + 1, {}, {0}, {}};
+  };
+  auto add_line = [&](const char *line, size_t len) {
+    if (len > 0 && line[len - 1] == '\r')
+      len--;
+    batch.text.append(line, len);
+    batch.starts.push_back(batch.text.size());
+    if (batch.starts.size() > batch_lines)
+      flush();
+  };
+
+  for (size_t n; (n = std::fread(block.data(), 1, block.size(), in)) > 0;) {
+    bytes += n;
+    const char *p = block.data(), *end = p + n;
+    for (const char *eol; (eol = (const char *)std::memchr(p, '\n', end - p));
+         p = eol + 1) {
+      if (partial.empty()) {
+        add_line(p, eol - p);
+      } else {
+        partial.append(p, eol);
+        add_line(partial.data(), partial.size());
+        partial.clear();
+      }
+    }
+    partial.append(p, end);
+  }
+  if (!partial.empty())
+    add_line(partial.data(), partial.size());
+  if (batch.starts.size() > 1)
+    flush();
+  queue.close();
+}
+
+static void answer(const MyersDictionary &dict, uint32_t k, Batch &batch,
+                   MyersPatternStats &stats) {
+  size_t n = batch.starts.size() - 1;
+  std::vector<std::vector<MyersScanMatch>> results(n);
+  std::vector<bool> valid(n);
+  std::vector<std::string> patterns;
+  std::vector<uint32_t> owner;
+  for (size_t i = 0; i < n; i++) {
+    const char *line = batch.text.data() + batch.starts[i];
+    size_t len = batch.starts[i + 1] - batch.starts[i];
+    valid[i] = std::all_of(line, line + len,
+                           [](char c) { return c >= 'a' && c <= 'z'; });
+    if (!valid[i])
+      continue;
+    if (len <= MYERS_PATTERN_MAX_LEN) {
+      patterns.emplace_back(line, len);
+      owner.push_back(i);
+    } else {
+      levenshtein_dictionary_scan_within(dict, line, len, k, results[i],
+                                         nullptr);
+    }
+  }
+
+  if (!patterns.empty()) {
+    MyersPatternSet set;
+    levenshtein_patterns_build(patterns, set, nullptr);
+    std::vector<MyersPatternDictMatch> matches;
+    levenshtein_patterns_scan_dictionary(set, dict, k, matches, &stats);
+    for (const auto &m : matches)
+      results[owner[m.pattern]].push_back({m.id, m.distance});
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    if (!valid[i]) {
+      batch.out += "-\n";
+      continue;
+    }
+    auto &r = results[i];
+    std::sort(r.begin(), r.end(), [](const auto &a, const auto &b) {
+      return a.distance < b.distance ||
+             (a.distance == b.distance && a.id < b.id);
+    });
+    batch.out += std::to_string(r.size());
+    for (const auto &m : r) {
+      batch.out += ' ';
+      batch.out += std::to_string(m.id);
+      batch.out += ':';
+      batch.out += std::to_string(m.distance);
+    }
+    batch.out += '\n';
+  }
+}
+
+int main(int argc, char **argv) {
+  Options opt;
+  if (!parse_options(argc, argv, opt)) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  MyersDictionary dict;
+  std::vector<uint8_t> image;
+  std::string error;
+  bool loaded = opt.text_dict
+                    ? load_text_dict(opt.dict_path, image, dict, &error)
+                    : levenshtein_dictionary_open(dict, opt.dict_path, &error);
+  if (!loaded) {
+    std::cerr << opt.dict_path << ": " << error << "\n";
+    return 1;
+  }
+  FILE *in = opt.input ? std::fopen(opt.input, "rb") : stdin;
+  if (!in) {
+    std::cerr << opt.input << ": " << std::strerror(errno) << "\n";
+    return 1;
+  }
+  double load_seconds = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+
+  int n_threads = opt.threads > 0
+                      ? opt.threads
+                      : std::max(1u, std::thread::hardware_concurrency());
+  BatchQueue input;
+  input.cap = 2 * size_t(n_threads);
+  uint64_t bytes = 0;
+  std::thread read_thread(reader, in, opt.batch, std::ref(input),
+                          std::ref(bytes));
+
+  // Finished batches by sequence number, until the writer reaches them. A
+  // worker holds a batch back while it is too far ahead of the writer, so
+  // one slow batch cannot make the others pile up.
+  std::mutex done_mutex;
+  std::condition_variable done_cv;
+  std::map<uint64_t, Batch> done;
+  uint64_t next = 0; // Next batch to write
+  size_t workers_left = n_threads;
+  std::vector<MyersPatternStats> stats(n_threads);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < n_threads; t++) {
+    workers.emplace_back([&, t] {
+      for (Batch b; input.pop(b);) {
+        answer(dict, opt.k, b, stats[t]);
+        std::unique_lock<std::mutex> lock(done_mutex);
+        done_cv.wait(lock, [&] { return b.seq < next + input.cap; });
+        uint64_t seq = b.seq;
+        done.emplace(seq, std::move(b));
+        done_cv.notify_all();
+      }
+      std::lock_guard<std::mutex> lock(done_mutex);
+      workers_left--;
+      done_cv.notify_all();
+    });
+  }
+
+  uint64_t lines = 0;
+  for (;;) {
+    Batch b;
+    {
+      std::unique_lock<std::mutex> lock(done_mutex);
+      done_cv.wait(lock, [&] {
+        return done.count(next) > 0 || (workers_left == 0 && done.empty());
+      });
+      auto it = done.find(next);
+      if (it == done.end())
+        break;
+      b = std::move(it->second);
+      done.erase(it);
+      next++;
+    }
+    done_cv.notify_all();
+    std::fwrite(b.out.data(), 1, b.out.size(), stdout);
+    lines += b.starts.size() - 1;
+  }
+  read_thread.join();
+  for (auto &w : workers)
+    w.join();
+  std::fflush(stdout);
+  if (in != stdin)
+    std::fclose(in);
+
+  if (opt.stats) {
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count() -
+                     load_seconds;
+    uint64_t groups = 0, matches = 0;
+    for (const auto &s : stats) {
+      groups += s.groups_run;
+      matches += s.matches;
+    }
+    std::fprintf(stderr,
+                 "dictionary: %u words, loaded in %.3f s\n"
+                 "%llu lines, %llu bytes in %.3f s: %.0f lines/s, %.1f MB/s, "
+                 "%d threads\n"
+                 "%llu kernel groups run, %llu matches\n",
+                 dict.header->n_words, load_seconds, (unsigned long long)lines,
+                 (unsigned long long)bytes, seconds, lines / seconds,
+                 bytes / seconds / 1e6, n_threads,
+                 (unsigned long long)groups, (unsigned long long)matches);
+  }
+  levenshtein_dictionary_close(dict);
+  return 0;
+}
@@ -0,0 +1,472 @@
+#include <levenshtein_patterns.hpp>
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <iostream>
+#include <mutex>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+// Query service over a mapped dictionary, on a Unix socket or a localhost
+// TCP port.
+//
+// Protocol, one line each way:
+//   request   "<max_dist> <query>"
+//   response  "<n>[ <id>:<distance>]..."  nearest first, or "error <reason>"
+// Ids are the word indices the dictionary was built with. A client may send
+// several requests without waiting; responses come back in request order.
+// A client that half-closes its connection still gets every reply; the
+// server closes once the last one is sent.
+//
+// The event loop only moves bytes. Parsed requests go to a bounded queue; a
+// worker takes everything that arrives within the batching window (or a
+// full batch), builds one pattern set from the batch and answers it with a
+// single pass over the dictionary. When the queue is full, the loop stops
+// reading from clients, so the backlog stays in the socket buffers and
+// backs up to the senders.
+
+#define SERVER_LINE_MAX 4096
+#define SERVER_OUT_MAX (1 << 20) // Unsent reply bytes per client
+
+struct Options {
+  const char *dict_path = nullptr;
+  const char *unix_path = nullptr;
+  int tcp_port = 0;
+  int window_us = 200;
+  size_t max_batch = 256;
+  size_t queue_cap = 4096;
+};
+
+struct Request {
+  uint64_t client; // Client id; fds are reused after a close
+  uint64_t seq;    // Position in the client's request stream
+  uint32_t max_dist;
+  std::string query;
+  std::string reply;
+};
+
+struct Client {
+  int fd;
+  std::string in, out;
+  uint64_t next_seq = 0;  // Sequence number of the next request read
+  uint64_t next_send = 0; // Sequence number of the next reply to send
+  bool eof = false;       // The client has shut down its sending side
+  std::unordered_map<uint64_t, std::string> early; // Replies out of order
+};
+
+static volatile sig_atomic_t stopping = 0;
+
+static void on_signal(int) { stopping = 1; }
+
+static void usage(const char *prog) {
+  std::cerr << "usage: " << prog
+            << " <dict> (--unix PATH | --tcp PORT) [--window-us N]"
+               " [--max-batch N] [--queue N]\n";
+}
+
+static bool parse_options(int argc, char **argv, Options &opt) {
+  if (argc < 2)
+    return false;
+  opt.dict_path = argv[1];
+  for (int i = 2; i < argc; i++) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc)
+      return false;
+    const char *value = argv[++i];
+    if (arg == "--unix")
+      opt.unix_path = value;
+    else if (arg == "--tcp")
+      opt.tcp_port = std::atoi(value);
+    else if (arg == "--window-us")
+      opt.window_us = std::atoi(value);
+    else if (arg == "--max-batch")
+      opt.max_batch = std::max(1, std::atoi(value));
+    else if (arg == "--queue")
+      opt.queue_cap = std::max(1, std::atoi(value));
+    else
+      return false;
+  }
+  return (opt.unix_path != nullptr) != (opt.tcp_port > 0);
+}
+
+static int listen_socket(const Options &opt) {
+  int fd;
+  if (opt.unix_path) {
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (std::strlen(opt.unix_path) >= sizeof(addr.sun_path))
+      return -1;
+    std::strcpy(addr.sun_path, opt.unix_path);
+    unlink(opt.unix_path);
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || bind(fd, (sockaddr *)&addr, sizeof(addr)) != 0)
+      return -1;
+  } else {
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(opt.tcp_port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    if (fd < 0)
+      return -1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (bind(fd, (sockaddr *)&addr, sizeof(addr)) != 0)
+      return -1;
+  }
+  if (listen(fd, 128) != 0)
+    return -1;
+  fcntl(fd, F_SETFL, O_NONBLOCK);
+  return fd;
+}
+
+// Requests waiting for the worker, and replies waiting for the event loop
+struct Queues {
+  std::mutex mutex;
+  std::condition_variable ready;
+  std::deque<Request> pending;
+  std::vector<Request> done;
+  bool stop = false;
+  int wake_fd; // Written by the worker when `done` gains replies
+};
+
+static std::string format_reply(std::vector<MyersScanMatch> &matches) {
+  std::sort(matches.begin(), matches.end(), [](const auto &a, const auto &b) {
+    return a.distance < b.distance ||
+           (a.distance == b.distance && a.id < b.id);
+  });
+  std::string reply = std::to_string(matches.size());
+  for (const auto &m : matches) {
+    reply += ' ';
+    reply += std::to_string(m.id);
+    reply += ':';
+    reply += std::to_string(m.distance);
+  }
+  reply += '\n';
+  return reply;
+}
+
+// Answer a batch. Queries that fit the pattern kernels and ask for the same
+// bound share one pass over the dictionary; longer ones are scanned on their
+// own. Mixing bounds in one pass would scan every pattern at the largest of
+// them and collect matches that are only thrown away.
+static void run_batch(const MyersDictionary &dict, std::vector<Request> &batch,
+                      MyersPatternStats &stats) {
+  std::vector<size_t> order;
+  std::vector<std::vector<MyersScanMatch>> results(batch.size());
+  for (size_t i = 0; i < batch.size(); i++) {
+    const Request &r = batch[i];
+    if (r.query.size() <= MYERS_PATTERN_MAX_LEN)
+      order.push_back(i);
+    else
+      levenshtein_dictionary_scan_within(dict, r.query.data(), r.query.size(),
+                                         r.max_dist, results[i], nullptr);
+  }
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return batch[a].max_dist < batch[b].max_dist;
+  });
+
+  std::vector<std::string> patterns;
+  std::vector<MyersPatternDictMatch> matches;
+  for (size_t first = 0, last; first < order.size(); first = last) {
+    uint32_t max_dist = batch[order[first]].max_dist;
+    patterns.clear();
+    for (last = first;
+         last < order.size() && batch[order[last]].max_dist == max_dist;
+         last++)
+      patterns.push_back(batch[order[last]].query);
+
+    MyersPatternSet set;
+    levenshtein_patterns_build(patterns, set, nullptr);
+    matches.clear();
+    levenshtein_patterns_scan_dictionary(set, dict, max_dist, matches, &stats);
+    for (const auto &m : matches)
+      results[order[first + m.pattern]].push_back({m.id, m.distance});
+  }
+
+  for (size_t i = 0; i < batch.size(); i++)
+    batch[i].reply = format_reply(results[i]);
+}
+
+static void worker(const MyersDictionary &dict, const Options &opt,
+                   Queues &queues, uint64_t &batches, uint64_t &queries,
+                   MyersPatternStats &stats) {
+  std::vector<Request> batch;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(queues.mutex);
+      queues.ready.wait(lock,
+                        [&] { return queues.stop || !queues.pending.empty(); });
+      if (queues.stop)
+        return;
+      // The window opens with the first request of the batch
+      auto deadline = std::chrono::steady_clock::now() +
+                      std::chrono::microseconds(opt.window_us);
+      queues.ready.wait_until(lock, deadline, [&] {
+        return queues.stop || queues.pending.size() >= opt.max_batch;
+      });
+      size_t n = std::min(queues.pending.size(), opt.max_batch);
+      batch.assign(std::make_move_iterator(queues.pending.begin()),
+                   std::make_move_iterator(queues.pending.begin() + n));
+      queues.pending.erase(queues.pending.begin(),
+                           queues.pending.begin() + n);
+    }
+
+    run_batch(dict, batch, stats);
+    batches++;
+    queries += batch.size();
+
+    {
+      std::lock_guard<std::mutex> lock(queues.mutex);
+      for (auto &r : batch)
+        queues.done.push_back(std::move(r));
+    }
+    char byte = 0;
+    (void)!write(queues.wake_fd, &byte, 1);
+  }
+}
+
+// Parse complete lines from the client's input while the queue has room.
+// Malformed lines are answered in place, in sequence. No distance exceeds
+// the longer of the query and the dictionary's longest word, so bounds are
+// clamped to that.
+static void read_requests(Client &client, uint64_t id, Queues &queues,
+                          size_t queue_cap, uint32_t max_wrd_len,
+                          std::vector<Request> &immediate) {
+  size_t start = 0;
+  for (;;) {
+    size_t eol = client.in.find('\n', start);
+    if (eol == std::string::npos)
+      break;
+    {
+      std::lock_guard<std::mutex> lock(queues.mutex);
+      if (queues.pending.size() >= queue_cap)
+        break;
+    }
+    std::string line = client.in.substr(start, eol - start);
+    start = eol + 1;
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+
+    Request r{id, client.next_seq++, 0, {}, {}};
+    size_t space = line.find(' ');
+    char *end = nullptr;
+    long max_dist = std::strtol(line.c_str(), &end, 10);
+    bool ok = space != std::string::npos && end == line.c_str() + space &&
+              space > 0 && max_dist >= 0 && uint64_t(max_dist) <= UINT32_MAX;
+    if (ok) {
+      r.query = line.substr(space + 1);
+      for (char c : r.query)
+        ok = ok && c >= 'a' && c <= 'z';
+      r.max_dist = std::min<uint64_t>(
+          max_dist, std::max<uint64_t>(r.query.size(), max_wrd_len));
+    }
+    if (!ok) {
+      r.reply = "error expected \"<max_dist> <a-z query>\"\n";
+      immediate.push_back(std::move(r));
+      continue;
+    }
+    {
+      std::lock_guard<std::mutex> lock(queues.mutex);
+      queues.pending.push_back(std::move(r));
+    }
+    queues.ready.notify_one();
+  }
+  client.in.erase(0, start);
+}
+
+static void deliver(std::unordered_map<uint64_t, Client> &clients,
+                    Request &r) {
+  auto it = clients.find(r.client);
+  if (it == clients.end())
+    return; // Disconnected while the request ran
+  Client &c = it->second;
+  c.early.emplace(r.seq, std::move(r.reply));
+  for (auto e = c.early.find(c.next_send); e != c.early.end();
+       e = c.early.find(c.next_send)) {
+    c.out += e->second;
+    c.early.erase(e);
+    c.next_send++;
+  }
+}
+
+int main(int argc, char **argv) {
+  Options opt;
+  if (!parse_options(argc, argv, opt)) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  MyersDictionary dict;
+  std::string error;
+  if (!levenshtein_dictionary_open(dict, opt.dict_path, &error)) {
+    std::cerr << "cannot open " << opt.dict_path << ": " << error << "\n";
+    return 1;
+  }
+  int listen_fd = listen_socket(opt);
+  if (listen_fd < 0) {
+    std::cerr << "cannot listen: " << std::strerror(errno) << "\n";
+    return 1;
+  }
+  int wake[2];
+  if (pipe(wake) != 0) {
+    std::cerr << "pipe: " << std::strerror(errno) << "\n";
+    return 1;
+  }
+  fcntl(wake[0], F_SETFL, O_NONBLOCK);
+
+  struct sigaction sa = {};
+  sa.sa_handler = on_signal;
+  sigaction(SIGINT, &sa, nullptr);
+  sigaction(SIGTERM, &sa, nullptr);
+  signal(SIGPIPE, SIG_IGN);
+
+  Queues queues;
+  queues.wake_fd = wake[1];
+  uint64_t batches = 0, queries = 0;
+  MyersPatternStats stats = {};
+  std::thread work(worker, std::cref(dict), std::cref(opt), std::ref(queues),
+                   std::ref(batches), std::ref(queries), std::ref(stats));
+  std::cerr << "serving " << dict.header->n_words << " words\n";
+
+  std::unordered_map<uint64_t, Client> clients;
+  uint64_t next_id = 0;
+  std::vector<pollfd> fds;
+  std::vector<uint64_t> ids;
+  std::vector<Request> ready;
+  char buf[65536];
+
+  while (!stopping) {
+    bool full;
+    {
+      std::lock_guard<std::mutex> lock(queues.mutex);
+      full = queues.pending.size() >= opt.queue_cap;
+    }
+
+    fds.assign({{listen_fd, POLLIN, 0}, {wake[0], POLLIN, 0}});
+    ids.assign(2, 0);
+    for (auto &[id, c] : clients) {
+      short events = c.out.empty() ? 0 : POLLOUT;
+      // Clients that do not read their replies are not read from either
+      if (!c.eof && !full && c.in.size() < SERVER_LINE_MAX &&
+          c.out.size() < SERVER_OUT_MAX)
+        events |= POLLIN;
+      fds.push_back({c.fd, events, 0});
+      ids.push_back(id);
+    }
+    if (poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno == EINTR)
+        continue;
+      break;
+    }
+
+    if (fds[0].revents & POLLIN) {
+      for (int fd; (fd = accept(listen_fd, nullptr, nullptr)) >= 0;) {
+        fcntl(fd, F_SETFL, O_NONBLOCK);
+        clients.emplace(next_id++, Client{fd});
+      }
+    }
+
+    if (fds[1].revents & POLLIN) {
+      while (read(wake[0], buf, sizeof(buf)) > 0) {
+      }
+      {
+        std::lock_guard<std::mutex> lock(queues.mutex);
+        ready.swap(queues.done);
+      }
+      for (auto &r : ready)
+        deliver(clients, r);
+      ready.clear();
+    }
+
+    for (size_t i = 2; i < fds.size(); i++) {
+      auto it = clients.find(ids[i]);
+      Client &c = it->second;
+      bool closed = fds[i].revents & (POLLERR | POLLHUP | POLLNVAL);
+
+      if (fds[i].revents & POLLIN) {
+        ssize_t n = read(c.fd, buf, sizeof(buf));
+        if (n > 0) {
+          c.in.append(buf, n);
+        } else if (n == 0) {
+          // A last line without a newline is still a request
+          c.eof = true;
+          if (!c.in.empty() && c.in.back() != '\n')
+            c.in += '\n';
+        } else if (errno != EAGAIN) {
+          closed = true;
+        }
+      }
+      if (!c.out.empty() && (fds[i].revents & POLLOUT)) {
+        ssize_t n = write(c.fd, c.out.data(), c.out.size());
+        if (n > 0)
+          c.out.erase(0, n);
+        else if (errno != EAGAIN)
+          closed = true;
+      }
+      // A line longer than the limit can never be parsed
+      if (c.in.size() >= SERVER_LINE_MAX &&
+          c.in.find('\n') == std::string::npos)
+        closed = true;
+      if (closed) {
+        close(c.fd);
+        clients.erase(it);
+      }
+    }
+
+    // Parse whatever is buffered: new input, or lines held back while the
+    // queue was full
+    for (auto &[id, c] : clients) {
+      read_requests(c, id, queues, opt.queue_cap,
+                    dict.header->max_wrd_len, ready);
+      for (auto &r : ready)
+        deliver(clients, r);
+      ready.clear();
+    }
+
+    // Half-closed clients are closed once every request is answered and
+    // the replies are written
+    for (auto it = clients.begin(); it != clients.end();) {
+      Client &c = it->second;
+      if (c.eof && c.in.empty() && c.next_send == c.next_seq &&
+          c.out.empty()) {
+        close(c.fd);
+        it = clients.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(queues.mutex);
+    queues.stop = true;
+  }
+  queues.ready.notify_one();
+  work.join();
+  for (auto &[id, c] : clients)
+    close(c.fd);
+  close(listen_fd);
+  if (opt.unix_path)
+    unlink(opt.unix_path);
+  levenshtein_dictionary_close(dict);
+
+  std::cerr << queries << " queries in " << batches << " batches ("
+            << (batches ? double(queries) / batches : 0)
+            << " per batch), " << stats.groups_run << " kernel groups run, "
+            << stats.groups_skipped << " skipped\n";
+  return 0;
+}
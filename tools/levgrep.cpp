@@ -0,0 +1,325 @@
+#include <levenshtein_myers.hpp>
+#include "cli_args.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Approximate grep: print the lines of each file that contain a substring
+// within k edits of the pattern.
+//
+// Files are mapped and cut into chunks of about LEVGREP_CHUNK bytes (or
+// --chunk), each extended to the end of its last line, so every line lies in
+// exactly one chunk. Chunks are searched on worker threads with the
+// semi-global Myers kernels. The search restarts at every line, so a match
+// never spans a newline. Output is buffered per chunk and written in file
+// order.
+#define LEVGREP_CHUNK (8 << 20)
+#define LEVGREP_BLOCK (64 << 10) // Text fed to the kernel per call
+#define LEVGREP_AHEAD 4          // Chunks buffered per thread
+
+struct Options {
+  const char *pattern = nullptr;
+  std::vector<const char *> files;
+  uint32_t k = 1;
+  bool offsets = false; // -b: one "offset:distance" line per hit
+  bool count = false;   // -c: matching line count per file
+  bool stats = false;
+  int threads = 0;
+  size_t chunk = LEVGREP_CHUNK;
+};
+
+// The 32x1 or 64x1 search state, whichever fits the pattern
+struct Searcher {
+  MyersSearch32x1State s32;
+  MyersSearch64x1State s64;
+  bool wide;
+  uint32_t m;
+
+  void init(const Options &opt) {
+    m = std::strlen(opt.pattern);
+    wide = m > 32;
+    if (wide)
+      levenshtein_myers_search_64x1_init(s64, opt.pattern, m, opt.k);
+    else
+      levenshtein_myers_search_32x1_init(s32, opt.pattern, m, opt.k);
+  }
+  void restart(uint64_t pos) {
+    if (wide)
+      levenshtein_myers_search_64x1_reset(s64, pos);
+    else
+      levenshtein_myers_search_32x1_reset(s32, pos);
+  }
+  void feed(const char *text, size_t len, std::vector<MyersSearchHit> &hits) {
+    if (wide)
+      levenshtein_myers_search_64x1(s64, text, len, hits);
+    else
+      levenshtein_myers_search_32x1(s32, text, len, hits);
+  }
+};
+
+struct Chunk {
+  size_t file; // Index into the mapped files
+  size_t begin, end;
+};
+
+struct Mapped {
+  const char *name;
+  const char *data = nullptr;
+  size_t size = 0;
+};
+
+struct ChunkResult {
+  std::string out;
+  uint64_t lines = 0; // Matching lines
+  uint64_t hits = 0;
+};
+
+static void usage(const char *prog) {
+  std::cerr << "usage: " << prog
+            << " [-k N] [-b] [-c] [-j THREADS] [--chunk BYTES] [--stats]"
+               " PATTERN FILE...\n"
+               "  -k N   allowed edits (default 1)\n"
+               "  -b     print byte offset and distance of every match end\n"
+               "  -c     print the number of matching lines per file\n"
+               "  -j N   worker threads (default: one per core)\n"
+               "  --chunk BYTES  work unit per thread (default 8 MB)\n";
+}
+
+static bool parse_options(int argc, char **argv, Options &opt) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-k" && i + 1 < argc) {
+      if (!parse_arg(argv[++i], 0, UINT32_MAX, opt.k))
+        return false;
+    } else if (arg == "-j" && i + 1 < argc) {
+      if (!parse_arg(argv[++i], 0, INT_MAX, opt.threads))
+        return false;
+    } else if (arg == "--chunk" && i + 1 < argc) {
+      if (!parse_arg(argv[++i], 1, LONG_MAX, opt.chunk))
+        return false;
+    } else if (arg == "-b")
+      opt.offsets = true;
+    else if (arg == "-c")
+      opt.count = true;
+    else if (arg == "--stats")
+      opt.stats = true;
+    else if (arg.size() > 1 && arg[0] == '-')
+      return false;
+    else if (!opt.pattern)
+      opt.pattern = argv[i];
+    else
+      opt.files.push_back(argv[i]);
+  }
+  return opt.pattern && !opt.files.empty();
+}
+
+static bool map_file(Mapped &f) {
+  int fd = open(f.name, O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return false;
+  }
+  f.size = st.st_size;
+  if (f.size > 0) {
+    void *p = mmap(nullptr, f.size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+      close(fd);
+      return false;
+    }
+    madvise(p, f.size, MADV_SEQUENTIAL);
+    f.data = (const char *)p;
+  }
+  close(fd);
+  return true;
+}
+
+static void search_chunk(const Options &opt, const Mapped &f,
+                         const Chunk &c, bool prefix, ChunkResult &r) {
+  Searcher searcher;
+  searcher.init(opt);
+  std::vector<MyersSearchHit> hits;
+  bool matched; // The current line has a hit
+  auto report = [&]() {
+    r.hits += hits.size();
+    matched = matched || !hits.empty();
+    if (!opt.offsets || opt.count)
+      return;
+    for (const auto &hit : hits) {
+      if (prefix)
+        r.out += std::string(f.name) + ":";
+      r.out += std::to_string(hit.end_pos) + ":" +
+               std::to_string(hit.distance) + "\n";
+    }
+  };
+
+  for (size_t line = c.begin; line < c.end;) {
+    const char *eol = (const char *)std::memchr(f.data + line, '\n',
+                                                c.end - line);
+    size_t end = eol ? eol - f.data : c.end;
+    searcher.restart(line);
+    matched = false;
+    // An empty line holds the empty substring, which is m edits away
+    if (end == line && searcher.m <= opt.k) {
+      hits.assign(1, {line, searcher.m, 0});
+      report();
+    }
+    for (size_t pos = line; pos < end; pos += LEVGREP_BLOCK) {
+      hits.clear();
+      searcher.feed(f.data + pos, std::min<size_t>(LEVGREP_BLOCK, end - pos),
+                    hits);
+      report();
+    }
+
+    if (matched) {
+      r.lines++;
+      if (!opt.count && !opt.offsets) {
+        if (prefix)
+          r.out += std::string(f.name) + ":";
+        r.out.append(f.data + line, f.data + end);
+        r.out += '\n';
+      }
+    }
+    line = end + 1;
+  }
+}
+
+int main(int argc, char **argv) {
+  Options opt;
+  if (!parse_options(argc, argv, opt)) {
+    usage(argv[0]);
+    return 2;
+  }
+  if (std::strlen(opt.pattern) == 0 || std::strlen(opt.pattern) > 64) {
+    std::cerr << "pattern must be 1 to 64 bytes\n";
+    return 2;
+  }
+
+  std::vector<Mapped> files;
+  std::vector<Chunk> chunks;
+  for (const char *name : opt.files) {
+    Mapped f;
+    f.name = name;
+    if (!map_file(f)) {
+      std::cerr << name << ": " << std::strerror(errno) << "\n";
+      return 2;
+    }
+    // Chunk boundaries are moved forward to the next line start. An empty
+    // file gets one empty chunk, so it still has a count line.
+    if (f.size == 0)
+      chunks.push_back({files.size(), 0, 0});
+    for (size_t begin = 0; begin < f.size;) {
+      size_t end = std::min(f.size, begin + opt.chunk);
+      if (end < f.size) {
+        const char *eol = (const char *)std::memchr(f.data + end, '\n',
+                                                    f.size - end);
+        end = eol ? eol - f.data + 1 : f.size;
+      }
+      chunks.push_back({files.size(), begin, end});
+      begin = end;
+    }
+    files.push_back(f);
+  }
+
+  int n_threads = opt.threads > 0
+                      ? opt.threads
+                      : std::max(1u, std::thread::hardware_concurrency());
+  size_t ahead = size_t(n_threads) * LEVGREP_AHEAD;
+  bool prefix = files.size() > 1;
+
+  // Workers take chunks in order but stay at most `ahead` chunks in front of
+  // the writer, so buffered output stays bounded
+  std::vector<ChunkResult> results(chunks.size());
+  std::vector<bool> done(chunks.size());
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t next = 0, written = 0;
+
+  auto start_time = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (int t = 0; t < n_threads; t++) {
+    workers.emplace_back([&] {
+      for (;;) {
+        size_t i;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          cv.wait(lock, [&] {
+            return next >= chunks.size() || next < written + ahead;
+          });
+          if (next >= chunks.size())
+            return;
+          i = next++;
+        }
+        ChunkResult r;
+        search_chunk(opt, files[chunks[i].file], chunks[i], prefix, r);
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          results[i] = std::move(r);
+          done[i] = true;
+        }
+        cv.notify_all();
+      }
+    });
+  }
+
+  uint64_t total_lines = 0, total_hits = 0, file_lines = 0;
+  for (size_t i = 0; i < chunks.size(); i++) {
+    ChunkResult r;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [&] { return bool(done[i]); });
+      r = std::move(results[i]);
+      written = i + 1;
+    }
+    cv.notify_all();
+    std::fwrite(r.out.data(), 1, r.out.size(), stdout);
+    total_lines += r.lines;
+    total_hits += r.hits;
+    file_lines += r.lines;
+    bool last_of_file = i + 1 == chunks.size() ||
+                        chunks[i + 1].file != chunks[i].file;
+    if (opt.count && last_of_file) {
+      if (prefix)
+        std::printf("%s:", files[chunks[i].file].name);
+      std::printf("%llu\n", (unsigned long long)file_lines);
+      file_lines = 0;
+    }
+  }
+  for (auto &w : workers)
+    w.join();
+  std::fflush(stdout);
+
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start_time)
+                       .count();
+  if (opt.stats) {
+    size_t bytes = 0;
+    for (const auto &f : files)
+      bytes += f.size;
+    std::fprintf(stderr,
+                 "%zu bytes in %.3f s (%.2f GB/s), %d threads, %llu match "
+                 "ends, %llu lines\n",
+                 bytes, seconds, bytes / seconds / 1e9, n_threads,
+                 (unsigned long long)total_hits,
+                 (unsigned long long)total_lines);
+  }
+  for (const auto &f : files)
+    if (f.data)
+      munmap((void *)f.data, f.size);
+  return total_hits > 0 ? 0 : 1;
+}